@@ -10,11 +10,24 @@
 //// Preprocessor Directives ////
 #pragma once
 #include <iostream>  // std::cout
-#include <algorithm> // std::min_element, std::distance
-#include <deque>     // std::deque
-#include <vector>    // std::vector
+#include <algorithm> // std::min_element, std::distance, std::reverse, std::push_heap, std::pop_heap, std::find, std::min, std::max, std::sort, std::unique, std::binary_search
+#include <vector>    // std::vector, std::pmr::vector
+#include <memory_resource> // std::pmr::memory_resource, std::pmr::get_default_resource
 #include <limits>    // std::numeric_limits
-#include "mazes.hpp" // NPC_Racer::maz
+#include <concepts>  // std::unsigned_integral
+#include <array>     // std::array
+#include <chrono>    // std::chrono::steady_clock
+#include <type_traits> // std::is_constant_evaluated, std::remove_cvref_t, std::conditional_t
+#include <string_view> // std::string_view
+#include <tuple>       // std::tuple, std::get, std::tuple_size_v
+#include <utility>     // std::index_sequence, std::make_index_sequence, std::pair
+#include <functional>  // std::greater
+#include <cstdint>     // uint8_t, uint32_t, uint64_t
+#include "mazes.hpp" // NPC_Racer::maze, NPC_Racer::static_maze
+#include "trace.hpp" // NPC_Racer::exploration_trace
+#include "compact_path.hpp" // NPC_Racer::compact_path
+
+// Search statistics are off by default so they cost nothing in races, compile with -DNPC_RACER_SEARCH_STATISTICS to turn them on
 
 ////// ========= //////
 ////// Interface //////
@@ -26,15 +39,340 @@ namespace NPC_Racer
     //// Functions ////
     //// --------- ////
 
+    //// ------------------------ ////
+    //// Search Statistics Struct ////
+    //// ------------------------ ////
+#if defined(NPC_RACER_SEARCH_STATISTICS)
+    /**
+     * @brief Counts of the work done inside a search, filled by each agent during pathfind.
+     * @note Only exists when compiled with NPC_RACER_SEARCH_STATISTICS, otherwise every member function is an empty inline function.
+     */
+    struct search_statistics
+    {
+        /**
+         * @param enabled True when statistics are compiled in, use with `if constexpr` to skip printing them.
+         */
+        static constexpr bool enabled = true;
+
+        /**
+         * @param edges_relaxed The number of edges that updated a neighbour's previous node.
+         */
+        uint64_t edges_relaxed = 0;
+
+        /**
+         * @param frontier_pushes The number of nodes added to the frontier (stack or queue).
+         */
+        uint64_t frontier_pushes = 0;
+
+        /**
+         * @param frontier_pops The number of nodes taken off the frontier.
+         */
+        uint64_t frontier_pops = 0;
+
+        /**
+         * @param peak_frontier_size The largest the frontier got during the search.
+         */
+        uint64_t peak_frontier_size = 0;
+
+        /**
+         * @param decrease_keys The number of times a node already in the frontier had its distance lowered.
+         */
+        uint64_t decrease_keys = 0;
+
+        /**
+         * @param scratch_bytes The bytes of scratch arrays the search used.
+         */
+        uint64_t scratch_bytes = 0;
+
+        /**
+         * @param search_time The time in seconds spent searching.
+         */
+        double search_time = 0.0;
+
+        /**
+         * @param reconstruction_time The time in seconds spent backtracking to build the path.
+         */
+        double reconstruction_time = 0.0;
+
+        /**
+         * @param phase_start The start time of the current phase, search or reconstruction.
+         */
+        std::chrono::steady_clock::time_point phase_start = {};
+
+        /**
+         * @brief Resets all the counts and starts timing the search.
+         */
+        constexpr void start_search()
+        {
+            *this = search_statistics();
+            if (!std::is_constant_evaluated()) // no clocks at compile time for the static agents
+                phase_start = std::chrono::steady_clock::now();
+        }
+
+        /**
+         * @brief Ends timing the search and starts timing the path reconstruction.
+         */
+        constexpr void end_search()
+        {
+            if (!std::is_constant_evaluated())
+            {
+                std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                search_time = std::chrono::duration<double>(now - phase_start).count();
+                phase_start = now;
+            }
+        }
+
+        /**
+         * @brief Ends timing the path reconstruction.
+         */
+        constexpr void end_reconstruction()
+        {
+            if (!std::is_constant_evaluated())
+                reconstruction_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - phase_start).count();
+        }
+
+        /**
+         * @brief Counts a node added to the frontier.
+         * @param frontier_size The size of the frontier after adding.
+         */
+        constexpr void count_push(const size_t frontier_size)
+        {
+            frontier_pushes++;
+            peak_frontier_size = std::max<uint64_t>(peak_frontier_size, frontier_size);
+        }
+
+        constexpr void count_pop() { frontier_pops++; }
+        constexpr void count_edge_relaxed() { edges_relaxed++; }
+        constexpr void count_decrease_key() { decrease_keys++; }
+        constexpr void count_scratch_bytes(const size_t bytes) { scratch_bytes += bytes; }
+    };
+#else
+    /**
+     * @brief Empty stand-in for the search statistics when NPC_RACER_SEARCH_STATISTICS isn't defined, every call compiles away.
+     */
+    struct search_statistics
+    {
+        static constexpr bool enabled = false;
+        constexpr void start_search() {}
+        constexpr void end_search() {}
+        constexpr void end_reconstruction() {}
+        constexpr void count_push(const size_t) {}
+        constexpr void count_pop() {}
+        constexpr void count_edge_relaxed() {}
+        constexpr void count_decrease_key() {}
+        constexpr void count_scratch_bytes(const size_t) {}
+    };
+#endif
+
+    /**
+     * @brief Overloaded binary operator << to print out the search statistics of an agent.
+     *
+     * @param out Output stream buffer that accepts strings.
+     * @param statistics The search statistics to print.
+     *
+     * @return A reference of out for extraction chaining.
+     * @note Prints nothing when statistics aren't compiled in.
+     */
+    std::ostream &operator<<(std::ostream &out, const search_statistics &statistics);
+
+    //// ----------------- ////
+    //// Static Path Class ////
+    //// ----------------- ////
+    /**
+     * @brief Fixed-capacity path of index positions used by the static agents so no heap allocation is needed.
+     *
+     * @tparam index_type The unsigned integer type used for indices.
+     * @tparam capacity The maximum length of the path, the number of elements in the maze.
+     */
+    template <std::unsigned_integral index_type, size_t capacity>
+    class static_path
+    {
+    public:
+        /**
+         * @brief Adds a position to the end of the path.
+         *
+         * @param position The index of the position to add.
+         */
+        constexpr void push_back(const index_type position) { positions[length++] = position; }
+
+        /**
+         * @brief Empties the path.
+         */
+        constexpr void clear() { length = 0; }
+
+        /**
+         * @brief Gives the number of positions in the path.
+         * @return The length of the path.
+         */
+        constexpr size_t size() const { return length; }
+
+        /**
+         * @brief Gives the position at a point along the path.
+         *
+         * @param i The point along the path, indexed from 0 at the start.
+         * @return The index of the position.
+         */
+        constexpr index_type operator[](const size_t i) const { return positions[i]; }
+
+        //// Iterators ////
+        constexpr const index_type *begin() const { return positions.data(); }
+        constexpr const index_type *end() const { return positions.data() + length; }
+
+        //// Data Members ////
+
+        /**
+         * @param positions The storage of the path positions, only the first length are used.
+         */
+        std::array<index_type, capacity> positions = {};
+
+        /**
+         * @param length The number of positions used in the path.
+         */
+        size_t length = 0;
+    };
+
+    //// ---------------- ////
+    //// Base Agent Class ////
+    //// ---------------- ////
+    /**
+     * @brief The vector type of the agents' scratch arrays, allocating from the memory resource the agent was constructed with.
+     */
+    template <typename value_type>
+    using scratch_vector = std::pmr::vector<value_type>;
+
+    /**
+     * @brief Members shared by every agent that pathfinds on a NPC_Racer::maze. Agents derive from it without any virtual functions.
+     *
+     * @tparam index_type The unsigned integer type used for indices, must match the maze.
+     */
+    template <std::unsigned_integral index_type>
+    class agent_base
+    {
+    public:
+        /**
+         * @brief Constructs the shared members of an agent, derived agents inherit it to be made on a memory resource.
+         *
+         * @param resource The memory resource the agent's scratch arrays allocate from, the heap by default,
+         *      e.g. a NPC_Racer::scratch_arena reset between searches.
+         */
+        explicit agent_base(std::pmr::memory_resource *resource = std::pmr::get_default_resource()) : scratch_resource(resource)
+        {
+            // the derived agent makes its scratch arrays on the resource
+        }
+
+        //// Data Members ////
+        // Public data members that could be used for purposes other than pathfinding are included here
+
+        /**
+         * @param current_position The current position of the agent during pathfinding.
+         */
+        index_type current_position;
+
+        /**
+         * @param pathfinding_completed If the pathfinding algorithm is completed or not.
+         */
+        bool pathfinding_completed = false;
+
+        /**
+         * @param path The path found from pathfinding composed of indicies.
+         * @note Built backwards and reversed so its memory is reused between searches.
+         */
+        std::vector<index_type> path = {};
+
+        /**
+         * @param nodes_explored count of nodes explored in pathfinding
+         */
+        uint64_t nodes_explored = 0;
+
+        /**
+         * @param statistics Counts of the work done in the last pathfinding, empty unless compiled with NPC_RACER_SEARCH_STATISTICS.
+         */
+        [[no_unique_address]] search_statistics statistics;
+
+        /**
+         * @param trace The expansion order of the last pathfinding, empty unless compiled with NPC_RACER_EXPLORATION_TRACE.
+         */
+        [[no_unique_address]] exploration_trace trace;
+
+        /**
+         * @param warnings If true a warning is printed when no path is found, turned off when std::cout carries a protocol.
+         */
+        bool warnings = true;
+
+        /**
+         * @param compact_paths If true the path is backtracked straight into compact and path is left empty, for keeping many paths.
+         */
+        bool compact_paths = false;
+
+        /**
+         * @param compact The path found as run-length encoded moves, only filled when compact_paths is true.
+         */
+        compact_path<index_type> compact;
+
+    protected:
+        /**
+         * @param scratch_resource The memory resource the scratch arrays of the derived agent allocate from.
+         * @note Each agent keeps its scratch arrays, under its Scratch Arrays heading, between searches so an agent that
+         *      pathfinds repeatedly only allocates on its first search or a bigger maze, unless release_arrays frees them.
+         */
+        std::pmr::memory_resource *scratch_resource;
+
+        /**
+         * @brief Frees scratch arrays back to the memory resource they were made on.
+         *
+         * @param scratch The scratch arrays, left empty on the same resource.
+         * @note Each agent's release_scratch frees all of its scratch arrays with this, so a scratch arena can be reset
+         *      before the next search. The next search makes them again.
+         */
+        template <typename... scratch_types>
+        static void release_arrays(scratch_types &...scratch)
+        {
+            ((scratch = scratch_types(scratch.get_allocator())), ...);
+        }
+    };
+
+    //// ------------------------- ////
+    //// Pathfinding Agent Concept ////
+    //// ------------------------- ////
+    /**
+     * @brief The requirements of an agent that can race on a maze.
+     *
+     * @tparam agent_type The agent class.
+     * @tparam maze_type The maze class the agent pathfinds on.
+     * @note Races and benchmarks only rely on these members so any agent satisfying it can be added to race_agents.
+     */
+    template <typename agent_type, typename maze_type>
+    concept pathfinding_agent = requires(agent_type agent, const maze_type &race_maze) {
+        agent.pathfind(race_maze);
+        { agent.path.size() } -> std::convertible_to<size_t>;
+        { agent.nodes_explored } -> std::convertible_to<uint64_t>;
+        { agent.pathfinding_completed } -> std::convertible_to<bool>;
+        { agent_type::name } -> std::convertible_to<std::string_view>;
+        { agent_type::display_name } -> std::convertible_to<std::string_view>;
+    };
+
     //// ----------------------- ////
     //// Depth-first Agent Class ////
     //// ----------------------- ////
     /**
      * @brief Agent class that does a depth-first search to find a path in a maze.
+     *
+     * @tparam index_type The unsigned integer type used for indices, must match the maze.
      */
-    class depth_first_agent
+    template <std::unsigned_integral index_type = uint64_t>
+    class depth_first_agent : public agent_base<index_type>
     {
     public:
+        /**
+         * @param name The name of the agent in machine-readable results.
+         */
+        static constexpr std::string_view name = "depth_first";
+
+        /**
+         * @param display_name The name of the agent in the race results.
+         */
+        static constexpr std::string_view display_name = "Depth-first";
+
         /**
          * @brief Constructs an agent object than can perform depth-first search pathfinding on mazes.
          *
@@ -45,39 +383,58 @@ namespace NPC_Racer
             // nothing to initialize on construction
         }
 
+        // constructed from a memory resource like agent_base
+        using agent_base<index_type>::agent_base;
+
+        /**
+         * @brief Frees the depth-first search's scratch arrays, see agent_base::release_arrays.
+         */
+        void release_scratch()
+        {
+            this->release_arrays(previous_nodes, visited_nodes, path_stack);
+        }
+
         /**
          * @brief Runs a depth-first search algorithm to determine a path from the start point to the destination point on the specified maze.
          *
          * @param race_maze The maze to do the pathfinding on.
          *
-         * @return A deque of index positions denoting a path between the start point and destination point.
+         * @return A vector of index positions denoting a path between the start point and destination point.
          * @cite inspired and translated from: https://github.com/mikepound/mazesolving
          */
-        std::deque<uint64_t> &pathfind(const NPC_Racer::maze &race_maze);
-
-        //// Data Members ////
-        // Public data members that could be used for purposes other than pathfinding are included here
+        std::vector<index_type> &pathfind(const NPC_Racer::maze<index_type> &race_maze)
+        {
+            return pathfind(race_maze, race_maze.start_position, race_maze.destination_position);
+        }
 
         /**
-         * @param current_position The current position of the agent during pathfinding.
+         * @brief Runs a depth-first search from any free position to any other on the specified maze, e.g. to answer path queries.
+         *
+         * @param race_maze The maze to do the pathfinding on.
+         * @param start_position The index to start from instead of the maze's start.
+         * @param destination_position The index to find a path to instead of the maze's destination.
+         *
+         * @return A vector of index positions denoting a path between the two positions, just the start position if there is none.
          */
-        uint64_t current_position;
+        std::vector<index_type> &pathfind(const NPC_Racer::maze<index_type> &race_maze, const index_type start_position, const index_type destination_position);
+
+    private:
+        //// Scratch Arrays ////
 
         /**
-         * @param pathfinding_completed If the pathfinding algorithm is completed or not.
+         * @param previous_nodes map containing indicies of previous nodes
          */
-        bool pathfinding_completed = false;
+        scratch_vector<index_type> previous_nodes = scratch_vector<index_type>(this->scratch_resource);
 
         /**
-         * @param path The path found from pathfinding composed of indicies.
-         * @note deque used for quick insertion
+         * @param visited_nodes bitmap of visited nodes
          */
-        std::deque<uint64_t> path = {};
+        scratch_vector<bool> visited_nodes = scratch_vector<bool>(this->scratch_resource);
 
         /**
-         * @param nodes_explored count of nodes explored in pathfinding
+         * @param path_stack stack of indicies to explore
          */
-        uint64_t nodes_explored = 0;
+        scratch_vector<index_type> path_stack = scratch_vector<index_type>(this->scratch_resource);
     };
 
     //// -------------------------------- ////
@@ -85,10 +442,23 @@ namespace NPC_Racer
     //// -------------------------------- ////
     /**
      * @brief Agent class that uses Dijkstra's algorithm to find the shortest path in a maze.
+     *
+     * @tparam index_type The unsigned integer type used for indices and distances, must match the maze.
      */
-    class dijkstra_agent
+    template <std::unsigned_integral index_type = uint64_t>
+    class dijkstra_agent : public agent_base<index_type>
     {
     public:
+        /**
+         * @param name The name of the agent in machine-readable results.
+         */
+        static constexpr std::string_view name = "dijkstra";
+
+        /**
+         * @param display_name The name of the agent in the race results.
+         */
+        static constexpr std::string_view display_name = "Dijkstra's";
+
         /**
          * @brief Constructs an agent object than can perform Dijkstra's algorithm search pathfinding on mazes.
          *
@@ -99,165 +469,1615 @@ namespace NPC_Racer
             // nothing to initialize on construction
         }
 
+        // constructed from a memory resource like agent_base
+        using agent_base<index_type>::agent_base;
+
+        /**
+         * @brief Frees the Dijkstra's search's scratch arrays, see agent_base::release_arrays.
+         */
+        void release_scratch()
+        {
+            this->release_arrays(node_distances, queue, previous_nodes, visited_nodes);
+        }
+
         /**
          * @brief Runs a Dijkstra's algorithm search to determine the shortest path from the start point to the destination point on the specified maze.
          *
-         * @return A deque of index positions denoting a path between the start point and destination point.
+         * @return A vector of index positions denoting a path between the start point and destination point.
          * @cite inspired and translated from: https://en.wikipedia.org/wiki/Dijkstra%27s_algorithm#Pseudocode
          * @note Follows the pseudocode closely so best to read that to understand first
          */
-        std::deque<uint64_t> &pathfind(const NPC_Racer::maze &race_maze);
+        std::vector<index_type> &pathfind(const NPC_Racer::maze<index_type> &race_maze)
+        {
+            return pathfind(race_maze, race_maze.start_position, race_maze.destination_position);
+        }
 
-        //// Data Members ////
-        // Public data members that could be used for purposes other than pathfinding are included here
+        /**
+         * @brief Runs a Dijkstra's algorithm search from any free position to any other on the specified maze, e.g. to answer path queries.
+         *
+         * @param race_maze The maze to do the pathfinding on.
+         * @param start_position The index to start from instead of the maze's start.
+         * @param destination_position The index to find a path to instead of the maze's destination.
+         *
+         * @return A vector of index positions denoting a path between the two positions, just the start position if there is none.
+         */
+        std::vector<index_type> &pathfind(const NPC_Racer::maze<index_type> &race_maze, const index_type start_position, const index_type destination_position);
+
+    private:
+        //// Scratch Arrays ////
 
         /**
-         * @param current_position The current position of the agent during pathfinding.
+         * @param node_distances vector containing the distances from the source to each node
          */
-        uint64_t current_position;
+        scratch_vector<index_type> node_distances = scratch_vector<index_type>(this->scratch_resource);
 
         /**
-         * @param pathfinding_completed If the pathfinding algorithm is completed or not.
+         * @param queue tracks distance if nodes and if nodes have been visited so far (0- (max_index-1) is in Q, max_index is not in Q)
          */
-        bool pathfinding_completed = false;
+        scratch_vector<index_type> queue = scratch_vector<index_type>(this->scratch_resource);
 
         /**
-         * @param path The path found from pathfinding composed of indicies.
-         * @note deque used for quick insertion
+         * @param previous_nodes map containing indicies of previous nodes
          */
-        std::deque<uint64_t> path = {};
+        scratch_vector<index_type> previous_nodes = scratch_vector<index_type>(this->scratch_resource);
 
         /**
-         * @param nodes_explored count of nodes explored in pathfinding
+         * @param visited_nodes bitmap of visited nodes
          */
-        uint64_t nodes_explored = 0;
+        scratch_vector<bool> visited_nodes = scratch_vector<bool>(this->scratch_resource);
     };
 
-}
 
-////// ============== //////
-////// Implementation //////
-////// ============== //////
+    //// ---------------------------------------------- ////
+    //// Bidirectional Dijkstra's Algorithm Agent Class ////
+    //// ---------------------------------------------- ////
+    /**
+     * @brief Agent class that runs Dijkstra's algorithm from both the start and the destination until the two searches meet.
+     *
+     * @tparam index_type The unsigned integer type used for indices and distances, must match the maze.
+     * @result Every move costs 1 so each search is a breadth-first search, and the one with the smaller frontier expands a whole
+     *      layer at a time. Two searches of half the distance explore far less of a long maze than one of the whole distance.
+     * @note Each position belongs to the first search to reach it, so both searches share one array of previous nodes and distances.
+     */
+    template <std::unsigned_integral index_type = uint64_t>
+    class bidirectional_dijkstra_agent : public agent_base<index_type>
+    {
+    public:
+        /**
+         * @param name The name of the agent in machine-readable results.
+         */
+        static constexpr std::string_view name = "bidirectional_dijkstra";
 
-std::deque<uint64_t> &NPC_Racer::depth_first_agent::pathfind(const NPC_Racer::maze &race_maze)
-{
-    // variables needed for pathfinding
-    std::vector<int64_t> previous_nodes;                               // map containing indicies of previous nodes
-    std::vector<bool> visited_nodes;                                   // bitmap of visited nodes
-    std::deque<uint64_t> path_stack = {race_maze.start_position};      // stack of indicies to explore
-    uint64_t next_position;                                            // the index of the next position to be explored
-    int64_t previous_position;                                         // index of the previous position to back-track and record the path
-    size_t number_directions = race_maze.connected_paths.at(0).size(); // number of neighbors, for 4-way grid should be 4
+        /**
+         * @param display_name The name of the agent in the race results.
+         */
+        static constexpr std::string_view display_name = "Bidirectional Dijkstra's";
 
-    // Resetting class variables for new pathfinding loop, if forget to do this they accumulate between runs
-    path = {};
-    nodes_explored = 0;
-    pathfinding_completed = false;
+        /**
+         * @brief Constructs an agent object than can perform bidirectional Dijkstra's algorithm pathfinding on mazes.
+         *
+         * @result Initializes the agent object.
+         */
+        bidirectional_dijkstra_agent()
+        {
+            // nothing to initialize on construction
+        }
 
-    // initializing variables
-    previous_nodes.resize(race_maze.character_maze.size(), -1);   // all -1 initially because none visited
-    visited_nodes.resize(race_maze.character_maze.size(), false); // all false initially
+        // constructed from a memory resource like agent_base
+        using agent_base<index_type>::agent_base;
 
-    // looping through and exploring all the paths depth-first (i.e. exploring up branch first)
-    while (!path_stack.empty()) // once path stack is empty we've explored as much as we can
-    {
-        nodes_explored++;                     // increment count
-        current_position = path_stack.back(); // pop the back of the stack
-        path_stack.pop_back();
+        /**
+         * @brief Frees the bidirectional Dijkstra's search's scratch arrays, see agent_base::release_arrays.
+         */
+        void release_scratch()
+        {
+            this->release_arrays(node_sides, node_distances, previous_nodes, frontiers[0], frontiers[1], next_frontier);
+        }
 
-        if (current_position == race_maze.destination_position) // guard for when made it to the end
+        /**
+         * @brief Runs a bidirectional Dijkstra's algorithm search to determine the shortest path from the start point to the destination point on the specified maze.
+         *
+         * @return A vector of index positions denoting a path between the start point and destination point.
+         */
+        std::vector<index_type> &pathfind(const NPC_Racer::maze<index_type> &race_maze)
         {
-            pathfinding_completed = true;
-            break;
+            return pathfind(race_maze, race_maze.start_position, race_maze.destination_position);
         }
 
-        visited_nodes[current_position] = true; // marking node as visited
+        /**
+         * @brief Runs a bidirectional Dijkstra's algorithm search from any free position to any other on the specified maze.
+         *
+         * @param race_maze The maze to do the pathfinding on.
+         * @param start_position The index to start from instead of the maze's start.
+         * @param destination_position The index to find a path to instead of the maze's destination.
+         *
+         * @return A vector of index positions denoting a path between the two positions, just the start position if there is none.
+         */
+        std::vector<index_type> &pathfind(const NPC_Racer::maze<index_type> &race_maze, const index_type start_position, const index_type destination_position);
+
+    private:
+        //// Scratch Arrays ////
+
+        /**
+         * @param node_sides Which search reached each node first: 0 neither, 1 from the start, 2 from the destination.
+         */
+        scratch_vector<uint8_t> node_sides = scratch_vector<uint8_t>(this->scratch_resource);
+
+        /**
+         * @param node_distances The distance of each node from the end of the search that reached it.
+         */
+        scratch_vector<index_type> node_distances = scratch_vector<index_type>(this->scratch_resource);
+
+        /**
+         * @param previous_nodes The node each node was reached from, towards the end of the search that reached it.
+         */
+        scratch_vector<index_type> previous_nodes = scratch_vector<index_type>(this->scratch_resource);
+
+        /**
+         * @param frontiers The current layer of each search, from the start then from the destination.
+         */
+        std::array<scratch_vector<index_type>, 2> frontiers = {scratch_vector<index_type>(this->scratch_resource), scratch_vector<index_type>(this->scratch_resource)};
+
+        /**
+         * @param next_frontier The layer being found by the search expanding.
+         */
+        scratch_vector<index_type> next_frontier = scratch_vector<index_type>(this->scratch_resource);
+    };
+
+    //// ---------------------------- ////
+    //// Bidirectional A* Agent Class ////
+    //// ------------------------------ ////
+    /**
+     * @brief Agent class that runs A* from both the start and the destination until neither search can find a shorter path.
+     *
+     * @tparam index_type The unsigned integer type used for indices and distances, must match the maze.
+     * @result Both searches use the average of the Manhattan distances to the two ends as their heuristic, which is consistent for
+     *      both at once, so the search can stop as soon as its two smallest keys add up to the shortest path found.
+     *      The search with the smaller frontier expands next.
+     * @cite Ikeda et al., "A fast algorithm for finding better routes by AI search techniques", 1994, for the average heuristic.
+     */
+    template <std::unsigned_integral index_type = uint64_t>
+    class bidirectional_astar_agent : public agent_base<index_type>
+    {
+    public:
+        /**
+         * @param name The name of the agent in machine-readable results.
+         */
+        static constexpr std::string_view name = "bidirectional_astar";
+
+        /**
+         * @param display_name The name of the agent in the race results.
+         */
+        static constexpr std::string_view display_name = "Bidirectional A*";
+
+        /**
+         * @brief Constructs an agent object than can perform bidirectional A* pathfinding on mazes.
+         *
+         * @result Initializes the agent object.
+         */
+        bidirectional_astar_agent()
+        {
+            // nothing to initialize on construction
+        }
+
+        // constructed from a memory resource like agent_base
+        using agent_base<index_type>::agent_base;
+
+        /**
+         * @brief Frees the bidirectional A* search's scratch arrays, see agent_base::release_arrays.
+         */
+        void release_scratch()
+        {
+            this->release_arrays(node_distances[0], node_distances[1], previous_nodes[0], previous_nodes[1], expanded_nodes, frontiers[0], frontiers[1]);
+        }
+
+        /**
+         * @brief Runs a bidirectional A* search to determine the shortest path from the start point to the destination point on the specified maze.
+         *
+         * @return A vector of index positions denoting a path between the start point and destination point.
+         */
+        std::vector<index_type> &pathfind(const NPC_Racer::maze<index_type> &race_maze)
+        {
+            return pathfind(race_maze, race_maze.start_position, race_maze.destination_position);
+        }
+
+        /**
+         * @brief Runs a bidirectional A* search from any free position to any other on the specified maze.
+         *
+         * @param race_maze The maze to do the pathfinding on.
+         * @param start_position The index to start from instead of the maze's start.
+         * @param destination_position The index to find a path to instead of the maze's destination.
+         *
+         * @return A vector of index positions denoting a path between the two positions, just the start position if there is none.
+         */
+        std::vector<index_type> &pathfind(const NPC_Racer::maze<index_type> &race_maze, const index_type start_position, const index_type destination_position);
+
+    private:
+        /**
+         * @brief A frontier key, twice the distance plus the heuristic so it stays a whole number.
+         * @note Keys are at most 4 times the number of elements, so mazes with 16-bit indices need 32-bit keys.
+         */
+        using key_type = std::conditional_t<(sizeof(index_type) < 4), uint32_t, uint64_t>;
+
+        //// Scratch Arrays ////
+
+        /**
+         * @param node_distances The distance of each node from the start, then from the destination.
+         */
+        std::array<scratch_vector<index_type>, 2> node_distances = {scratch_vector<index_type>(this->scratch_resource), scratch_vector<index_type>(this->scratch_resource)};
+
+        /**
+         * @param previous_nodes The node each node was reached from by the search from the start, then from the destination.
+         */
+        std::array<scratch_vector<index_type>, 2> previous_nodes = {scratch_vector<index_type>(this->scratch_resource), scratch_vector<index_type>(this->scratch_resource)};
+
+        /**
+         * @param expanded_nodes Bit 0 set once a node is expanded from the start, bit 1 once it's expanded from the destination.
+         */
+        scratch_vector<uint8_t> expanded_nodes = scratch_vector<uint8_t>(this->scratch_resource);
+
+        /**
+         * @param frontiers The heaps of keys and nodes of each search, from the start then from the destination.
+         */
+        std::array<scratch_vector<std::pair<key_type, index_type>>, 2> frontiers = {scratch_vector<std::pair<key_type, index_type>>(this->scratch_resource), scratch_vector<std::pair<key_type, index_type>>(this->scratch_resource)};
+    };
+
+    //// -------------------------- ////
+    //// Nearest Target Agent Class ////
+    //// -------------------------- ////
+    /**
+     * @brief Agent class that finds the shortest path from any of several sources to the nearest of several targets in one search.
+     *
+     * @tparam index_type The unsigned integer type used for indices, must match the maze.
+     * @result Every source is put in the frontier of one breadth-first search at distance 0, so the first target it reaches is the
+     *      nearest to any source. That answers "the path to the nearest exit" or "which NPC is closest to here" in a single pass
+     *      instead of one search per source and target pair.
+     */
+    template <std::unsigned_integral index_type = uint64_t>
+    class nearest_target_agent : public agent_base<index_type>
+    {
+    public:
+        /**
+         * @param name The name of the agent in machine-readable results.
+         */
+        static constexpr std::string_view name = "nearest_target";
+
+        /**
+         * @param display_name The name of the agent in the race results.
+         */
+        static constexpr std::string_view display_name = "Nearest target";
+
+        /**
+         * @param not_found The source or target found when no path was found.
+         */
+        static constexpr size_t not_found = std::numeric_limits<size_t>::max();
+
+        /**
+         * @brief Constructs an agent object than can find the nearest target from several sources on mazes.
+         *
+         * @result Initializes the agent object.
+         */
+        nearest_target_agent()
+        {
+            // nothing to initialize on construction
+        }
+
+        // constructed from a memory resource like agent_base
+        using agent_base<index_type>::agent_base;
+
+        /**
+         * @brief Frees the nearest target search's scratch arrays, see agent_base::release_arrays.
+         */
+        void release_scratch()
+        {
+            this->release_arrays(node_marks, previous_nodes, queue);
+        }
+
+        /**
+         * @brief Finds the shortest path from any start position `@` of the maze to the nearest destination position `X`.
+         *
+         * @return A vector of index positions denoting a path from the closest start to its nearest destination.
+         */
+        std::vector<index_type> &pathfind(const NPC_Racer::maze<index_type> &race_maze)
+        {
+            return pathfind(race_maze, race_maze.start_positions, race_maze.destination_positions);
+        }
+
+        /**
+         * @brief Finds the shortest path from any of the sources to the nearest of the targets on the specified maze.
+         *
+         * @param race_maze The maze to do the pathfinding on.
+         * @param sources The free positions the path can start from, e.g. every NPC.
+         * @param targets The free positions the path can end on, e.g. every exit.
+         *
+         * @return A vector of index positions denoting the path, just the first source if no target can be reached.
+         * @result found_source and found_target say which source and target the path joins.
+         */
+        std::vector<index_type> &pathfind(const NPC_Racer::maze<index_type> &race_maze, const std::vector<index_type> &sources, const std::vector<index_type> &targets);
+
+        /**
+         * @param found_source The place in the sources of the source the path starts from, not_found if there is no path.
+         */
+        size_t found_source = not_found;
+
+        /**
+         * @param found_target The place in the targets of the target the path ends on, not_found if there is no path.
+         */
+        size_t found_target = not_found;
+
+    private:
+        //// Scratch Arrays ////
+
+        /**
+         * @param node_marks Bit 0 set once a node is reached, bit 1 set if it's a target.
+         */
+        scratch_vector<uint8_t> node_marks = scratch_vector<uint8_t>(this->scratch_resource);
+
+        /**
+         * @param previous_nodes The node each node was reached from, no_path for the sources.
+         */
+        scratch_vector<index_type> previous_nodes = scratch_vector<index_type>(this->scratch_resource);
+
+        /**
+         * @param queue The breadth-first search queue, every node reached in order.
+         */
+        scratch_vector<index_type> queue = scratch_vector<index_type>(this->scratch_resource);
+    };
+
+    //// ---------------------- ////
+    //// Low-memory Agent Class ////
+    //// ---------------------- ////
+    /**
+     * @brief Agent class that finds the shortest path in a maze while keeping its scratch memory under a configurable limit.
+     *
+     * @tparam index_type The unsigned integer type used for indices, must match the maze.
+     * @result Searches breadth-first keeping only a visited bit and the 2-bit direction each node was reached from, 3 bits per
+     *      node instead of the several indices per node of the other agents, plus the current and next layer of the frontier.
+     *      If those don't fit in memory_limit it falls back to a divide-and-conquer frontier search, which keeps no per-node
+     *      arrays at all, trading time for memory.
+     * @note The frontier search finds the middle of the path with a bidirectional breadth-first search that only keeps the last
+     *      three layers from each end, then finds the two halves the same way. It explores each node about once per halving,
+     *      and fits in as little memory as a maze's widest frontier, which stays small in corridors.
+     */
+    template <std::unsigned_integral index_type = uint64_t>
+    class low_memory_agent : public agent_base<index_type>
+    {
+    public:
+        /**
+         * @param name The name of the agent in machine-readable results.
+         */
+        static constexpr std::string_view name = "low_memory";
+
+        /**
+         * @param display_name The name of the agent in the race results.
+         */
+        static constexpr std::string_view display_name = "Low-memory";
+
+        /**
+         * @brief Constructs an agent object than can perform memory-bounded pathfinding on mazes.
+         *
+         * @result Initializes the agent object.
+         */
+        low_memory_agent()
+        {
+            // nothing to initialize on construction
+        }
+
+        // constructed from a memory resource like agent_base
+        using agent_base<index_type>::agent_base;
+
+        /**
+         * @brief Frees the low-memory search's scratch arrays, see agent_base::release_arrays.
+         */
+        void release_scratch()
+        {
+            this->release_arrays(visited_words, direction_bytes, frontier_layers[0][0], frontier_layers[0][1], frontier_layers[0][2], frontier_layers[1][0], frontier_layers[1][1], frontier_layers[1][2]);
+        }
+
+        /**
+         * @brief Runs a memory-bounded search to determine the shortest path from the start point to the destination point on the specified maze.
+         *
+         * @return A vector of index positions denoting a path between the start point and destination point.
+         */
+        std::vector<index_type> &pathfind(const NPC_Racer::maze<index_type> &race_maze)
+        {
+            return pathfind(race_maze, race_maze.start_position, race_maze.destination_position);
+        }
+
+        /**
+         * @brief Runs a memory-bounded search from any free position to any other on the specified maze.
+         *
+         * @param race_maze The maze to do the pathfinding on.
+         * @param start_position The index to start from instead of the maze's start.
+         * @param destination_position The index to find a path to instead of the maze's destination.
+         *
+         * @return A vector of index positions denoting a path between the two positions, just the start position if there is none
+         *      or none could be found within the memory limit.
+         */
+        std::vector<index_type> &pathfind(const NPC_Racer::maze<index_type> &race_maze, const index_type start_position, const index_type destination_position);
+
+        /**
+         * @param memory_limit The most bytes of scratch memory a search can use, not counting the path it returns.
+         */
+        size_t memory_limit = std::numeric_limits<size_t>::max();
+
+        /**
+         * @param peak_memory_bytes The most bytes of scratch memory the last search held at once.
+         */
+        size_t peak_memory_bytes = 0;
+
+        /**
+         * @param frontier_search True if the last search didn't fit breadth-first and used the divide-and-conquer frontier search.
+         */
+        bool frontier_search = false;
+
+    private:
+        //// Private Member Functions ////
+        /**
+         * @brief Searches breadth-first with the packed visited bits and directions.
+         *
+         * @return True if the search finished within the memory limit, whether or not it found a path.
+         */
+        bool breadth_first_search(const NPC_Racer::maze<index_type> &race_maze, const index_type start_position, const index_type destination_position);
+
+        /**
+         * @brief Appends the shortest path after from_position up to and including to_position by finding its middle and then each half.
+         *
+         * @return True if the path was found within the memory limit, false if there is none or it didn't fit.
+         */
+        bool append_frontier_path(const NPC_Racer::maze<index_type> &race_maze, const index_type from_position, const index_type to_position);
+
+        /**
+         * @brief Searches breadth-first from both positions, keeping only the last three layers of each, until the frontiers meet.
+         *
+         * @param middle_position Set to the node the frontiers met at, at most one move off the middle of a shortest path.
+         * @param distance Set to the length of the shortest path, no_distance if there is none.
+         *
+         * @return True if the search finished within the memory limit.
+         */
+        bool meet_in_middle(const NPC_Racer::maze<index_type> &race_maze, const index_type from_position, const index_type to_position, index_type &middle_position, size_t &distance);
+
+        /**
+         * @brief Grows a scratch array by doubling its capacity, as long as the scratch memory stays within the limit.
+         *
+         * @param scratch The scratch array that is full.
+         * @param other_bytes The bytes of the rest of the scratch memory.
+         *
+         * @return True if it grew, false if growing would go over the limit.
+         * @result Raises peak_memory_bytes to the new total.
+         */
+        template <typename element_type>
+        bool grow_within_limit(scratch_vector<element_type> &scratch, const size_t other_bytes);
+
+        /**
+         * @brief The bytes held by the frontier layers of both ends.
+         */
+        size_t frontier_bytes() const;
+
+        //// Scratch Arrays ////
+
+        /**
+         * @param no_distance The distance of a path that doesn't exist.
+         */
+        static constexpr size_t no_distance = std::numeric_limits<size_t>::max();
+
+        /**
+         * @param visited_words One bit per node, set once the node is reached.
+         */
+        scratch_vector<uint64_t> visited_words = scratch_vector<uint64_t>(this->scratch_resource);
+
+        /**
+         * @param direction_bytes Four nodes per byte, the 2-bit direction of the move that reached each node in connected_paths order.
+         */
+        scratch_vector<uint8_t> direction_bytes = scratch_vector<uint8_t>(this->scratch_resource);
+
+        /**
+         * @param frontier_layers For each end, the previous, current and next layer, sorted. The breadth-first search only uses
+         *      the current and next layers of the first end.
+         * @note In a maze every neighbour of a layer is in the layer before, the layer itself or the next, so the last two
+         *      layers are enough to never go backwards without a closed set.
+         */
+        std::array<std::array<scratch_vector<index_type>, 3>, 2> frontier_layers = {{{scratch_vector<index_type>(this->scratch_resource), scratch_vector<index_type>(this->scratch_resource), scratch_vector<index_type>(this->scratch_resource)},
+                                                                                     {scratch_vector<index_type>(this->scratch_resource), scratch_vector<index_type>(this->scratch_resource), scratch_vector<index_type>(this->scratch_resource)}}};
+    };
+
+    //// ------------------------------ ////
+    //// Static Depth-first Agent Class ////
+    //// ------------------------------ ////
+    /**
+     * @brief Agent class that does a depth-first search to find a path in a static maze with no heap allocations.
+     *
+     * @tparam row_count The number of rows of the static maze.
+     * @tparam column_count The number of columns of the static maze.
+     * @note Can pathfind at compile time, e.g. `constexpr auto path = NPC_Racer::static_depth_first_agent<10, 10>().pathfind(room);`
+     */
+    template <size_t row_count, size_t column_count>
+    class static_depth_first_agent
+    {
+    public:
+        /**
+         * @param name The name of the agent in machine-readable results.
+         */
+        static constexpr std::string_view name = "static_depth_first";
+
+        /**
+         * @param display_name The name of the agent in the race results.
+         */
+        static constexpr std::string_view display_name = "Static depth-first";
+
+        using maze_type = NPC_Racer::static_maze<row_count, column_count>;
+        using index_type = typename maze_type::index_type;
+        using path_type = NPC_Racer::static_path<index_type, maze_type::element_count>;
+
+        /**
+         * @brief Constructs an agent object than can perform depth-first search pathfinding on static mazes.
+         *
+         * @result Initializes the agent object.
+         */
+        constexpr static_depth_first_agent()
+        {
+            // nothing to initialize on construction
+        }
+
+        /**
+         * @brief Runs a depth-first search algorithm to determine a path from the start point to the destination point on the specified static maze.
+         *
+         * @param race_maze The static maze to do the pathfinding on.
+         *
+         * @return A path of index positions between the start point and destination point. Size 1 if no path was found.
+         * @note Unlike depth_first_agent nodes already visited are skipped when popped, which bounds the stack at 4 pushes per element.
+         */
+        constexpr const path_type &pathfind(const maze_type &race_maze);
+
+        //// Data Members ////
+
+        /**
+         * @param current_position The current position of the agent during pathfinding.
+         */
+        index_type current_position = 0;
+
+        /**
+         * @param pathfinding_completed If the pathfinding algorithm is completed or not.
+         */
+        bool pathfinding_completed = false;
+
+        /**
+         * @param path The path found from pathfinding composed of indicies.
+         */
+        path_type path = {};
+
+        /**
+         * @param nodes_explored count of nodes explored in pathfinding
+         */
+        uint64_t nodes_explored = 0;
+
+        /**
+         * @param statistics Counts of the work done in the last pathfinding, empty unless compiled with NPC_RACER_SEARCH_STATISTICS.
+         */
+        [[no_unique_address]] search_statistics statistics;
+    };
+
+    //// --------------------------------------- ////
+    //// Static Dijkstra's Algorithm Agent Class ////
+    //// --------------------------------------- ////
+    /**
+     * @brief Agent class that uses Dijkstra's algorithm to find the shortest path in a static maze with no heap allocations.
+     *
+     * @tparam row_count The number of rows of the static maze.
+     * @tparam column_count The number of columns of the static maze.
+     */
+    template <size_t row_count, size_t column_count>
+    class static_dijkstra_agent
+    {
+    public:
+        /**
+         * @param name The name of the agent in machine-readable results.
+         */
+        static constexpr std::string_view name = "static_dijkstra";
+
+        /**
+         * @param display_name The name of the agent in the race results.
+         */
+        static constexpr std::string_view display_name = "Static Dijkstra's";
+
+        using maze_type = NPC_Racer::static_maze<row_count, column_count>;
+        using index_type = typename maze_type::index_type;
+        using path_type = NPC_Racer::static_path<index_type, maze_type::element_count>;
+
+        /**
+         * @brief Constructs an agent object than can perform Dijkstra's algorithm pathfinding on static mazes.
+         *
+         * @result Initializes the agent object.
+         */
+        constexpr static_dijkstra_agent()
+        {
+            // nothing to initialize on construction
+        }
+
+        /**
+         * @brief Runs a Dijkstra's algorithm search to determine the shortest path from the start point to the destination point on the specified static maze.
+         *
+         * @param race_maze The static maze to do the pathfinding on.
+         *
+         * @return The shortest path of index positions between the start point and destination point. Size 1 if no path was found.
+         * @note Same algorithm as dijkstra_agent with std::arrays instead of std::vectors.
+         */
+        constexpr const path_type &pathfind(const maze_type &race_maze);
+
+        //// Data Members ////
+
+        /**
+         * @param current_position The current position of the agent during pathfinding.
+         */
+        index_type current_position = 0;
+
+        /**
+         * @param pathfinding_completed If the pathfinding algorithm is completed or not.
+         */
+        bool pathfinding_completed = false;
+
+        /**
+         * @param path The path found from pathfinding composed of indicies.
+         */
+        path_type path = {};
+
+        /**
+         * @param nodes_explored count of nodes explored in pathfinding
+         */
+        uint64_t nodes_explored = 0;
+
+        /**
+         * @param statistics Counts of the work done in the last pathfinding, empty unless compiled with NPC_RACER_SEARCH_STATISTICS.
+         */
+        [[no_unique_address]] search_statistics statistics;
+    };
+
+    //// -------------- ////
+    //// Agent Registry ////
+    //// -------------- ////
+    /**
+     * @brief Compile-time list of agent class templates that race together.
+     *
+     * @tparam agent_templates The agent class templates, each taking the index type.
+     * @note Races are expanded at compile time over the list so there is no virtual dispatch in the timed loops.
+     */
+    template <template <std::unsigned_integral> class... agent_templates>
+    struct agent_registry
+    {
+        /**
+         * @param size The number of agents in the registry.
+         */
+        static constexpr size_t size = sizeof...(agent_templates);
+
+        /**
+         * @param names The machine-readable name of each agent in order.
+         */
+        static constexpr std::array<std::string_view, size> names = {agent_templates<uint64_t>::name...};
+
+        /**
+         * @brief A tuple holding one of each agent for a maze with this index type.
+         */
+        template <std::unsigned_integral index_type>
+        using agents = std::tuple<agent_templates<index_type>...>;
+
+        /**
+         * @brief Makes one of each agent with its scratch arrays on the given memory resources.
+         *
+         * @param resources The memory resource of each agent in order, e.g. a NPC_Racer::scratch_arena each.
+         *
+         * @return The agents.
+         */
+        template <std::unsigned_integral index_type>
+        static std::tuple<agent_templates<index_type>...> make_agents(const std::array<std::pmr::memory_resource *, size> &resources)
+        {
+            return [&]<size_t... i>(std::index_sequence<i...>)
+            {
+                return std::tuple<agent_templates<index_type>...>(agent_templates<index_type>(resources[i])...);
+            }(std::make_index_sequence<size>());
+        }
+
+        static_assert((pathfinding_agent<agent_templates<uint64_t>, maze<uint64_t>> and ...), "Every registered agent must satisfy pathfinding_agent.");
+    };
+
+    /**
+     * @brief The agents raced by the program, add a new agent here to race it.
+     * @note Add new agents at the end, the C library numbers agents by their place in this list.
+     */
+    using race_agents = agent_registry<depth_first_agent, dijkstra_agent, bidirectional_dijkstra_agent, bidirectional_astar_agent, low_memory_agent>;
+
+    /**
+     * @brief Calls a function on each agent of a tuple of agents in order.
+     *
+     * @tparam agent_tuple A std::tuple of agents, e.g. race_agents::agents<index_type>.
+     * @tparam function_type A callable taking an agent and its position in the tuple as a size_t.
+     * @param agents The agents.
+     * @param function The function to call.
+     */
+    template <typename agent_tuple, typename function_type>
+    void for_each_agent(agent_tuple &agents, function_type &&function)
+    {
+        [&]<size_t... i>(std::index_sequence<i...>)
+        {
+            (function(std::get<i>(agents), i), ...);
+        }(std::make_index_sequence<std::tuple_size_v<agent_tuple>>());
+    }
+}
+
+////// ============== //////
+////// Implementation //////
+////// ============== //////
+
+template <std::unsigned_integral index_type>
+std::vector<index_type> &NPC_Racer::depth_first_agent<index_type>::pathfind(const NPC_Racer::maze<index_type> &race_maze, const index_type start_position, const index_type destination_position)
+{
+    // the edges of the maze, built by the first search on it
+    const std::vector<std::array<index_type, 4>> &connected_paths = race_maze.adjacency();
+
+    // variables needed for pathfinding
+    constexpr index_type no_path = NPC_Racer::maze<index_type>::no_path; // marks no previous node or no connected path
+    index_type next_position;                                            // the index of the next position to be explored
+    index_type previous_position;                                        // index of the previous position to back-track and record the path
+    size_t number_directions = connected_paths.at(0).size();             // number of neighbors, for 4-way grid should be 4
+
+    // Resetting class variables for new pathfinding loop, if forget to do this they accumulate between runs
+    this->path.clear(); // clearing keeps the capacity so repeated searches don't allocate
+    this->nodes_explored = 0;
+    this->pathfinding_completed = false;
+    this->statistics.start_search();
+    this->trace.start();
+
+    // initializing the scratch arrays, assign reuses their memory from the last search
+    previous_nodes.assign(race_maze.character_maze.size(), no_path); // all no_path initially because none visited
+    visited_nodes.assign(race_maze.character_maze.size(), false);    // all false initially
+    path_stack.assign(1, start_position);                            // exploring from the start
+    this->statistics.count_scratch_bytes(previous_nodes.capacity() * sizeof(index_type) + visited_nodes.capacity() / 8);
+    this->statistics.count_push(path_stack.size());
+
+    // looping through and exploring all the paths depth-first (i.e. exploring up branch first)
+    while (!path_stack.empty()) // once path stack is empty we've explored as much as we can
+    {
+        this->nodes_explored++;                     // increment count
+        this->current_position = path_stack.back(); // pop the back of the stack
+        path_stack.pop_back();
+        this->statistics.count_pop();
+        this->trace.record(this->current_position, path_stack.size());
+
+        if (this->current_position == destination_position) // guard for when made it to the end
+        {
+            this->pathfinding_completed = true;
+            break;
+        }
+
+        visited_nodes[this->current_position] = true; // marking node as visited
 
         // remember the 4 directions in the inner array of connected_paths:
         // 0  1    2    3
         // up down left right
         for (size_t i = 0; i < number_directions; i++) // checking all the edges at the node
         {
-            if (race_maze.connected_paths[current_position][i] != -1) // if edge not empty
+            if (connected_paths[this->current_position][i] != no_path) // if edge not empty
+            {
+                // next position is in that direction
+                next_position = connected_paths[this->current_position][i];
+                if (visited_nodes[next_position] == false) // if not explored
+                {
+                    // adds the next position to be explored on the stack
+                    path_stack.push_back(next_position);
+                    // adds current position to previous position tracker to know where we came from
+                    previous_nodes[next_position] = this->current_position;
+                    this->statistics.count_push(path_stack.size());
+                    this->statistics.count_edge_relaxed();
+                }
+            }
+        }
+    }
+
+    this->statistics.end_search();
+
+    if (this->current_position != destination_position) // if for some reason didn't end on the destination
+    {
+        // for now a warning will just throw and we'll return a size 1 path (which means no path found)
+        if (this->warnings)
+            std::cout << "WARNING: Path to exit was not found!";
+        if (this->compact_paths)
+            this->compact.assign(start_position, race_maze.columns());
+        this->path.assign(this->compact_paths ? 0 : 1, start_position); // left empty when the path is kept compact
+        return this->path;
+    }
+
+    if (this->compact_paths) // the moves are encoded while backtracking so the positions are never stored
+    {
+        this->compact.backtrack(previous_nodes, start_position, this->current_position, race_maze.columns(), no_path);
+        this->statistics.end_reconstruction();
+        return this->path;
+    }
+
+    previous_position = this->current_position; // setting to end position to backtrack
+    // backtracking from the end position to generate the path
+    while (previous_position != no_path) // while not at an empty previous path i.e. still backtracking
+    {
+        this->path.push_back(previous_position); // adding node to the path, backwards until reversed
+        if (previous_position == start_position) // if reached the start then end
+            break;
+        previous_position = previous_nodes[previous_position]; // backtracking
+    }
+    std::reverse(this->path.begin(), this->path.end()); // start to destination
+    this->statistics.end_reconstruction();
+
+    return this->path;
+}
+
+template <std::unsigned_integral index_type>
+std::vector<index_type> &NPC_Racer::dijkstra_agent<index_type>::pathfind(const NPC_Racer::maze<index_type> &race_maze, const index_type start_position, const index_type destination_position)
+{
+    // the edges of the maze, built by the first search on it
+    const std::vector<std::array<index_type, 4>> &connected_paths = race_maze.adjacency();
+
+    // variables needed for pathfinding
+    constexpr index_type no_path = NPC_Racer::maze<index_type>::no_path; // marks no previous node or no connected path
+    index_type next_position;                                            // the index of the next position to be explored
+    index_type previous_position;                                        // index of the previous position to back-track and record the path
+    size_t number_directions = connected_paths.at(0).size();             // number of neighbors, for 4-way grid should be 4
+    index_type max_index = std::numeric_limits<index_type>::max();       // max size index_type, infinite distance or an empty element in the queue
+    index_type max_index_minus_one = (index_type)(max_index - 1);        // max size index_type, infinite distance in the queue. index_fits makes sure no real distance reaches it
+    size_t queue_counter;                                                // tracks non-infinite elements in queue, if is 0 it's empty
+    index_type distance_through_current;                                 // the distance of next_position through current one
+    size_t frontier_size = 1;                                            // elements in the queue with a finite distance, only used for statistics
+
+    // Resetting class variables for new pathfinding loop
+    this->path.clear();
+    this->nodes_explored = 0;
+    this->pathfinding_completed = false;
+    this->statistics.start_search();
+    this->trace.start();
+
+    // initializing variables
+    // initially all distances, besides start node, start at infinity (max int)
+    // assign reuses the scratch arrays' memory from the last search
+    node_distances.assign(race_maze.character_maze.size(), max_index);
+    queue.assign(race_maze.character_maze.size(), max_index_minus_one);
+    previous_nodes.assign(race_maze.character_maze.size(), no_path); // all no_path initially because none visited
+    visited_nodes.assign(race_maze.character_maze.size(), false);    // all false initially
+    this->statistics.count_scratch_bytes((node_distances.capacity() + queue.capacity() + previous_nodes.capacity()) * sizeof(index_type) + visited_nodes.capacity() / 8);
+    this->statistics.count_push(frontier_size);
+
+    node_distances[start_position] = 0; // setting distance of start position
+    queue[start_position] = 0;          // any time we update distance we also need to update the distance tracker
+    queue_counter = race_maze.character_maze.size();
+
+    this->current_position = start_position; // starting at the start node
+
+    // Performing Dijkstra algorithm
+    while (queue_counter != 0)
+    {
+        this->nodes_explored++; // increment count
+        // minimum element of queue, from https://en.cppreference.com/w/cpp/algorithm/min_element
+        typename scratch_vector<index_type>::iterator min_iterator = std::min_element(queue.begin(), queue.end()); // iterator to min element
+        this->current_position = (index_type)std::distance(queue.begin(), min_iterator);
+
+        queue[this->current_position] = max_index; // removing element from Q
+        queue_counter--;
+        visited_nodes[this->current_position] = true; // marking as explored
+        frontier_size -= (frontier_size > 0); // infinite distance elements can be removed once the frontier is empty
+        this->statistics.count_pop();
+        this->trace.record(this->current_position, frontier_size);
+
+        if (this->current_position == destination_position) // guard for when made it to the end
+        {
+            this->pathfinding_completed = true;
+            break;
+        }
+
+        // remember the 4 directions in the inner array of connected_paths:
+        // 0  1    2    3
+        // up down left right
+        for (size_t i = 0; i < number_directions; i++) // checking all the edges at the node
+        {
+
+            if (connected_paths[this->current_position][i] != no_path) // if edge not empty
+            {
+                // next position is in that direction
+                next_position = connected_paths[this->current_position][i];
+                if (queue[next_position] != max_index) // if still in queue
+                {
+                    distance_through_current = (index_type)(node_distances[this->current_position] + 1); // the distance of the neighbour from source through current node (all weights are 1 for grid)
+                    if (distance_through_current < node_distances[next_position])    // if new distance less than old one
+                    {
+                        if (node_distances[next_position] == max_index) // first time reached so joins the frontier
+                            this->statistics.count_push(++frontier_size);
+                        else
+                            this->statistics.count_decrease_key();
+                        this->statistics.count_edge_relaxed();
+                        node_distances[next_position] = distance_through_current; // update distance
+                        queue[next_position] = distance_through_current;          // update distance in queue
+                        // adds current position to previous position tracker to know where we came from
+                        previous_nodes[next_position] = this->current_position;
+                    }
+                }
+            }
+        }
+    }
+
+    this->statistics.end_search();
+
+    if (this->current_position != destination_position) // if for some reason didn't end on the destination
+    {
+        // for now a warning will just throw and we'll return a size 1 path (which means no path found)
+        if (this->warnings)
+            std::cout << "WARNING: Path to exit was not found!";
+        if (this->compact_paths)
+            this->compact.assign(start_position, race_maze.columns());
+        this->path.assign(this->compact_paths ? 0 : 1, start_position); // left empty when the path is kept compact
+        return this->path;
+    }
+
+    previous_position = this->current_position; // setting to end position to backtrack
+
+    if ((previous_nodes[previous_position] == no_path) or (previous_position == start_position)) // guard for if vertex is non-reachable (no exit from start or end position)
+    {
+        // for now a warning will just throw and we'll return a size 1 path (which means no path found)
+        if (this->warnings)
+            std::cout << "WARNING: End Vertex is non-reachable";
+        if (this->compact_paths)
+            this->compact.assign(start_position, race_maze.columns());
+        this->path.assign(this->compact_paths ? 0 : 1, start_position); // left empty when the path is kept compact
+        return this->path;
+    }
+
+    if (this->compact_paths) // the moves are encoded while backtracking so the positions are never stored
+    {
+        this->compact.backtrack(previous_nodes, start_position, this->current_position, race_maze.columns(), no_path);
+        this->statistics.end_reconstruction();
+        return this->path;
+    }
+
+    // backtracking from the end position to generate the path
+    while (previous_position != no_path) // while not at an empty previous path i.e. still backtracking
+    {
+        this->path.push_back(previous_position); // adding node to the path, backwards until reversed
+        if (previous_position == start_position) // if reached the start then end
+            break;
+        previous_position = previous_nodes[previous_position]; // backtracking
+    }
+    std::reverse(this->path.begin(), this->path.end()); // start to destination
+    this->statistics.end_reconstruction();
+
+    return this->path; // returns the path
+}
+
+template <std::unsigned_integral index_type>
+std::vector<index_type> &NPC_Racer::bidirectional_dijkstra_agent<index_type>::pathfind(const NPC_Racer::maze<index_type> &race_maze, const index_type start_position, const index_type destination_position)
+{
+    // the edges of the maze, built by the first search on it
+    const std::vector<std::array<index_type, 4>> &connected_paths = race_maze.adjacency();
+
+    // variables needed for pathfinding
+    constexpr index_type no_path = NPC_Racer::maze<index_type>::no_path; // marks no previous node or no connected path
+    constexpr uint8_t unreached = 0;                                     // the side of a node neither search has reached
+    index_type best_distance = no_path;                                  // the length of the shortest path found, no_path until the searches meet
+    index_type forward_meeting = no_path;                                // the last node of the shortest path reached from the start
+    index_type backward_meeting = no_path;                               // the first node of the shortest path reached from the destination
+
+    // Resetting class variables for new pathfinding loop
+    this->path.clear();
+    this->nodes_explored = 0;
+    this->pathfinding_completed = false;
+    this->statistics.start_search();
+    this->trace.start();
+
+    // only the sides need clearing, distances and previous nodes are only read where a side has been set
+    node_sides.assign(race_maze.character_maze.size(), unreached);
+    node_distances.resize(race_maze.character_maze.size());
+    previous_nodes.resize(race_maze.character_maze.size());
+    this->statistics.count_scratch_bytes(node_sides.capacity() + (node_distances.capacity() + previous_nodes.capacity()) * sizeof(index_type));
+
+    std::array<index_type, 2> ends = {start_position, destination_position};
+    for (size_t side = 0; side < 2; side++)
+    {
+        frontiers[side].assign(1, ends[side]);
+        node_sides[ends[side]] = (uint8_t)(side + 1);
+        node_distances[ends[side]] = 0;
+        previous_nodes[ends[side]] = no_path;
+        this->statistics.count_push(side + 1);
+    }
+    if (start_position == destination_position) // already there, the path is just the start
+    {
+        best_distance = 0;
+        forward_meeting = start_position;
+        backward_meeting = start_position;
+    }
+
+    this->current_position = start_position;
+
+    // expanding a whole layer of the smaller frontier at a time until the searches touch
+    while ((best_distance == no_path) and !frontiers[0].empty() and !frontiers[1].empty())
+    {
+        size_t side = (frontiers[0].size() <= frontiers[1].size()) ? 0 : 1;
+        uint8_t own_side = (uint8_t)(side + 1);
+        uint8_t other_side = (uint8_t)(2 - side);
+        next_frontier.clear();
+        for (index_type position : frontiers[side])
+        {
+            this->nodes_explored++;
+            this->current_position = position;
+            this->statistics.count_pop();
+            this->trace.record(position, frontiers[0].size() + frontiers[1].size() + next_frontier.size());
+
+            for (index_type next_position : connected_paths[position])
             {
-                // next position is in that direction
-                next_position = (uint64_t)race_maze.connected_paths[current_position][i];
-                if (visited_nodes[next_position] == false) // if not explored
+                if (next_position == no_path)
+                    continue;
+                if (node_sides[next_position] == unreached) // first reached, so it joins this search's next layer
                 {
-                    // adds the next position to be explored on the stack
-                    path_stack.push_back(next_position);
-                    // adds current position to previous position tracker to know where we came from
-                    previous_nodes[next_position] = (int64_t)current_position;
+                    node_sides[next_position] = own_side;
+                    node_distances[next_position] = (index_type)(node_distances[position] + 1);
+                    previous_nodes[next_position] = position;
+                    next_frontier.push_back(next_position);
+                    this->statistics.count_push(frontiers[0].size() + frontiers[1].size() + next_frontier.size());
+                    this->statistics.count_edge_relaxed();
+                }
+                else if (node_sides[next_position] == other_side) // the searches touch, the rest of the layer may still touch closer
+                {
+                    index_type distance_through = (index_type)(node_distances[position] + 1 + node_distances[next_position]);
+                    if (distance_through < best_distance)
+                    {
+                        best_distance = distance_through;
+                        forward_meeting = (side == 0) ? position : next_position;
+                        backward_meeting = (side == 0) ? next_position : position;
+                    }
                 }
             }
         }
+        frontiers[side].swap(next_frontier);
     }
 
-    if (current_position != race_maze.destination_position) // if for some reason didn't end on the destination
+    this->statistics.end_search();
+
+    if (best_distance == no_path) // the searches never met
     {
-        // for now a warning will just throw and we'll return a size 1 path (which means no path found)
-        std::cout << "WARNING: Path to exit was not found!";
-        path = {race_maze.start_position};
-        return path;
+        if (this->warnings)
+            std::cout << "WARNING: Path to exit was not found!";
+        if (this->compact_paths)
+            this->compact.assign(start_position, race_maze.columns());
+        this->path.assign(this->compact_paths ? 0 : 1, start_position); // left empty when the path is kept compact
+        return this->path;
     }
+    this->pathfinding_completed = true;
 
-    previous_position = (int64_t)current_position; // setting to end position to backtrack
-    // backtracking from the end position to generate the path
-    while (previous_position != -1) // while not at an empty previous path i.e. still backtracking
+    // splicing the path: backtracking to the start and reversing, then backtracking on to the destination
+    for (index_type position = forward_meeting; position != no_path; position = previous_nodes[position])
+        this->path.push_back(position);
+    std::reverse(this->path.begin(), this->path.end());
+    if (backward_meeting != forward_meeting)
+        for (index_type position = backward_meeting; position != no_path; position = previous_nodes[position])
+            this->path.push_back(position);
+
+    if (this->compact_paths) // the path is spliced from two searches so it's encoded once it's whole
+    {
+        this->compact.assign(this->path, race_maze.columns());
+        this->path.clear();
+    }
+    this->statistics.end_reconstruction();
+
+    return this->path;
+}
+
+template <std::unsigned_integral index_type>
+std::vector<index_type> &NPC_Racer::bidirectional_astar_agent<index_type>::pathfind(const NPC_Racer::maze<index_type> &race_maze, const index_type start_position, const index_type destination_position)
+{
+    // the edges of the maze, built by the first search on it
+    const std::vector<std::array<index_type, 4>> &connected_paths = race_maze.adjacency();
+
+    // variables needed for pathfinding
+    constexpr index_type no_path = NPC_Racer::maze<index_type>::no_path; // marks no previous node or no connected path
+    constexpr index_type unreached = std::numeric_limits<index_type>::max(); // the distance of a node a search hasn't reached
+    size_t columns = race_maze.columns();
+    index_type best_distance = unreached;                                // the length of the shortest path found
+    index_type meeting_position = no_path;                               // the node of the shortest path found reached by both searches
+    std::array<index_type, 2> ends = {start_position, destination_position};
+    auto expanded_later = std::greater<std::pair<key_type, index_type>>();
+
+    // the Manhattan distance, the fewest moves between two positions with no barriers in the way
+    auto manhattan_distance = [columns](const index_type from, const index_type to) -> key_type
+    {
+        size_t from_row = from / columns, from_column = from % columns;
+        size_t to_row = to / columns, to_column = to % columns;
+        return (key_type)(((from_row > to_row) ? from_row - to_row : to_row - from_row) + ((from_column > to_column) ? from_column - to_column : to_column - from_column));
+    };
+    key_type end_distance = manhattan_distance(start_position, destination_position);
+
+    // twice the distance plus the average heuristic, (h_other - h_own) / 2, shifted by the end distance so it's never negative
+    auto frontier_key = [&](const size_t side, const index_type position, const index_type distance) -> key_type
+    {
+        return (key_type)(2 * (key_type)distance + manhattan_distance(position, ends[1 - side]) + end_distance - manhattan_distance(position, ends[side]));
+    };
+
+    // Resetting class variables for new pathfinding loop
+    this->path.clear();
+    this->nodes_explored = 0;
+    this->pathfinding_completed = false;
+    this->statistics.start_search();
+    this->trace.start();
+
+    // previous nodes are only read where a distance has been set
+    expanded_nodes.assign(race_maze.character_maze.size(), 0);
+    for (size_t side = 0; side < 2; side++)
+    {
+        node_distances[side].assign(race_maze.character_maze.size(), unreached);
+        previous_nodes[side].resize(race_maze.character_maze.size());
+        frontiers[side].clear();
+        node_distances[side][ends[side]] = 0;
+        previous_nodes[side][ends[side]] = no_path;
+        frontiers[side].push_back({frontier_key(side, ends[side], 0), ends[side]});
+        this->statistics.count_push(side + 1);
+    }
+    this->statistics.count_scratch_bytes(expanded_nodes.capacity() +
+                                   (node_distances[0].capacity() + node_distances[1].capacity() + previous_nodes[0].capacity() + previous_nodes[1].capacity()) * sizeof(index_type));
+    if (start_position == destination_position) // already there, the path is just the start
     {
-        path.push_front((uint64_t)previous_position);                // adding node to the path
-        if ((uint64_t)previous_position == race_maze.start_position) // if reached the start then end
+        best_distance = 0;
+        meeting_position = start_position;
+    }
+
+    this->current_position = start_position;
+
+    // a search that runs out of nodes has found every path it can, so both need a frontier to continue
+    while (!frontiers[0].empty() and !frontiers[1].empty())
+    {
+        // with consistent heuristics no path is shorter than the best once the two smallest keys reach it
+        if ((best_distance != unreached) and (frontiers[0].front().first + frontiers[1].front().first >= 2 * (key_type)best_distance + 2 * end_distance))
             break;
-        previous_position = previous_nodes[(size_t)previous_position]; // backtracking
+
+        size_t side = (frontiers[0].size() <= frontiers[1].size()) ? 0 : 1;
+        uint8_t side_bit = (uint8_t)(1 << side);
+        std::pop_heap(frontiers[side].begin(), frontiers[side].end(), expanded_later);
+        index_type position = frontiers[side].back().second;
+        frontiers[side].pop_back();
+        this->statistics.count_pop();
+        if (expanded_nodes[position] & side_bit) // an older entry of a node reached again by a shorter path
+            continue;
+        expanded_nodes[position] = (uint8_t)(expanded_nodes[position] | side_bit);
+        this->nodes_explored++;
+        this->current_position = position;
+        this->trace.record(position, frontiers[0].size() + frontiers[1].size());
+
+        for (index_type next_position : connected_paths[position])
+        {
+            if (next_position == no_path)
+                continue;
+            index_type distance_through_current = (index_type)(node_distances[side][position] + 1);
+            if (distance_through_current >= node_distances[side][next_position])
+                continue;
+            if (node_distances[side][next_position] == unreached) // first time reached so joins the frontier
+                this->statistics.count_push(frontiers[0].size() + frontiers[1].size() + 1);
+            else
+                this->statistics.count_decrease_key();
+            this->statistics.count_edge_relaxed();
+            node_distances[side][next_position] = distance_through_current;
+            previous_nodes[side][next_position] = position;
+            frontiers[side].push_back({frontier_key(side, next_position, distance_through_current), next_position});
+            std::push_heap(frontiers[side].begin(), frontiers[side].end(), expanded_later);
+
+            // a node both searches have reached joins a path from the start to the destination
+            index_type other_distance = node_distances[1 - side][next_position];
+            if ((other_distance != unreached) and (distance_through_current + other_distance < best_distance))
+            {
+                best_distance = (index_type)(distance_through_current + other_distance);
+                meeting_position = next_position;
+            }
+        }
     }
 
-    return path;
+    this->statistics.end_search();
+
+    if (meeting_position == no_path) // the searches never met
+    {
+        if (this->warnings)
+            std::cout << "WARNING: Path to exit was not found!";
+        if (this->compact_paths)
+            this->compact.assign(start_position, race_maze.columns());
+        this->path.assign(this->compact_paths ? 0 : 1, start_position); // left empty when the path is kept compact
+        return this->path;
+    }
+    this->pathfinding_completed = true;
+
+    // splicing the path: backtracking to the start and reversing, then backtracking on to the destination
+    for (index_type position = meeting_position; position != no_path; position = previous_nodes[0][position])
+        this->path.push_back(position);
+    std::reverse(this->path.begin(), this->path.end());
+    for (index_type position = previous_nodes[1][meeting_position]; position != no_path; position = previous_nodes[1][position])
+        this->path.push_back(position);
+
+    if (this->compact_paths) // the path is spliced from two searches so it's encoded once it's whole
+    {
+        this->compact.assign(this->path, race_maze.columns());
+        this->path.clear();
+    }
+    this->statistics.end_reconstruction();
+
+    return this->path;
 }
 
-std::deque<uint64_t> &NPC_Racer::dijkstra_agent::pathfind(const NPC_Racer::maze &race_maze)
+template <std::unsigned_integral index_type>
+std::vector<index_type> &NPC_Racer::nearest_target_agent<index_type>::pathfind(const NPC_Racer::maze<index_type> &race_maze, const std::vector<index_type> &sources, const std::vector<index_type> &targets)
 {
+    // the edges of the maze, built by the first search on it
+    const std::vector<std::array<index_type, 4>> &connected_paths = race_maze.adjacency();
+
     // variables needed for pathfinding
-    std::vector<uint64_t> node_distances;                              // vector containing the distances from the source to each node
-    std::vector<uint64_t> queue;                                       // tracks distance if nodes and if nodes have been visited so far (0- (max_int64-1) is in Q, max_int64 is not in Q)
-    std::vector<int64_t> previous_nodes;                               // map containing indicies of previous nodes
-    std::vector<bool> visited_nodes;                                   // bitmap of visited nodes
-    uint64_t next_position;                                            // the index of the next position to be explored
-    int64_t previous_position;                                         // index of the previous position to back-track and record the path
-    size_t number_directions = race_maze.connected_paths.at(0).size(); // number of neighbors, for 4-way grid should be 4
-    uint64_t max_uint64 = std::numeric_limits<uint64_t>::max();        // max size uint64_t, infinite distance or an empty element in the queue
-    uint64_t max_uint64_minus_one = max_uint64 - 1;                    // max size uint64_t, infinite distance in the queue
-    size_t queue_counter;                                              // tracks non-infinite elements in queue, if is 0 it's empty
-    uint64_t distance_through_current;                                 // the distance of next_position through current one
+    constexpr index_type no_path = NPC_Racer::maze<index_type>::no_path; // marks no previous node or no connected path
+    constexpr uint8_t reached = 1;                                       // node_marks bit of a node the search has reached
+    constexpr uint8_t target = 2;                                        // node_marks bit of a target
 
     // Resetting class variables for new pathfinding loop
-    path = {};
-    nodes_explored = 0;
-    pathfinding_completed = false;
+    this->path.clear();
+    this->nodes_explored = 0;
+    this->pathfinding_completed = false;
+    found_source = not_found;
+    found_target = not_found;
+    this->statistics.start_search();
+    this->trace.start();
 
-    // initializing variables
-    // initially all distances, besides start node, start at infinity (max int)
-    node_distances.resize(race_maze.character_maze.size(), max_uint64);
-    queue.resize(race_maze.character_maze.size(), max_uint64_minus_one);
-    previous_nodes.resize(race_maze.character_maze.size(), -1);   // all -1 initially because none visited
-    visited_nodes.resize(race_maze.character_maze.size(), false); // all false initially
+    // previous nodes are only read where a node has been reached
+    node_marks.assign(race_maze.character_maze.size(), 0);
+    previous_nodes.resize(race_maze.character_maze.size());
+    queue.clear();
+    this->statistics.count_scratch_bytes(node_marks.capacity() + (previous_nodes.capacity() + queue.capacity()) * sizeof(index_type));
+    if (sources.empty())
+        return this->path;
 
-    node_distances[race_maze.start_position] = 0; // setting distance of start position
-    queue[race_maze.start_position] = 0;          // any time we update distance we also need to update the distance tracker
-    queue_counter = race_maze.character_maze.size();
+    for (index_type position : targets)
+        node_marks[position] = target;
+    for (index_type position : sources) // every source starts in the frontier, a repeated source is only added once
+    {
+        if (node_marks[position] & reached)
+            continue;
+        node_marks[position] = (uint8_t)(node_marks[position] | reached);
+        previous_nodes[position] = no_path;
+        queue.push_back(position);
+        this->statistics.count_push(queue.size());
+    }
 
-    current_position = race_maze.start_position; // starting at the start node
+    // the queue is never popped from the front, the search just walks along it so the visit order is kept
+    for (size_t front = 0; front < queue.size(); front++)
+    {
+        this->nodes_explored++;
+        this->current_position = queue[front];
+        this->statistics.count_pop();
+        this->trace.record(this->current_position, queue.size() - front - 1);
 
-    // Performing Dijkstra algorithm
-    while (queue_counter != 0)
+        if (node_marks[this->current_position] & target) // the first target reached is the nearest to any source
+        {
+            this->pathfinding_completed = true;
+            break;
+        }
+
+        for (index_type next_position : connected_paths[this->current_position])
+        {
+            if ((next_position == no_path) or (node_marks[next_position] & reached))
+                continue;
+            node_marks[next_position] = (uint8_t)(node_marks[next_position] | reached);
+            previous_nodes[next_position] = this->current_position;
+            queue.push_back(next_position);
+            this->statistics.count_push(queue.size() - front - 1);
+            this->statistics.count_edge_relaxed();
+        }
+    }
+
+    this->statistics.end_search();
+
+    if (!this->pathfinding_completed) // no source can reach any target
     {
-        nodes_explored++; // increment count
-        // minimum element of queue, from https://en.cppreference.com/w/cpp/algorithm/min_element
-        std::vector<uint64_t>::iterator min_iterator = std::min_element(queue.begin(), queue.end()); // iterator to min element
-        current_position = (uint64_t)std::distance(queue.begin(), min_iterator);
+        if (this->warnings)
+            std::cout << "WARNING: Path to exit was not found!";
+        if (this->compact_paths)
+            this->compact.assign(sources[0], race_maze.columns());
+        this->path.assign(this->compact_paths ? 0 : 1, sources[0]); // left empty when the path is kept compact
+        return this->path;
+    }
 
-        queue[current_position] = max_uint64; // removing element from Q
-        queue_counter--;
-        visited_nodes[current_position] = true; // marking as explored
+    found_target = (size_t)std::distance(targets.begin(), std::find(targets.begin(), targets.end(), this->current_position));
+
+    // backtracking from the target to whichever source the path grew from, every source has no previous node so none is given as the start
+    index_type source_position;
+    if (this->compact_paths) // the moves are encoded while backtracking so the positions are never stored
+    {
+        this->compact.backtrack(previous_nodes, no_path, this->current_position, race_maze.columns(), no_path);
+        source_position = this->compact.front();
+    }
+    else
+    {
+        for (index_type position = this->current_position; position != no_path; position = previous_nodes[position])
+            this->path.push_back(position);
+        std::reverse(this->path.begin(), this->path.end()); // source to target
+        source_position = this->path.front();
+    }
+    found_source = (size_t)std::distance(sources.begin(), std::find(sources.begin(), sources.end(), source_position));
+    this->statistics.end_reconstruction();
+
+    return this->path;
+}
+
+template <std::unsigned_integral index_type>
+std::vector<index_type> &NPC_Racer::low_memory_agent<index_type>::pathfind(const NPC_Racer::maze<index_type> &race_maze, const index_type start_position, const index_type destination_position)
+{
+    // the edges of the maze, built by the first search on it
+    const std::vector<std::array<index_type, 4>> &connected_paths = race_maze.adjacency();
+
+    // Resetting class variables for new pathfinding loop
+    this->path.clear();
+    this->nodes_explored = 0;
+    this->pathfinding_completed = false;
+    peak_memory_bytes = 0;
+    frontier_search = false;
+    this->statistics.start_search();
+    this->trace.start();
+
+    if (!breadth_first_search(race_maze, start_position, destination_position)) // didn't fit, falling back to the search without per-node arrays
+    {
+        this->release_arrays(visited_words, direction_bytes); // freed so the frontier search has the whole limit
+        frontier_search = true;
+        this->path.assign(1, start_position);
+        this->pathfinding_completed = append_frontier_path(race_maze, start_position, destination_position);
+        this->current_position = this->path.back();
+    }
+
+    this->statistics.count_scratch_bytes(peak_memory_bytes);
+    this->statistics.end_search();
+
+    if (!this->pathfinding_completed) // no path, or none within the memory limit
+    {
+        if (this->warnings)
+            std::cout << "WARNING: Path to exit was not found!";
+        if (this->compact_paths)
+            this->compact.assign(start_position, race_maze.columns());
+        this->path.assign(this->compact_paths ? 0 : 1, start_position); // left empty when the path is kept compact
+        return this->path;
+    }
+
+    // backtracking by the opposite of the direction each node was reached by, up and down or left and right only differ in the lowest bit
+    auto previous_node = [&connected_paths, this](const index_type position)
+    {
+        return connected_paths[position][(size_t)(((direction_bytes[position / 4] >> (position % 4 * 2)) & 3) ^ 1)];
+    };
+
+    if (frontier_search) // the frontier search builds the path as it goes, so it's encoded once it's whole
+    {
+        if (this->compact_paths)
+        {
+            this->compact.assign(this->path, race_maze.columns());
+            this->path.clear();
+        }
+    }
+    else if (this->compact_paths) // the moves are encoded while backtracking so the positions are never stored
+        this->compact.backtrack(previous_node, start_position, destination_position, race_maze.columns(), NPC_Racer::maze<index_type>::no_path);
+    else
+    {
+        for (index_type position = destination_position; position != start_position; position = previous_node(position))
+            this->path.push_back(position);
+        this->path.push_back(start_position);
+        std::reverse(this->path.begin(), this->path.end()); // start to destination
+    }
+    this->statistics.end_reconstruction();
+
+    return this->path;
+}
+
+template <std::unsigned_integral index_type>
+bool NPC_Racer::low_memory_agent<index_type>::breadth_first_search(const NPC_Racer::maze<index_type> &race_maze, const index_type start_position, const index_type destination_position)
+{
+    const std::vector<std::array<index_type, 4>> &connected_paths = race_maze.adjacency();
+    constexpr index_type no_path = NPC_Racer::maze<index_type>::no_path; // marks no connected path
+    const size_t elements = race_maze.character_maze.size();
+    scratch_vector<index_type> &current_layer = frontier_layers[0][1];
+    scratch_vector<index_type> &next_layer = frontier_layers[0][2];
+
+    // layers left over from an earlier search are freed rather than counted against this one
+    for (std::array<scratch_vector<index_type>, 3> &layers : frontier_layers)
+        for (scratch_vector<index_type> &layer : layers)
+            this->release_arrays(layer);
+
+    // the packed arrays are the part that scales with the maze, they have to fit before anything else
+    if ((elements + 63) / 64 * sizeof(uint64_t) + (elements + 3) / 4 > memory_limit)
+        return false;
+    visited_words.assign((elements + 63) / 64, 0);
+    direction_bytes.resize((elements + 3) / 4); // directions are only read where a node has been reached
+    if (visited_words.capacity() * sizeof(uint64_t) + direction_bytes.capacity() > memory_limit) // left bigger by a bigger maze
+    {
+        visited_words.shrink_to_fit();
+        direction_bytes.shrink_to_fit();
+    }
+    const size_t packed_bytes = visited_words.capacity() * sizeof(uint64_t) + direction_bytes.capacity();
+    peak_memory_bytes = packed_bytes;
+
+    visited_words[start_position / 64] |= (uint64_t)1 << (start_position % 64);
+    if (!grow_within_limit(current_layer, packed_bytes))
+        return false;
+    current_layer.push_back(start_position);
+    this->statistics.count_push(1);
+
+    // one layer at a time, every node of a layer is the same distance from the start
+    while (!current_layer.empty())
+    {
+        for (size_t i = 0; i < current_layer.size(); i++)
+        {
+            this->nodes_explored++;
+            this->current_position = current_layer[i];
+            this->statistics.count_pop();
+            this->trace.record(this->current_position, current_layer.size() - i - 1 + next_layer.size());
+
+            if (this->current_position == destination_position)
+            {
+                this->pathfinding_completed = true;
+                return true;
+            }
+
+            for (uint8_t direction = 0; direction < 4; direction++)
+            {
+                const index_type next_position = connected_paths[this->current_position][direction];
+                if ((next_position == no_path) or ((visited_words[next_position / 64] >> (next_position % 64)) & 1))
+                    continue;
+                visited_words[next_position / 64] |= (uint64_t)1 << (next_position % 64);
+                uint8_t &direction_byte = direction_bytes[next_position / 4];
+                const unsigned shift = next_position % 4 * 2;
+                direction_byte = (uint8_t)((direction_byte & ~(3u << shift)) | (unsigned)direction << shift);
+                if ((next_layer.size() == next_layer.capacity()) and !grow_within_limit(next_layer, packed_bytes + current_layer.capacity() * sizeof(index_type)))
+                    return false;
+                next_layer.push_back(next_position);
+                this->statistics.count_push(current_layer.size() - i - 1 + next_layer.size());
+                this->statistics.count_edge_relaxed();
+            }
+        }
+        current_layer.swap(next_layer); // swapping keeps both capacities
+        next_layer.clear();
+    }
+
+    return true; // searched everything reachable without finding the destination
+}
+
+template <std::unsigned_integral index_type>
+bool NPC_Racer::low_memory_agent<index_type>::append_frontier_path(const NPC_Racer::maze<index_type> &race_maze, const index_type from_position, const index_type to_position)
+{
+    if (from_position == to_position)
+        return true;
+
+    index_type middle_position = from_position;
+    size_t distance = no_distance;
+    if (!meet_in_middle(race_maze, from_position, to_position, middle_position, distance) or (distance == no_distance))
+        return false;
+    if (distance == 1) // neighbours, nothing in between
+    {
+        this->path.push_back(to_position);
+        return true;
+    }
+
+    // the middle is strictly between the two once they are 2 or more apart, so each half is shorter and the recursion is about log2(distance) deep
+    return append_frontier_path(race_maze, from_position, middle_position) and append_frontier_path(race_maze, middle_position, to_position);
+}
+
+template <std::unsigned_integral index_type>
+bool NPC_Racer::low_memory_agent<index_type>::meet_in_middle(const NPC_Racer::maze<index_type> &race_maze, const index_type from_position, const index_type to_position, index_type &middle_position, size_t &distance)
+{
+    const std::vector<std::array<index_type, 4>> &connected_paths = race_maze.adjacency();
+    constexpr index_type no_path = NPC_Racer::maze<index_type>::no_path; // marks no connected path
+    std::array<size_t, 2> depths = {0, 0};                                 // the distance of each end's current layer from that end
+    const std::array<index_type, 2> ends = {from_position, to_position};
+
+    for (size_t side = 0; side < 2; side++)
+    {
+        for (scratch_vector<index_type> &layer : frontier_layers[side])
+            layer.clear();
+        scratch_vector<index_type> &current_layer = frontier_layers[side][1];
+        if ((current_layer.capacity() == 0) and !grow_within_limit(current_layer, frontier_bytes()))
+            return false;
+        current_layer.push_back(ends[side]);
+    }
+    peak_memory_bytes = std::max(peak_memory_bytes, frontier_bytes());
+
+    // the ends take turns growing a layer so they meet near the middle, checking each new node against the other end's current layer
+    for (size_t round = 0;; round++)
+    {
+        const size_t side = round % 2;
+        scratch_vector<index_type> &previous_layer = frontier_layers[side][0];
+        scratch_vector<index_type> &current_layer = frontier_layers[side][1];
+        scratch_vector<index_type> &next_layer = frontier_layers[side][2];
+        const scratch_vector<index_type> &other_layer = frontier_layers[1 - side][1];
+        if (current_layer.empty()) // this end's whole area was searched without meeting the other
+        {
+            distance = no_distance;
+            return true;
+        }
+
+        for (size_t i = 0; i < current_layer.size(); i++)
+        {
+            this->nodes_explored++;
+            this->current_position = current_layer[i];
+            this->statistics.count_pop();
+            this->trace.record(this->current_position, current_layer.size() - i - 1 + next_layer.size());
+
+            for (index_type next_position : connected_paths[this->current_position])
+            {
+                if ((next_position == no_path) or std::binary_search(previous_layer.begin(), previous_layer.end(), next_position) or std::binary_search(current_layer.begin(), current_layer.end(), next_position))
+                    continue;
+                if (std::binary_search(other_layer.begin(), other_layer.end(), next_position)) // every layer before didn't meet, so this is a shortest path
+                {
+                    middle_position = next_position;
+                    distance = depths[side] + 1 + depths[1 - side];
+                    return true;
+                }
+                if ((next_layer.size() == next_layer.capacity()) and !grow_within_limit(next_layer, frontier_bytes() - next_layer.capacity() * sizeof(index_type)))
+                    return false;
+                next_layer.push_back(next_position);
+                this->statistics.count_push(current_layer.size() - i - 1 + next_layer.size());
+                this->statistics.count_edge_relaxed();
+            }
+        }
+
+        // a node reached from two nodes of the layer is kept once, and sorted for the lookups of the next round
+        std::sort(next_layer.begin(), next_layer.end());
+        next_layer.erase(std::unique(next_layer.begin(), next_layer.end()), next_layer.end());
+        previous_layer.swap(current_layer); // rotating the layers keeps their capacities
+        current_layer.swap(next_layer);
+        next_layer.clear();
+        depths[side]++;
+    }
+}
+
+template <std::unsigned_integral index_type>
+template <typename element_type>
+bool NPC_Racer::low_memory_agent<index_type>::grow_within_limit(scratch_vector<element_type> &scratch, const size_t other_bytes)
+{
+    const size_t available = (memory_limit > other_bytes) ? (memory_limit - other_bytes) / sizeof(element_type) : 0;
+    const size_t capacity = std::min(std::max<size_t>(scratch.capacity() * 2, 8), available); // the last growth takes whatever is left
+    if (capacity <= scratch.capacity())
+        return false;
+    scratch.reserve(capacity);
+    peak_memory_bytes = std::max(peak_memory_bytes, other_bytes + scratch.capacity() * sizeof(element_type));
+    return true;
+}
+
+template <std::unsigned_integral index_type>
+size_t NPC_Racer::low_memory_agent<index_type>::frontier_bytes() const
+{
+    size_t bytes = 0;
+    for (const std::array<scratch_vector<index_type>, 3> &layers : frontier_layers)
+        for (const scratch_vector<index_type> &layer : layers)
+            bytes += layer.capacity() * sizeof(index_type);
+    return bytes;
+}
+
+template <size_t row_count, size_t column_count>
+constexpr const typename NPC_Racer::static_depth_first_agent<row_count, column_count>::path_type &NPC_Racer::static_depth_first_agent<row_count, column_count>::pathfind(const maze_type &race_maze)
+{
+    constexpr size_t element_count = maze_type::element_count;
+    constexpr index_type no_path = maze_type::no_path;
+    constexpr size_t stack_capacity = element_count * 4 + 1; // every element expanded once and pushes up to 4
+
+    // variables needed for pathfinding, all on the stack
+    std::array<index_type, element_count> previous_nodes = {}; // map containing indicies of previous nodes
+    std::array<bool, element_count> visited_nodes = {};        // bitmap of visited nodes
+    std::array<index_type, stack_capacity> path_stack = {};    // stack of indicies to explore
+    size_t stack_size = 0;                                     // number of indicies on the stack
+    index_type previous_position;                              // index of the previous position to back-track and record the path
+
+    // Resetting class variables for new pathfinding loop
+    path.clear();
+    nodes_explored = 0;
+    pathfinding_completed = false;
+    statistics.start_search();
+    statistics.count_scratch_bytes(sizeof(previous_nodes) + sizeof(visited_nodes) + sizeof(path_stack));
+
+    previous_nodes.fill(no_path);
+    path_stack[stack_size++] = race_maze.start_position;
+    statistics.count_push(stack_size);
+
+    while (stack_size != 0)
+    {
+        current_position = path_stack[--stack_size]; // pop the back of the stack
+        statistics.count_pop();
+        if (visited_nodes[current_position]) // already expanded from another branch
+            continue;
+        nodes_explored++;
 
         if (current_position == race_maze.destination_position) // guard for when made it to the end
         {
@@ -265,57 +2085,148 @@ std::deque<uint64_t> &NPC_Racer::dijkstra_agent::pathfind(const NPC_Racer::maze
             break;
         }
 
-        // remember the 4 directions in the inner array of connected_paths:
+        visited_nodes[current_position] = true; // marking node as visited
+
         // 0  1    2    3
         // up down left right
-        for (size_t i = 0; i < number_directions; i++) // checking all the edges at the node
+        for (size_t i = 0; i < 4; i++)
         {
-
-            if (race_maze.connected_paths[current_position][i] != -1) // if edge not empty
+            index_type next_position = race_maze.connected_paths[current_position][i];
+            if ((next_position != no_path) and !visited_nodes[next_position])
             {
-                // next position is in that direction
-                next_position = (uint64_t)race_maze.connected_paths[current_position][i];
-                if (queue[next_position] != max_uint64) // if still in queue
-                {
-                    distance_through_current = node_distances[current_position] + 1; // the distance of the neighbour from source through current node (all weights are 1 for grid)
-                    if (distance_through_current < node_distances[next_position])    // if new distance less than old one
-                    {
-                        node_distances[next_position] = distance_through_current; // update distance
-                        queue[next_position] = distance_through_current;          // update distance in queue
-                        // adds current position to previous position tracker to know where we came from
-                        previous_nodes[next_position] = (int64_t)current_position;
-                    }
-                }
+                path_stack[stack_size++] = next_position;
+                previous_nodes[next_position] = current_position;
+                statistics.count_push(stack_size);
+                statistics.count_edge_relaxed();
             }
         }
     }
+    statistics.end_search();
 
-    if (current_position != race_maze.destination_position) // if for some reason didn't end on the destination
+    if (!pathfinding_completed) // no warning printed so it can run in a constant expression
     {
-        // for now a warning will just throw and we'll return a size 1 path (which means no path found)
-        std::cout << "WARNING: Path to exit was not found!";
-        path = {race_maze.start_position};
+        path.push_back(race_maze.start_position);
         return path;
     }
 
-    previous_position = (int64_t)current_position; // setting to end position to backtrack
+    // backtracking from the end position then reversing because a static path can only be added to the back
+    previous_position = current_position;
+    while (previous_position != no_path)
+    {
+        path.push_back(previous_position);
+        if (previous_position == race_maze.start_position)
+            break;
+        previous_position = previous_nodes[previous_position];
+    }
+    std::reverse(path.positions.begin(), path.positions.begin() + (std::ptrdiff_t)path.size());
+    statistics.end_reconstruction();
+
+    return path;
+}
+
+template <size_t row_count, size_t column_count>
+constexpr const typename NPC_Racer::static_dijkstra_agent<row_count, column_count>::path_type &NPC_Racer::static_dijkstra_agent<row_count, column_count>::pathfind(const maze_type &race_maze)
+{
+    constexpr size_t element_count = maze_type::element_count;
+    constexpr index_type no_path = maze_type::no_path;
+    constexpr index_type max_index = std::numeric_limits<index_type>::max();     // infinite distance or an empty element in the queue
+    constexpr index_type max_index_minus_one = (index_type)(max_index - 1);      // infinite distance in the queue
+
+    // variables needed for pathfinding, all on the stack
+    std::array<index_type, element_count> node_distances = {}; // distances from the source to each node
+    std::array<index_type, element_count> queue = {};          // distance of nodes in Q, max_index is not in Q
+    std::array<index_type, element_count> previous_nodes = {}; // map containing indicies of previous nodes
+    size_t queue_counter = element_count;                      // tracks non-infinite elements in queue, if is 0 it's empty
+    index_type previous_position;                              // index of the previous position to back-track and record the path
+    size_t frontier_size = 1;                                  // elements in the queue with a finite distance, only used for statistics
+
+    // Resetting class variables for new pathfinding loop
+    path.clear();
+    nodes_explored = 0;
+    pathfinding_completed = false;
+    statistics.start_search();
+    statistics.count_scratch_bytes(sizeof(node_distances) + sizeof(queue) + sizeof(previous_nodes));
+    statistics.count_push(frontier_size);
+
+    node_distances.fill(max_index);
+    queue.fill(max_index_minus_one);
+    previous_nodes.fill(no_path);
+    node_distances[race_maze.start_position] = 0;
+    queue[race_maze.start_position] = 0;
+
+    current_position = race_maze.start_position;
+
+    while (queue_counter != 0)
+    {
+        nodes_explored++;
+        current_position = (index_type)std::distance(queue.begin(), std::min_element(queue.begin(), queue.end()));
+        queue[current_position] = max_index; // removing element from Q
+        queue_counter--;
+        frontier_size -= (frontier_size > 0);
+        statistics.count_pop();
+
+        if (current_position == race_maze.destination_position) // guard for when made it to the end
+        {
+            pathfinding_completed = true;
+            break;
+        }
+
+        for (size_t i = 0; i < 4; i++)
+        {
+            index_type next_position = race_maze.connected_paths[current_position][i];
+            if ((next_position != no_path) and (queue[next_position] != max_index))
+            {
+                index_type distance_through_current = (index_type)(node_distances[current_position] + 1);
+                if (distance_through_current < node_distances[next_position])
+                {
+                    if (node_distances[next_position] == max_index) // first time reached so joins the frontier
+                        statistics.count_push(++frontier_size);
+                    else
+                        statistics.count_decrease_key();
+                    statistics.count_edge_relaxed();
+                    node_distances[next_position] = distance_through_current;
+                    queue[next_position] = distance_through_current;
+                    previous_nodes[next_position] = current_position;
+                }
+            }
+        }
+    }
+
+    statistics.end_search();
 
-    if ((previous_nodes[(uint64_t)previous_position] == -1) or ((uint64_t)previous_position == race_maze.start_position)) // guard for if vertex is non-reachable (no exit from start or end position)
+    // guard for if the destination was never reached or is non-reachable
+    if (!pathfinding_completed or (previous_nodes[current_position] == no_path))
     {
-        // for now a warning will just throw and we'll return a size 1 path (which means no path found)
-        std::cout << "WARNING: End Vertex is non-reachable";
-        path = {race_maze.start_position};
+        path.push_back(race_maze.start_position);
         return path;
     }
 
-    // backtracking from the end position to generate the path
-    while (previous_position != -1) // while not at an empty previous path i.e. still backtracking
+    previous_position = current_position;
+    while (previous_position != no_path)
     {
-        path.push_front((uint64_t)previous_position);                // adding node to the path
-        if ((uint64_t)previous_position == race_maze.start_position) // if reached the start then end
+        path.push_back(previous_position);
+        if (previous_position == race_maze.start_position)
             break;
-        previous_position = previous_nodes[(size_t)previous_position]; // backtracking
+        previous_position = previous_nodes[previous_position];
     }
+    std::reverse(path.positions.begin(), path.positions.begin() + (std::ptrdiff_t)path.size());
+    statistics.end_reconstruction();
+
+    return path;
+}
 
-    return path; // returns the path
+//// External Overloaded Operators ////
+
+std::ostream &NPC_Racer::operator<<(std::ostream &out, [[maybe_unused]] const search_statistics &statistics)
+{
+#if defined(NPC_RACER_SEARCH_STATISTICS)
+    out << "Edges relaxed: " << statistics.edges_relaxed << "\n"
+        << "Frontier pushes/pops: " << statistics.frontier_pushes << " / " << statistics.frontier_pops << "\n"
+        << "Peak frontier size: " << statistics.peak_frontier_size << "\n"
+        << "Decrease-key count: " << statistics.decrease_keys << "\n"
+        << "Scratch bytes: " << statistics.scratch_bytes << "\n"
+        << "Search time: " << statistics.search_time << " seconds\n"
+        << "Path reconstruction time: " << statistics.reconstruction_time << " seconds\n";
+#endif
+    return out;
 }
\ No newline at end of file
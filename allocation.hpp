@@ -0,0 +1,292 @@
+/**
+ * @file allocation.hpp
+ * @author Brendan Fallon (fallonbr@mcmaster.ca) (https://github.com/bren007pie)
+ * @brief This module contains the heap allocation counters and the scratch arena agents can allocate their scratch arrays from.
+ * @version 1.0
+ * @date Sunday October 18, 2026
+ * @copyright Copyright (c) 2022 Brendan Fallon
+ */
+
+//// Preprocessor Directives ////
+#pragma once
+#include <memory_resource> // std::pmr::memory_resource, std::pmr::monotonic_buffer_resource, std::pmr::new_delete_resource
+#include <optional>        // std::optional
+#include <vector>          // std::vector
+#include <cstddef>         // std::byte, std::max_align_t
+#include <cstdint>         // uint64_t, uintptr_t
+#include <algorithm>       // std::max
+#include <cstdlib>         // std::malloc, std::free
+#include <new>             // std::bad_alloc, std::align_val_t
+
+// Allocation counting is off by default since it replaces the global operator new, compile with -DNPC_RACER_ALLOCATION_COUNTING to turn it on
+
+////// ========= //////
+////// Interface //////
+////// ========= //////
+
+namespace NPC_Racer
+{
+    //// ------------------------ ////
+    //// Allocation Counts Struct ////
+    //// ------------------------ ////
+    /**
+     * @brief Counts of the heap allocations made through operator new.
+     */
+    struct allocation_counts
+    {
+        /**
+         * @param enabled True when the counting operator new is compiled in, use with `if constexpr` to skip printing the counts.
+         */
+#if defined(NPC_RACER_ALLOCATION_COUNTING)
+        static constexpr bool enabled = true;
+#else
+        static constexpr bool enabled = false;
+#endif
+
+        /**
+         * @param allocations The number of allocations.
+         */
+        uint64_t allocations = 0;
+
+        /**
+         * @param bytes The number of bytes allocated, not counting what was freed.
+         */
+        uint64_t bytes = 0;
+    };
+
+    //// --------- ////
+    //// Functions ////
+    //// --------- ////
+    /**
+     * @brief Gets the heap allocations made on the calling thread so far.
+     *
+     * @return The counts, kept per thread so races on other threads don't mix in. All zero unless compiled with NPC_RACER_ALLOCATION_COUNTING.
+     */
+    allocation_counts thread_allocation_counts();
+
+    //// ------------------- ////
+    //// Scratch Arena Class ////
+    //// ------------------- ////
+    /**
+     * @brief A monotonic memory resource that is reset between searches and keeps its memory, so an agent's scratch arrays
+     *      can be rebuilt for every search without touching the heap.
+     *
+     * @result Allocations are bumped along one buffer by a std::pmr::monotonic_buffer_resource and deallocation does nothing.
+     *      A search that outgrows the buffer continues on the heap, and the next reset grows the buffer to fit it.
+     * @note Everything allocated from the arena must be freed before reset, e.g. with the agent's release_scratch.
+     */
+    class scratch_arena : public std::pmr::memory_resource
+    {
+    public:
+        /**
+         * @brief Constructs an empty arena, its buffer is sized by the first search to use it.
+         */
+        scratch_arena();
+
+        scratch_arena(const scratch_arena &) = delete;
+        scratch_arena &operator=(const scratch_arena &) = delete;
+
+        /**
+         * @brief Makes all of the arena free again for the next search.
+         *
+         * @result If the last search outgrew the buffer, the buffer is replaced by one that fits everything it asked for.
+         */
+        void reset();
+
+        /**
+         * @brief Gets the size of the arena's buffer.
+         *
+         * @return The buffer size in bytes.
+         */
+        size_t capacity() const;
+
+        /**
+         * @brief Gets the memory asked of the arena since it was last reset.
+         *
+         * @return The bytes asked for, with room for their alignment.
+         */
+        size_t requested_bytes() const;
+
+    private:
+        //// Private Member Functions ////
+        /**
+         * @brief Allocates from the buffer, or the heap once the buffer is used up.
+         */
+        void *do_allocate(size_t bytes, size_t alignment) override;
+
+        /**
+         * @brief Does nothing, the memory is only made free again by reset.
+         */
+        void do_deallocate(void *memory, size_t bytes, size_t alignment) override;
+
+        /**
+         * @brief Only the same arena can free what it allocated.
+         */
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+        //// Data Members ////
+        /**
+         * @param buffer The memory the arena hands out.
+         */
+        std::vector<std::byte> buffer;
+
+        /**
+         * @param monotonic The resource bumping along the buffer, remade when the buffer grows.
+         */
+        std::optional<std::pmr::monotonic_buffer_resource> monotonic;
+
+        /**
+         * @param requested The bytes asked for since the last reset, with room for their alignment.
+         */
+        size_t requested = 0;
+    };
+}
+
+////// ============== //////
+////// Implementation //////
+////// ============== //////
+
+#if defined(NPC_RACER_ALLOCATION_COUNTING)
+namespace NPC_Racer
+{
+    /**
+     * @param thread_allocations The allocations made on this thread, counted by the replaced operator new.
+     */
+    thread_local allocation_counts thread_allocations;
+}
+
+// the replacement global allocation functions, every new and delete in the program goes through these
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete" // GCC sees free paired with new once they're inlined, these are the pair
+#endif
+void *operator new(size_t bytes)
+{
+    NPC_Racer::thread_allocations.allocations++;
+    NPC_Racer::thread_allocations.bytes += bytes;
+    if (void *memory = std::malloc((bytes == 0) ? 1 : bytes))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void *operator new[](size_t bytes)
+{
+    return ::operator new(bytes);
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+// over-aligned allocations, e.g. every allocation of std::pmr::new_delete_resource, keep the pointer malloc gave just before the aligned memory
+void *operator new(size_t bytes, std::align_val_t alignment)
+{
+    NPC_Racer::thread_allocations.allocations++;
+    NPC_Racer::thread_allocations.bytes += bytes;
+    size_t align = std::max((size_t)alignment, sizeof(void *));
+    void *memory = std::malloc(bytes + align + sizeof(void *));
+    if (memory == nullptr)
+        throw std::bad_alloc();
+    uintptr_t aligned = ((uintptr_t)memory + sizeof(void *) + align - 1) & ~(uintptr_t)(align - 1);
+    ((void **)aligned)[-1] = memory;
+    return (void *)aligned;
+}
+
+void *operator new[](size_t bytes, std::align_val_t alignment)
+{
+    return ::operator new(bytes, alignment);
+}
+
+void operator delete(void *memory, std::align_val_t) noexcept
+{
+    if (memory != nullptr)
+        std::free(((void **)memory)[-1]);
+}
+
+void operator delete[](void *memory, std::align_val_t alignment) noexcept
+{
+    ::operator delete(memory, alignment);
+}
+
+void operator delete(void *memory, size_t, std::align_val_t alignment) noexcept
+{
+    ::operator delete(memory, alignment);
+}
+
+void operator delete[](void *memory, size_t, std::align_val_t alignment) noexcept
+{
+    ::operator delete(memory, alignment);
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+NPC_Racer::allocation_counts NPC_Racer::thread_allocation_counts()
+{
+#if defined(NPC_RACER_ALLOCATION_COUNTING)
+    return thread_allocations;
+#else
+    return allocation_counts();
+#endif
+}
+
+NPC_Racer::scratch_arena::scratch_arena()
+{
+    monotonic.emplace(std::pmr::new_delete_resource()); // no buffer yet, so the first search goes to the heap and sizes it
+}
+
+void NPC_Racer::scratch_arena::reset()
+{
+    if (requested > buffer.size()) // outgrown, a buffer with room for all of it so the next search doesn't need the heap
+    {
+        monotonic.reset(); // gives back what overflowed to the heap
+        buffer = std::vector<std::byte>(requested);
+        monotonic.emplace(buffer.data(), buffer.size(), std::pmr::new_delete_resource());
+    }
+    else
+        monotonic->release(); // back to the start of the buffer
+    requested = 0;
+}
+
+size_t NPC_Racer::scratch_arena::capacity() const
+{
+    return buffer.size();
+}
+
+size_t NPC_Racer::scratch_arena::requested_bytes() const
+{
+    return requested;
+}
+
+void *NPC_Racer::scratch_arena::do_allocate(size_t bytes, size_t alignment)
+{
+    requested += bytes + alignment - 1; // the most the alignment can pad it by
+    return monotonic->allocate(bytes, alignment);
+}
+
+void NPC_Racer::scratch_arena::do_deallocate(void *, size_t, size_t)
+{
+    // monotonic, freed all at once by reset
+}
+
+bool NPC_Racer::scratch_arena::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+{
+    return this == &other;
+}
@@ -0,0 +1,662 @@
+/**
+ * @file async_paths.hpp
+ * @author Brendan Fallon (fallonbr@mcmaster.ca) (https://github.com/bren007pie)
+ * @brief This module contains asynchronous path requests: a work-stealing thread pool, path futures that coroutines can co_await, and a load test of many outstanding requests.
+ * @version 1.0
+ * @date Sunday October 18, 2026
+ * @copyright Copyright (c) 2022 Brendan Fallon
+ */
+
+//// Preprocessor Directives ////
+#pragma once
+#include <iostream>           // std::cout
+#include <vector>             // std::vector
+#include <deque>              // std::deque
+#include <memory>             // std::unique_ptr, std::shared_ptr, std::make_shared
+#include <functional>         // std::function
+#include <thread>             // std::thread
+#include <mutex>              // std::mutex, std::lock_guard, std::unique_lock
+#include <condition_variable> // std::condition_variable
+#include <atomic>             // std::atomic
+#include <coroutine>          // std::coroutine_handle, std::suspend_never
+#include <chrono>             // std::chrono::steady_clock
+#include <random>             // std::mt19937_64
+#include <utility>            // std::pair, std::move
+#include <exception>          // std::terminate
+#include <cstdint>            // uint64_t
+#include <concepts>           // std::unsigned_integral
+#include "mazes.hpp"          // NPC_Racer::maze
+#include "agents.hpp"         // NPC_Racer::race_agents, NPC_Racer::for_each_agent
+#include "race_runner.hpp"    // NPC_Racer::pin_current_thread
+
+////// ========= //////
+////// Interface //////
+////// ========= //////
+
+namespace NPC_Racer
+{
+    //// ------- ////
+    //// Structs ////
+    //// ------- ////
+    /**
+     * @brief The answer to an asynchronous path request.
+     *
+     * @tparam index_type The unsigned integer type used for the maze indices.
+     */
+    template <std::unsigned_integral index_type>
+    struct path_response
+    {
+        /**
+         * @param path The path from the start to the destination, empty if there is none.
+         */
+        std::vector<index_type> path;
+
+        /**
+         * @param nodes_explored The nodes the agent explored to answer.
+         */
+        uint64_t nodes_explored = 0;
+
+        /**
+         * @param worker The pool worker that answered.
+         */
+        size_t worker = 0;
+    };
+
+    /**
+     * @brief Throughput and latency of a load test of asynchronous path requests.
+     */
+    struct async_load_result
+    {
+        /**
+         * @param requests The number of requests, all outstanding at once.
+         */
+        size_t requests = 0;
+
+        /**
+         * @param seconds The time from the first request to the last answer.
+         */
+        double seconds = 0;
+
+        /**
+         * @param latencies The time in seconds from each request to its coroutine resuming.
+         */
+        std::vector<double> latencies;
+
+        /**
+         * @param steals The number of requests a worker took from another worker's queue.
+         */
+        uint64_t steals = 0;
+    };
+
+    //// ------------------------ ////
+    //// Work-stealing Pool Class ////
+    //// ------------------------ ////
+    /**
+     * @brief A thread pool where each worker has its own queue of tasks and takes tasks from the others when it runs out.
+     *
+     * @note Workers run their own newest task first, which is still in their cache, and steal the oldest task of another
+     *      worker. Tasks are given the index of the worker running them so they can use per-worker state without locks.
+     */
+    class work_stealing_pool
+    {
+    public:
+        /**
+         * @brief Starts the worker threads.
+         *
+         * @param worker_count The number of workers, 0 for one per hardware thread.
+         * @param pin_cores If true worker i is pinned to core i.
+         */
+        explicit work_stealing_pool(const size_t worker_count = 0, const bool pin_cores = false);
+
+        /**
+         * @brief Runs the tasks left in the queues then stops the workers.
+         */
+        ~work_stealing_pool();
+
+        work_stealing_pool(const work_stealing_pool &) = delete;
+        work_stealing_pool &operator=(const work_stealing_pool &) = delete;
+
+        /**
+         * @brief Queues a task to run on a worker.
+         *
+         * @param task The task, given the index of the worker running it.
+         *
+         * @result A task submitted by a worker goes on its own queue, other tasks are spread across the queues in turn.
+         */
+        void submit(std::function<void(size_t)> task);
+
+        /**
+         * @brief Waits until every task submitted so far, and every task they submitted, has finished running.
+         *
+         * @note Only meant for when no other thread is submitting, otherwise it may wait for their tasks too.
+         */
+        void wait_idle();
+
+        /**
+         * @brief Returns the number of workers.
+         */
+        size_t size() const;
+
+        /**
+         * @brief Returns the number of tasks taken from another worker's queue so far.
+         */
+        uint64_t steals() const;
+
+    private:
+        /**
+         * @brief One worker's queue of tasks.
+         */
+        struct task_queue
+        {
+            std::mutex mutex;
+            std::deque<std::function<void(size_t)>> tasks;
+        };
+
+        /**
+         * @param queues One queue per worker, pointers so the mutexes never move.
+         */
+        std::vector<std::unique_ptr<task_queue>> queues;
+
+        /**
+         * @param workers The worker threads.
+         */
+        std::vector<std::thread> workers;
+
+        /**
+         * @param queued_tasks Tasks submitted and not yet taken, workers sleep while it's 0.
+         */
+        std::atomic<size_t> queued_tasks = 0;
+
+        /**
+         * @param unfinished_tasks Tasks submitted and not yet finished running, waited on by wait_idle.
+         */
+        std::atomic<size_t> unfinished_tasks = 0;
+
+        /**
+         * @param next_queue The queue the next task from outside the pool goes on.
+         */
+        std::atomic<size_t> next_queue = 0;
+
+        /**
+         * @param stolen_tasks The number of tasks taken from another worker's queue.
+         */
+        std::atomic<uint64_t> stolen_tasks = 0;
+
+        /**
+         * @param sleep_mutex Guards stopping and the workers going to sleep.
+         */
+        std::mutex sleep_mutex;
+
+        /**
+         * @param wake Wakes sleeping workers when a task is submitted or the pool stops.
+         */
+        std::condition_variable wake;
+
+        /**
+         * @param stopping True once the pool is being destroyed.
+         */
+        bool stopping = false;
+
+        /**
+         * @brief The loop each worker runs until the pool stops.
+         */
+        void worker_loop(const size_t worker, const bool pin_cores);
+
+        /**
+         * @brief Takes a task from the worker's own queue, or steals one from another. Returns false if every queue is empty.
+         */
+        bool take_task(const size_t worker, std::function<void(size_t)> &task);
+    };
+
+    //// ----------------------- ////
+    //// Path Request Structures ////
+    //// ----------------------- ////
+    /**
+     * @brief The state shared between a path request being answered and its future.
+     *
+     * @tparam index_type The unsigned integer type used for the maze indices.
+     */
+    template <std::unsigned_integral index_type>
+    struct path_request_state
+    {
+        /**
+         * @param response The answer, only read once ready.
+         */
+        path_response<index_type> response;
+
+        /**
+         * @param stage pending, awaited once a coroutine is waiting on it, or answered.
+         */
+        std::atomic<int> stage = 0;
+
+        /**
+         * @param waiter The coroutine to resume once answered.
+         */
+        std::coroutine_handle<> waiter;
+
+        // the stages of a request
+        static constexpr int pending = 0;  // not answered and not awaited
+        static constexpr int awaited = 1;  // a coroutine is suspended waiting for the answer
+        static constexpr int answered = 2; // the response is ready
+    };
+
+    /**
+     * @brief The future answer to a path request, which a coroutine can `co_await` or any thread can wait on with get().
+     *
+     * @tparam index_type The unsigned integer type used for the maze indices.
+     * @note A coroutine that awaits a request that isn't answered yet is resumed on the pool worker that answers it.
+     */
+    template <std::unsigned_integral index_type>
+    class path_future
+    {
+    public:
+        /**
+         * @brief Wraps the shared state of a request, made by async_pathfinder::find_path.
+         */
+        explicit path_future(std::shared_ptr<path_request_state<index_type>> request_state);
+
+        /**
+         * @brief Returns if the request is answered, so get() won't wait.
+         */
+        bool ready() const;
+
+        /**
+         * @brief Waits for the answer without a coroutine.
+         *
+         * @return The answer.
+         */
+        const path_response<index_type> &get() const;
+
+        //// Awaitable Member Functions ////
+        // these make `co_await future` suspend the coroutine until the request is answered
+
+        bool await_ready() const;
+        bool await_suspend(std::coroutine_handle<> coroutine);
+        const path_response<index_type> &await_resume() const;
+
+    private:
+        /**
+         * @param state The shared state of the request.
+         */
+        std::shared_ptr<path_request_state<index_type>> state;
+    };
+
+    /**
+     * @brief A coroutine that starts right away and isn't waited on, for game logic that awaits paths and then moves on.
+     *
+     * @note The coroutine frame frees itself when the coroutine finishes.
+     */
+    struct detached_task
+    {
+        struct promise_type
+        {
+            detached_task get_return_object() { return {}; }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+    };
+
+    //// ---------------------- ////
+    //// Async Pathfinder Class ////
+    //// ---------------------- ////
+    /**
+     * @brief Answers path requests on one maze asynchronously on a work-stealing pool.
+     *
+     * @tparam index_type The unsigned integer type used for the maze indices.
+     * @note Every worker has its own workspace of race agents, reused for every request it answers, so requests never
+     *      share scratch memory and the maze is only read.
+     */
+    template <std::unsigned_integral index_type>
+    class async_pathfinder
+    {
+    public:
+        /**
+         * @brief Starts the pool for a maze.
+         *
+         * @param query_maze The maze to answer requests on, which must outlive the pathfinder and not change while it runs.
+         * @param worker_count The number of workers, 0 for one per hardware thread.
+         * @param pin_cores If true worker i is pinned to core i.
+         */
+        async_pathfinder(const maze<index_type> &query_maze, const size_t worker_count = 0, const bool pin_cores = false);
+
+        /**
+         * @brief Requests a path, which is answered on the pool.
+         *
+         * @param agent The agent to find the path with, by its place in race_agents.
+         * @param start_position The index to start from.
+         * @param destination_position The index to find a path to.
+         *
+         * @return The future answer, which can be awaited.
+         */
+        path_future<index_type> find_path(const size_t agent, const index_type start_position, const index_type destination_position);
+
+        /**
+         * @brief Waits until every request made so far is answered and the coroutines resumed by them have run.
+         */
+        void wait_idle();
+
+        /**
+         * @brief Returns the maze requests are answered on.
+         */
+        const maze<index_type> &pathfinding_maze() const;
+
+        /**
+         * @brief Returns the pool answering the requests.
+         */
+        const work_stealing_pool &pool() const;
+
+    private:
+        /**
+         * @param race_maze The maze requests are answered on.
+         */
+        const maze<index_type> &race_maze;
+
+        /**
+         * @param workspaces One set of agents per worker.
+         */
+        std::vector<race_agents::agents<index_type>> workspaces;
+
+        /**
+         * @param workers The pool, last so its threads stop before the workspaces are destroyed.
+         */
+        work_stealing_pool workers;
+    };
+
+    //// --------- ////
+    //// Functions ////
+    //// --------- ////
+    /**
+     * @brief Measures the throughput and latency of many path requests outstanding at once, each awaited by its own coroutine.
+     *
+     * @tparam index_type The unsigned integer type used for the maze indices.
+     * @param pathfinder The pathfinder to request paths from.
+     * @param agent The agent to find the paths with, by its place in race_agents.
+     * @param requests The number of requests, all made before any is waited on.
+     * @param seed The random seed for the start and destination of each request, picked from the free spaces.
+     *
+     * @return The time of the whole test and the latency of each request.
+     */
+    template <std::unsigned_integral index_type>
+    async_load_result run_async_load(async_pathfinder<index_type> &pathfinder, const size_t agent, const size_t requests, const uint64_t seed = 1);
+}
+
+////// ============== //////
+////// Implementation //////
+////// ============== //////
+
+//// ------------------ ////
+//// Work-stealing Pool ////
+//// ------------------ ////
+
+NPC_Racer::work_stealing_pool::work_stealing_pool(const size_t worker_count /* 0 */, const bool pin_cores /* false */)
+{
+    size_t worker_total = (worker_count == 0) ? std::max<size_t>(1, std::thread::hardware_concurrency()) : worker_count;
+    for (size_t worker = 0; worker < worker_total; worker++)
+        queues.push_back(std::make_unique<task_queue>());
+    workers.reserve(worker_total);
+    for (size_t worker = 0; worker < worker_total; worker++)
+        workers.emplace_back(&work_stealing_pool::worker_loop, this, worker, pin_cores);
+}
+
+NPC_Racer::work_stealing_pool::~work_stealing_pool()
+{
+    {
+        std::lock_guard<std::mutex> sleep_lock(sleep_mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &worker : workers)
+        worker.join();
+}
+
+namespace NPC_Racer
+{
+    /**
+     * @brief The pool and worker index of the calling thread, so tasks submitted by a worker go on its own queue.
+     */
+    thread_local const work_stealing_pool *current_pool = nullptr;
+    thread_local size_t current_worker = 0;
+}
+
+void NPC_Racer::work_stealing_pool::submit(std::function<void(size_t)> task)
+{
+    size_t queue = (current_pool == this) ? current_worker : (next_queue++ % queues.size());
+    unfinished_tasks.fetch_add(1, std::memory_order_relaxed); // before it can run, so the count never drops to 0 early
+    {
+        std::lock_guard<std::mutex> queue_lock(queues[queue]->mutex);
+        queues[queue]->tasks.push_back(std::move(task));
+    }
+    {
+        // taking the sleep lock so a worker can't check for tasks and go to sleep between the count and the notify
+        std::lock_guard<std::mutex> sleep_lock(sleep_mutex);
+        queued_tasks++;
+    }
+    wake.notify_one();
+}
+
+void NPC_Racer::work_stealing_pool::wait_idle()
+{
+    for (size_t unfinished = unfinished_tasks.load(std::memory_order_acquire); unfinished > 0; unfinished = unfinished_tasks.load(std::memory_order_acquire))
+        unfinished_tasks.wait(unfinished, std::memory_order_acquire);
+}
+
+size_t NPC_Racer::work_stealing_pool::size() const
+{
+    return workers.size();
+}
+
+uint64_t NPC_Racer::work_stealing_pool::steals() const
+{
+    return stolen_tasks;
+}
+
+void NPC_Racer::work_stealing_pool::worker_loop(const size_t worker, const bool pin_cores)
+{
+    if (pin_cores and !pin_current_thread(worker))
+        std::cout << "WARNING: Could not pin pool worker " << worker << " to a core.\n";
+    current_pool = this;
+    current_worker = worker;
+
+    std::function<void(size_t)> task;
+    while (true)
+    {
+        if (take_task(worker, task))
+        {
+            task(worker);
+            task = nullptr; // what it captured is freed before it counts as finished
+            if (unfinished_tasks.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                unfinished_tasks.notify_all();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> sleep_lock(sleep_mutex);
+        wake.wait(sleep_lock, [&]()
+                  { return stopping or (queued_tasks > 0); });
+        if (stopping and (queued_tasks == 0)) // finishing every queued task before stopping
+            return;
+    }
+}
+
+bool NPC_Racer::work_stealing_pool::take_task(const size_t worker, std::function<void(size_t)> &task)
+{
+    // own queue first, newest task
+    {
+        std::lock_guard<std::mutex> queue_lock(queues[worker]->mutex);
+        if (!queues[worker]->tasks.empty())
+        {
+            task = std::move(queues[worker]->tasks.back());
+            queues[worker]->tasks.pop_back();
+            queued_tasks--;
+            return true;
+        }
+    }
+
+    // then stealing the oldest task of the next worker that has one
+    for (size_t offset = 1; offset < queues.size(); offset++)
+    {
+        task_queue &victim = *queues[(worker + offset) % queues.size()];
+        std::lock_guard<std::mutex> queue_lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued_tasks--;
+            stolen_tasks++;
+            return true;
+        }
+    }
+    return false;
+}
+
+//// ----------- ////
+//// Path Future ////
+//// ----------- ////
+
+template <std::unsigned_integral index_type>
+NPC_Racer::path_future<index_type>::path_future(std::shared_ptr<path_request_state<index_type>> request_state) : state(std::move(request_state))
+{
+}
+
+template <std::unsigned_integral index_type>
+bool NPC_Racer::path_future<index_type>::ready() const
+{
+    return state->stage.load(std::memory_order_acquire) == path_request_state<index_type>::answered;
+}
+
+template <std::unsigned_integral index_type>
+const NPC_Racer::path_response<index_type> &NPC_Racer::path_future<index_type>::get() const
+{
+    for (int stage = state->stage.load(std::memory_order_acquire); stage != path_request_state<index_type>::answered; stage = state->stage.load(std::memory_order_acquire))
+        state->stage.wait(stage, std::memory_order_acquire);
+    return state->response;
+}
+
+template <std::unsigned_integral index_type>
+bool NPC_Racer::path_future<index_type>::await_ready() const
+{
+    return ready();
+}
+
+template <std::unsigned_integral index_type>
+bool NPC_Racer::path_future<index_type>::await_suspend(std::coroutine_handle<> coroutine)
+{
+    // the handle is stored before the stage changes, the worker only reads it after seeing awaited
+    state->waiter = coroutine;
+    int expected = path_request_state<index_type>::pending;
+    return state->stage.compare_exchange_strong(expected, path_request_state<index_type>::awaited, std::memory_order_acq_rel); // false if answered meanwhile, so not suspending
+}
+
+template <std::unsigned_integral index_type>
+const NPC_Racer::path_response<index_type> &NPC_Racer::path_future<index_type>::await_resume() const
+{
+    return state->response;
+}
+
+//// ---------------- ////
+//// Async Pathfinder ////
+//// ---------------- ////
+
+template <std::unsigned_integral index_type>
+NPC_Racer::async_pathfinder<index_type>::async_pathfinder(const maze<index_type> &query_maze, const size_t worker_count /* 0 */, const bool pin_cores /* false */)
+    : race_maze(query_maze),
+      workspaces((worker_count == 0) ? std::max<size_t>(1, std::thread::hardware_concurrency()) : worker_count),
+      workers(workspaces.size(), pin_cores)
+{
+    for (race_agents::agents<index_type> &workspace : workspaces)
+        for_each_agent(workspace, [](auto &agent, size_t)
+                       { agent.warnings = false; });
+}
+
+template <std::unsigned_integral index_type>
+NPC_Racer::path_future<index_type> NPC_Racer::async_pathfinder<index_type>::find_path(const size_t agent, const index_type start_position, const index_type destination_position)
+{
+    std::shared_ptr<path_request_state<index_type>> state = std::make_shared<path_request_state<index_type>>();
+    workers.submit([this, state, agent, start_position, destination_position](const size_t worker)
+                   {
+        path_response<index_type> &response = state->response;
+        response.worker = worker;
+        for_each_agent(workspaces[worker], [&](auto &racer, const size_t i)
+                       {
+            if (i != agent)
+                return;
+            const std::vector<index_type> &path = racer.pathfind(race_maze, start_position, destination_position);
+            response.nodes_explored = racer.nodes_explored;
+            if (racer.pathfinding_completed and ((path.size() > 1) or (start_position == destination_position)))
+                response.path = path; });
+
+        // resuming the waiting coroutine if there is one, otherwise it sees answered and doesn't suspend
+        int stage = state->stage.exchange(path_request_state<index_type>::answered, std::memory_order_acq_rel);
+        state->stage.notify_all();
+        if (stage == path_request_state<index_type>::awaited)
+            state->waiter.resume(); });
+    return path_future<index_type>(std::move(state));
+}
+
+template <std::unsigned_integral index_type>
+void NPC_Racer::async_pathfinder<index_type>::wait_idle()
+{
+    workers.wait_idle();
+}
+
+template <std::unsigned_integral index_type>
+const NPC_Racer::maze<index_type> &NPC_Racer::async_pathfinder<index_type>::pathfinding_maze() const
+{
+    return race_maze;
+}
+
+template <std::unsigned_integral index_type>
+const NPC_Racer::work_stealing_pool &NPC_Racer::async_pathfinder<index_type>::pool() const
+{
+    return workers;
+}
+
+//// --------- ////
+//// Load Test ////
+//// --------- ////
+
+namespace NPC_Racer
+{
+    /**
+     * @brief One outstanding request of the load test, records its latency once it resumes.
+     */
+    template <std::unsigned_integral index_type>
+    detached_task await_path_request(async_pathfinder<index_type> &pathfinder, const size_t agent, const index_type start_position,
+                                     const index_type destination_position, double &latency)
+    {
+        std::chrono::steady_clock::time_point requested = std::chrono::steady_clock::now();
+        co_await pathfinder.find_path(agent, start_position, destination_position);
+        latency = std::chrono::duration<double>(std::chrono::steady_clock::now() - requested).count();
+    }
+}
+
+template <std::unsigned_integral index_type>
+NPC_Racer::async_load_result NPC_Racer::run_async_load(async_pathfinder<index_type> &pathfinder, const size_t agent, const size_t requests, const uint64_t seed /* 1 */)
+{
+    async_load_result result;
+    result.requests = requests;
+    result.latencies.resize(requests, 0);
+    const maze<index_type> &race_maze = pathfinder.pathfinding_maze();
+
+    // picking every start and destination first so the test only times the requests
+    std::vector<index_type> free_positions;
+    for (size_t i = 0; i < race_maze.bit_maze.size(); i++)
+        if (race_maze.bit_maze[i])
+            free_positions.push_back((index_type)i);
+    std::mt19937_64 generator(seed);
+    std::vector<std::pair<index_type, index_type>> pairs(requests);
+    for (std::pair<index_type, index_type> &pair : pairs)
+        pair = {free_positions[generator() % free_positions.size()], free_positions[generator() % free_positions.size()]};
+
+    uint64_t steals_before = pathfinder.pool().steals();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < requests; i++)
+        await_path_request(pathfinder, agent, pairs[i].first, pairs[i].second, result.latencies[i]);
+    // each coroutine finishes inside the pool task that answers it, or here if answered before it awaited, so once the
+    // pool is idle every latency is written and nothing running still refers to this call
+    pathfinder.wait_idle();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.steals = pathfinder.pool().steals() - steals_before;
+    return result;
+}
@@ -0,0 +1,775 @@
+/**
+ * @file benchmark.hpp
+ * @author Brendan Fallon (fallonbr@mcmaster.ca) (https://github.com/bren007pie)
+ * @brief This module contains the benchmark options, the timed trial loop, and machine-readable result output for NPC races.
+ * @version 1.0
+ * @date Sunday October 18, 2026
+ * @copyright Copyright (c) 2022 Brendan Fallon
+ */
+
+//// Preprocessor Directives ////
+#pragma once
+#include <iostream>       // std::cout
+#include <fstream>        // std::ofstream, std::ifstream
+#include <string>         // std::string, std::stoull
+#include <vector>         // std::vector
+#include <ctime>          // std::time, std::gmtime, std::strftime
+#include <cstdio>         // std::snprintf
+#include <cstdint>        // uint64_t
+#include <limits>         // std::numeric_limits
+#include <stdexcept>      // std::out_of_range
+#include "timekeeper.hpp" // NPC_Racer::timekeeper, NPC_Racer::run_statistics, NPC_Racer::summarize_run, NPC_Racer::hardware_counter_values
+#include "agents.hpp"     // NPC_Racer::pathfinding_agent
+#include "allocation.hpp" // NPC_Racer::allocation_counts, NPC_Racer::thread_allocation_counts, NPC_Racer::scratch_arena
+
+////// ========= //////
+////// Interface //////
+////// ========= //////
+
+namespace NPC_Racer
+{
+    //// ------- ////
+    //// Structs ////
+    //// ------- ////
+    /**
+     * @brief Options for a benchmark, set from the command line arguments.
+     */
+    struct benchmark_options
+    {
+        /**
+         * @param trials The number of timed trials per run.
+         */
+        size_t trials = 11;
+
+        /**
+         * @param warmup_runs The number of untimed trials before the timed ones to warm up the caches and branch predictors.
+         */
+        size_t warmup_runs = 1;
+
+        /**
+         * @param minimum_sample_time The shortest a timed trial can be in microseconds. Trials faster than this batch
+         *      several pathfinding iterations together and record the time per iteration. 0 to never batch.
+         */
+        size_t minimum_sample_time = 100;
+
+        /**
+         * @param cycle_counter_timer If true trials are timed with the cycle counter instead of std::chrono::steady_clock.
+         */
+        bool cycle_counter_timer = false;
+
+        /**
+         * @param reject_outliers If true outlier trials are removed before taking the statistics.
+         */
+        bool reject_outliers = false;
+
+        /**
+         * @param hardware_counters If true hardware performance counters are measured for each trial.
+         */
+        bool hardware_counters = false;
+
+        /**
+         * @param csv_file The file to append the results to in CSV format. Empty for no CSV output.
+         */
+        std::string csv_file;
+
+        /**
+         * @param json_file The file to write the results to in JSON format. Empty for no JSON output.
+         */
+        std::string json_file;
+
+        /**
+         * @param jobs The number of mazes raced at the same time, 0 for one per hardware thread.
+         */
+        size_t jobs = 1;
+
+        /**
+         * @param pin_cores If true each race worker is pinned to its own core so races don't disturb each other's timings.
+         */
+        bool pin_cores = false;
+
+        /**
+         * @param head_to_head If true the agents also race at the same time on their own threads after their timed trials.
+         */
+        bool head_to_head = false;
+
+        /**
+         * @param async_requests The number of path requests made at once per agent in the async load test, 0 for no test.
+         */
+        size_t async_requests = 0;
+
+        /**
+         * @param async_workers The number of work-stealing workers answering the async requests, 0 for one per hardware thread.
+         */
+        size_t async_workers = 0;
+
+        /**
+         * @param cooperative_agents The most agents planned together in the cooperative planning test, 0 for no test.
+         */
+        size_t cooperative_agents = 0;
+
+        /**
+         * @param cooperative_window The number of ticks each agent plans ahead in the cooperative planning test.
+         */
+        size_t cooperative_window = 16;
+
+        /**
+         * @param hierarchy_queries The number of random queries timed on the maze's contraction hierarchy, 0 for no hierarchy.
+         */
+        size_t hierarchy_queries = 0;
+
+        /**
+         * @param memory_limit The most bytes of scratch memory the low-memory agent can search with.
+         */
+        size_t memory_limit = std::numeric_limits<size_t>::max();
+
+        /**
+         * @param scratch_arenas If true each raced agent makes its scratch arrays in its own scratch arena, reset before every search.
+         */
+        bool scratch_arenas = false;
+
+        /**
+         * @param cache_directory The directory parsed mazes and their precomputed structures are cached in. Empty for no cache.
+         */
+        std::string cache_directory;
+
+        /**
+         * @param suite If true the sample mazes and the generated suite mazes are raced as a regression suite.
+         */
+        bool suite = false;
+
+        /**
+         * @param save_baseline_file The file to save the results to as a baseline. Empty for no baseline.
+         */
+        std::string save_baseline_file;
+
+        /**
+         * @param compare_baseline_file The baseline file to compare the results against. Empty for no comparison.
+         */
+        std::string compare_baseline_file;
+
+        /**
+         * @param regression_threshold The smallest significant slowdown in percent counted as a regression.
+         */
+        size_t regression_threshold = 5;
+
+        /**
+         * @param trace_prefix The file name prefix to write each agent's exploration trace to. Empty for no traces.
+         */
+        std::string trace_prefix;
+
+        /**
+         * @param serve If true the mazes are kept loaded and path queries are answered over stdin instead of racing.
+         */
+        bool serve = false;
+
+        /**
+         * @param socket_file The Unix domain socket to answer path queries on instead of stdin. Empty to serve over stdin.
+         */
+        std::string socket_file;
+
+        /**
+         * @param maze_files The maze file and directory names given as arguments.
+         */
+        std::vector<std::string> maze_files;
+    };
+
+    /**
+     * @brief The result of one agent's run on one maze.
+     */
+    struct benchmark_result
+    {
+        /**
+         * @param maze_name The file name of the maze raced on.
+         */
+        std::string maze_name;
+
+        /**
+         * @param agent_name The name of the agent that raced.
+         */
+        std::string agent_name;
+
+        /**
+         * @param index_bits The width in bits of the index type used.
+         */
+        size_t index_bits = 0;
+
+        /**
+         * @param statistics The statistics of the trial times.
+         */
+        run_statistics statistics;
+
+        /**
+         * @param iterations_per_trial The number of pathfinding iterations batched in each timed trial.
+         */
+        uint64_t iterations_per_trial = 1;
+
+        /**
+         * @param counters The hardware counter values averaged per trial, unavailable if not measured.
+         */
+        hardware_counter_values counters;
+
+        /**
+         * @param path_size The size of the path found.
+         */
+        size_t path_size = 0;
+
+        /**
+         * @param nodes_explored The number of nodes explored in the last trial.
+         */
+        uint64_t nodes_explored = 0;
+
+        /**
+         * @param trial_times All of the timed trial times in seconds per iteration, before any outliers were removed.
+         */
+        std::vector<double> trial_times;
+    };
+
+    /**
+     * @brief The measurements of a run of trials of one agent on one maze.
+     */
+    struct run_measurements
+    {
+        /**
+         * @param trial_times The time in seconds of each timed trial, per iteration if trials were batched.
+         */
+        std::vector<double> trial_times;
+
+        /**
+         * @param counters The hardware counter values averaged per iteration, unavailable if not measured.
+         */
+        hardware_counter_values counters;
+
+        /**
+         * @param iterations_per_trial The number of pathfinding iterations batched in each timed trial.
+         */
+        uint64_t iterations_per_trial = 1;
+
+        /**
+         * @param cycle_counter_timed True if the trials were timed with the cycle counter.
+         */
+        bool cycle_counter_timed = false;
+
+        /**
+         * @param allocations_per_search The heap allocations per timed search, 0 unless compiled with NPC_RACER_ALLOCATION_COUNTING.
+         */
+        double allocations_per_search = 0;
+
+        /**
+         * @param allocated_bytes_per_search The bytes allocated on the heap per timed search.
+         */
+        double allocated_bytes_per_search = 0;
+
+        /**
+         * @param first_search_allocations The heap allocations of the first warmup search, for a new agent how many it takes to set up.
+         */
+        allocation_counts first_search_allocations;
+    };
+
+    //// --------- ////
+    //// Constants ////
+    //// --------- ////
+    /**
+     * @brief The most pathfinding iterations batched into one timed trial.
+     */
+    constexpr uint64_t maximum_batch_iterations = 1 << 20;
+
+    //// --------- ////
+    //// Functions ////
+    //// --------- ////
+    /**
+     * @brief Parses the command line arguments into benchmark options.
+     *
+     * @param argc The number of arguments, including the program name.
+     * @param argv The arguments.
+     *
+     * @return The benchmark options. Any argument that isn't an option is a maze file.
+     * @warning Prints an error and exits if an option is invalid.
+     */
+    benchmark_options parse_arguments(const int argc, char *argv[]);
+
+    /**
+     * @brief Prints the command line usage of the program.
+     */
+    void print_usage();
+
+    /**
+     * @brief Runs the warmup and timed trials of one agent on one maze.
+     *
+     * @tparam agent_type Any agent class that can race on the maze.
+     * @tparam maze_type The maze class the agent pathfinds on.
+     * @param agent The agent to race.
+     * @param race_maze The maze to race on.
+     * @param options The benchmark options with the number of warmup runs and trials.
+     * @param arena The scratch arena the agent was made on, reset before every search, or nullptr if it uses the heap.
+     *
+     * @return The time in seconds of each timed trial, the average hardware counters if enabled, and the heap allocations per search.
+     * @note Trials shorter than the minimum sample time are batched: the batch size doubles until one batch takes at least
+     *      that long, then every trial times that many iterations and records the time per iteration.
+     */
+    template <typename agent_type, typename maze_type>
+        requires pathfinding_agent<agent_type, maze_type>
+    run_measurements run_trials(agent_type &agent, const maze_type &race_maze, const benchmark_options &options, scratch_arena *arena = nullptr);
+
+    /**
+     * @brief Appends benchmark results to a CSV file, one row per agent per maze.
+     *
+     * @param results The results to write.
+     * @param filename The CSV file name. A header row is written if the file is new or empty.
+     *
+     * @result Appends to the file so results can be tracked over time.
+     */
+    void write_results_csv(const std::vector<benchmark_result> &results, const std::string &filename);
+
+    /**
+     * @brief Writes benchmark results to a JSON file.
+     *
+     * @param results The results to write.
+     * @param filename The JSON file name.
+     *
+     * @result Writes an object with a timestamp and an array of results, including every trial time.
+     * @warning Overwrites any previous file with the same name.
+     */
+    void write_results_json(const std::vector<benchmark_result> &results, const std::string &filename);
+
+    /**
+     * @brief Prints one consolidated table of benchmark results, one row per agent per maze.
+     *
+     * @param results The results to print.
+     * @param output The stream to print to.
+     *
+     * @result Marks the fastest agent by average time on each maze as the winner.
+     */
+    void print_results_table(const std::vector<benchmark_result> &results, std::ostream &output);
+}
+
+////// ============== //////
+////// Implementation //////
+////// ============== //////
+
+namespace NPC_Racer
+{
+    //// Private Helper Functions ////
+    // only used by this module so kept out of the interface
+
+    /**
+     * @brief Gives the current UTC time in ISO 8601 format for labelling results.
+     */
+    std::string benchmark_timestamp()
+    {
+        std::time_t now = std::time(nullptr);
+        char buffer[32];
+        std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+        return buffer;
+    }
+
+    /**
+     * @brief Escapes a string for a JSON string value, file names can have `\`, `"`, and control characters like tabs and newlines in them.
+     */
+    std::string json_escape(const std::string &text)
+    {
+        std::string escaped;
+        for (const char character : text)
+        {
+            if ((character == '"') or (character == '\\'))
+            {
+                escaped += '\\';
+                escaped += character;
+            }
+            else if (character == '\n')
+                escaped += "\\n";
+            else if (character == '\t')
+                escaped += "\\t";
+            else if (character == '\r')
+                escaped += "\\r";
+            else if ((unsigned char)character < 0x20) // the rest of the control characters JSON doesn't allow as they are
+            {
+                char code[8];
+                std::snprintf(code, sizeof(code), "\\u%04x", (unsigned int)(unsigned char)character);
+                escaped += code;
+            }
+            else
+                escaped += character;
+        }
+        return escaped;
+    }
+
+    /**
+     * @brief Quotes a string as a CSV field, doubling any `"` in it as RFC 4180 asks so commas, quotes, and newlines in file names stay in their field.
+     */
+    std::string csv_quote(const std::string &text)
+    {
+        std::string quoted = "\"";
+        for (const char character : text)
+        {
+            if (character == '"')
+                quoted += '"';
+            quoted += character;
+        }
+        return quoted + "\"";
+    }
+
+    /**
+     * @brief Reads the number value of a numeric option or exits with an error.
+     */
+    size_t parse_count_argument(const std::string &option, const int argc, char *argv[], int &i)
+    {
+        if (i + 1 >= argc)
+        {
+            std::cout << "ERROR: Option `" << option << "` needs a number after it.\n";
+            exit(EXIT_FAILURE);
+        }
+        std::string value = argv[++i];
+        if (value.empty() or (value.find_first_not_of("0123456789") != std::string::npos))
+        {
+            std::cout << "ERROR: Option `" << option << "` was given `" << value << "` but must be a whole number.\n";
+            exit(EXIT_FAILURE);
+        }
+        try
+        {
+            return std::stoull(value);
+        }
+        catch (const std::out_of_range &)
+        {
+            std::cout << "ERROR: Option `" << option << "` was given `" << value << "` which is too large.\n";
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+NPC_Racer::benchmark_options NPC_Racer::parse_arguments(const int argc, char *argv[])
+{
+    benchmark_options options;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        if ((argument == "--help") or (argument == "-h"))
+        {
+            print_usage();
+            exit(EXIT_SUCCESS);
+        }
+        else if (argument == "--trials")
+        {
+            options.trials = parse_count_argument(argument, argc, argv, i);
+            if (options.trials == 0)
+            {
+                std::cout << "ERROR: There must be at least 1 trial per run.\n";
+                exit(EXIT_FAILURE);
+            }
+        }
+        else if (argument == "--warmup")
+            options.warmup_runs = parse_count_argument(argument, argc, argv, i);
+        else if (argument == "--min-sample-time")
+            options.minimum_sample_time = parse_count_argument(argument, argc, argv, i);
+        else if (argument == "--timer")
+        {
+            std::string timer = (i + 1 < argc) ? argv[++i] : "";
+            if ((timer != "steady") and (timer != "tsc"))
+            {
+                std::cout << "ERROR: Option `" << argument << "` must be followed by `steady` or `tsc`.\n";
+                exit(EXIT_FAILURE);
+            }
+            options.cycle_counter_timer = (timer == "tsc");
+        }
+        else if (argument == "--reject-outliers")
+            options.reject_outliers = true;
+        else if (argument == "--counters")
+            options.hardware_counters = true;
+        else if (argument == "--jobs")
+            options.jobs = parse_count_argument(argument, argc, argv, i);
+        else if (argument == "--pin-cores")
+            options.pin_cores = true;
+        else if (argument == "--head-to-head")
+            options.head_to_head = true;
+        else if (argument == "--async")
+            options.async_requests = parse_count_argument(argument, argc, argv, i);
+        else if (argument == "--async-workers")
+            options.async_workers = parse_count_argument(argument, argc, argv, i);
+        else if (argument == "--cooperative")
+            options.cooperative_agents = parse_count_argument(argument, argc, argv, i);
+        else if (argument == "--window")
+        {
+            options.cooperative_window = parse_count_argument(argument, argc, argv, i);
+            if (options.cooperative_window == 0)
+            {
+                std::cout << "ERROR: Cooperative agents must plan at least 1 tick ahead.\n";
+                exit(EXIT_FAILURE);
+            }
+        }
+        else if (argument == "--hierarchy")
+            options.hierarchy_queries = parse_count_argument(argument, argc, argv, i);
+        else if (argument == "--memory-limit")
+            options.memory_limit = parse_count_argument(argument, argc, argv, i);
+        else if (argument == "--arena")
+            options.scratch_arenas = true;
+        else if (argument == "--cache")
+        {
+            if (i + 1 >= argc)
+            {
+                std::cout << "ERROR: Option `" << argument << "` needs a directory name after it.\n";
+                exit(EXIT_FAILURE);
+            }
+            options.cache_directory = argv[++i];
+        }
+        else if (argument == "--suite")
+            options.suite = true;
+        else if (argument == "--regression-threshold")
+            options.regression_threshold = parse_count_argument(argument, argc, argv, i);
+        else if (argument == "--trace")
+        {
+            if (i + 1 >= argc)
+            {
+                std::cout << "ERROR: Option `" << argument << "` needs a file name prefix after it.\n";
+                exit(EXIT_FAILURE);
+            }
+            options.trace_prefix = argv[++i];
+        }
+        else if (argument == "--serve")
+            options.serve = true;
+        else if (argument == "--socket")
+        {
+            if (i + 1 >= argc)
+            {
+                std::cout << "ERROR: Option `" << argument << "` needs a socket file name after it.\n";
+                exit(EXIT_FAILURE);
+            }
+            options.socket_file = argv[++i];
+            options.serve = true;
+        }
+        else if ((argument == "--save-baseline") or (argument == "--compare-baseline"))
+        {
+            if (i + 1 >= argc)
+            {
+                std::cout << "ERROR: Option `" << argument << "` needs a file name after it.\n";
+                exit(EXIT_FAILURE);
+            }
+            (argument == "--save-baseline" ? options.save_baseline_file : options.compare_baseline_file) = argv[++i];
+        }
+        else if ((argument == "--csv") or (argument == "--json"))
+        {
+            if (i + 1 >= argc)
+            {
+                std::cout << "ERROR: Option `" << argument << "` needs a file name after it.\n";
+                exit(EXIT_FAILURE);
+            }
+            (argument == "--csv" ? options.csv_file : options.json_file) = argv[++i];
+        }
+        else if (argument.starts_with("--"))
+        {
+            std::cout << "ERROR: Unknown option `" << argument << "`.\n";
+            print_usage();
+            exit(EXIT_FAILURE);
+        }
+        else
+            options.maze_files.push_back(argument);
+    }
+    return options;
+}
+
+void NPC_Racer::print_usage()
+{
+    std::cout << "### Welcome to NPC Racer! ###\n"
+              << "- The only required argument is the filename of the maze.\n"
+              << "- Several maze files or directories of mazes can be given to race on all of them.\n"
+              << "- Make sure the maze file is in the same directory as the executable.\n"
+              << "- For example on Windows Powershell type: \n\t .\\NPCRacer.exe 10_10_test_maze.txt \n"
+              << "- Options:\n"
+              << "\t--trials N          Number of timed trials per run (default 11).\n"
+              << "\t--warmup N          Number of untimed warmup trials per run (default 1).\n"
+              << "\t--min-sample-time N Batch trials faster than N microseconds (default 100, 0 to never batch).\n"
+              << "\t--timer steady|tsc  Time with std::chrono::steady_clock or the x86 cycle counter (default steady).\n"
+              << "\t--reject-outliers   Remove outlier trials before taking statistics.\n"
+              << "\t--counters          Measure hardware performance counters for each trial (Linux only).\n"
+              << "\t--jobs N            Number of mazes raced at the same time, 0 for one per core (default 1).\n"
+              << "\t--pin-cores         Pin each race worker, or head-to-head agent, to its own core (Linux only).\n"
+              << "\t--head-to-head      Also race the agents at the same time on their own threads, one round per trial.\n"
+              << "\t--async N           Also request N paths at once per agent from coroutines on a work-stealing pool.\n"
+              << "\t--async-workers N   Number of workers answering the async requests, 0 for one per core (default 0).\n"
+              << "\t--cooperative N     Also time cooperative planning for groups of up to N agents that must not collide.\n"
+              << "\t--window N          Number of ticks each cooperative agent plans ahead (default 16).\n"
+              << "\t--hierarchy N       Also build a contraction hierarchy of the maze and time N random queries on it.\n"
+              << "\t--memory-limit N    Cap the scratch memory of the low-memory agent at N bytes (default no cap).\n"
+              << "\t--arena             Make each agent's scratch arrays in its own arena, reset before every search.\n"
+              << "\t--cache DIR         Cache parsed mazes and their graphs in DIR so later loads skip parsing.\n"
+              << "\t--csv FILE          Append the results to a CSV file.\n"
+              << "\t--json FILE         Write the results to a JSON file.\n"
+              << "\t--suite             Race the regression suite: `sample_mazes` plus generated large mazes.\n"
+              << "\t--save-baseline F   Save the results as a baseline to compare later runs against.\n"
+              << "\t--compare-baseline F Compare the results against a baseline, exits with failure on a regression.\n"
+              << "\t--regression-threshold N  Smallest significant slowdown in percent counted as a regression (default 5).\n"
+              << "\t--trace PREFIX      Write each agent's exploration trace (needs -DNPC_RACER_EXPLORATION_TRACE).\n"
+              << "\t--serve             Keep the mazes loaded and answer path queries over stdin instead of racing.\n"
+              << "\t--socket FILE       Like --serve but answer path queries on a Unix domain socket.\n";
+}
+
+template <typename agent_type, typename maze_type>
+    requires NPC_Racer::pathfinding_agent<agent_type, maze_type>
+NPC_Racer::run_measurements NPC_Racer::run_trials(agent_type &agent, const maze_type &race_maze, const benchmark_options &options, scratch_arena *arena /* nullptr */)
+{
+    timekeeper trial_timer(options.hardware_counters, options.cycle_counter_timer);
+    run_measurements measurements;
+    std::vector<hardware_counter_values> trial_counters;
+    measurements.trial_times.reserve(options.trials); // reserving so the timed loop doesn't allocate
+    measurements.cycle_counter_timed = trial_timer.uses_cycle_counter();
+    if (options.hardware_counters)
+        trial_counters.reserve(options.trials);
+
+    // an agent on an arena frees its scratch arrays and starts each search from a reset arena, as a new agent would
+    auto search = [&]()
+    {
+        if constexpr (requires { agent.release_scratch(); })
+        {
+            if (arena != nullptr)
+            {
+                agent.release_scratch();
+                arena->reset();
+            }
+        }
+        agent.pathfind(race_maze);
+    };
+
+    for (size_t i = 0; i < options.warmup_runs; i++)
+    {
+        allocation_counts before = thread_allocation_counts();
+        search(); // untimed
+        if (i == 0)
+        {
+            allocation_counts after = thread_allocation_counts();
+            measurements.first_search_allocations = {after.allocations - before.allocations, after.bytes - before.bytes};
+        }
+    }
+
+    // Batch Sizing //
+    // a single trial shorter than the minimum is mostly timer resolution and overhead, so doubling until a batch is long enough
+    uint64_t &iterations = measurements.iterations_per_trial;
+    double minimum_time = (double)options.minimum_sample_time * 1e-6;
+    while (minimum_time > 0)
+    {
+        trial_timer.start();
+        for (uint64_t j = 0; j < iterations; j++)
+            search();
+        trial_timer.end();
+        if ((trial_timer.race_time() >= minimum_time) or (iterations >= maximum_batch_iterations))
+            break;
+        iterations *= 2;
+    }
+
+    // the timed loop itself doesn't allocate, so everything counted is the agent's
+    allocation_counts before_trials = thread_allocation_counts();
+    for (size_t i = 0; i < options.trials; i++)
+    {
+        trial_timer.start();
+        for (uint64_t j = 0; j < iterations; j++)
+            search(); // doing the pathfinding
+        trial_timer.end();
+        measurements.trial_times.push_back(trial_timer.race_time() / (double)iterations); // adding to trial container
+        if (options.hardware_counters)
+            trial_counters.push_back(trial_timer.counter_values());
+    }
+
+    allocation_counts after_trials = thread_allocation_counts();
+    if (options.trials > 0)
+    {
+        double searches = (double)options.trials * (double)iterations;
+        measurements.allocations_per_search = (double)(after_trials.allocations - before_trials.allocations) / searches;
+        measurements.allocated_bytes_per_search = (double)(after_trials.bytes - before_trials.bytes) / searches;
+    }
+
+    measurements.counters = counter_average(trial_counters, iterations);
+    return measurements;
+}
+
+void NPC_Racer::write_results_csv(const std::vector<benchmark_result> &results, const std::string &filename)
+{
+    // checking if the file already has content so the header is only written once
+    std::ifstream existing(filename);
+    bool write_header = !existing.is_open() or (existing.peek() == std::ifstream::traits_type::eof());
+    existing.close();
+
+    std::ofstream output(filename, std::ios::app);
+    if (!output.is_open())
+    {
+        std::cout << "ERROR: Error opening CSV output file `" << filename << "`!\n";
+        return;
+    }
+
+    if (write_header)
+        output << "timestamp,maze,agent,index_bits,trials,iterations_per_trial,rejected_trials,average,standard_deviation,minimum,median,p90,p99,path_size,nodes_explored,"
+               << "cycles,instructions,l1_data_misses,last_level_cache_misses,branch_misses\n";
+
+    std::string timestamp = benchmark_timestamp();
+    output.precision(9);
+    for (const benchmark_result &result : results)
+    {
+        const run_statistics &statistics = result.statistics;
+        output << csv_quote(timestamp) << "," << csv_quote(result.maze_name) << "," << csv_quote(result.agent_name) << "," << result.index_bits << ","
+               << statistics.trials << "," << result.iterations_per_trial << "," << statistics.rejected_trials << ","
+               << statistics.average << "," << statistics.standard_deviation << "," << statistics.minimum << ","
+               << statistics.median << "," << statistics.percentile_90 << "," << statistics.percentile_99 << ","
+               << result.path_size << "," << result.nodes_explored << ","
+               << result.counters.cycles << "," << result.counters.instructions << "," << result.counters.l1_data_misses << ","
+               << result.counters.last_level_cache_misses << "," << result.counters.branch_misses << "\n";
+    }
+    output.close();
+    std::cout << "Results appended to `" << filename << "`.\n";
+}
+
+void NPC_Racer::write_results_json(const std::vector<benchmark_result> &results, const std::string &filename)
+{
+    std::ofstream output(filename);
+    if (!output.is_open())
+    {
+        std::cout << "ERROR: Error opening JSON output file `" << filename << "`!\n";
+        return;
+    }
+
+    output.precision(9);
+    output << "{\n  \"timestamp\": \"" << benchmark_timestamp() << "\",\n  \"results\": [";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const benchmark_result &result = results[i];
+        const run_statistics &statistics = result.statistics;
+        output << (i == 0 ? "\n" : ",\n")
+               << "    {\"maze\": \"" << json_escape(result.maze_name) << "\", \"agent\": \"" << json_escape(result.agent_name) << "\""
+               << ", \"index_bits\": " << result.index_bits
+               << ", \"trials\": " << statistics.trials << ", \"iterations_per_trial\": " << result.iterations_per_trial
+               << ", \"rejected_trials\": " << statistics.rejected_trials
+               << ", \"average\": " << statistics.average << ", \"standard_deviation\": " << statistics.standard_deviation
+               << ", \"minimum\": " << statistics.minimum << ", \"median\": " << statistics.median
+               << ", \"p90\": " << statistics.percentile_90 << ", \"p99\": " << statistics.percentile_99
+               << ", \"path_size\": " << result.path_size << ", \"nodes_explored\": " << result.nodes_explored
+               << ", \"cycles\": " << result.counters.cycles << ", \"instructions\": " << result.counters.instructions
+               << ", \"l1_data_misses\": " << result.counters.l1_data_misses << ", \"last_level_cache_misses\": " << result.counters.last_level_cache_misses
+               << ", \"branch_misses\": " << result.counters.branch_misses
+               << ", \"trial_times\": [";
+        for (size_t j = 0; j < result.trial_times.size(); j++)
+            output << (j == 0 ? "" : ", ") << result.trial_times[j];
+        output << "]}";
+    }
+    output << "\n  ]\n}\n";
+    output.close();
+    std::cout << "Results written to `" << filename << "`.\n";
+}
+
+void NPC_Racer::print_results_table(const std::vector<benchmark_result> &results, std::ostream &output)
+{
+    output << "\n# Consolidated Results #\n";
+    output << "Agent\t\t| Bits\t| Average\t| Median\t| P90\t\t| Path\t| Explored\t| Maze\n";
+    output << "----------------|-------|---------------|---------------|---------------|-------|---------------|------\n";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const benchmark_result &result = results[i];
+
+        // finding the fastest agent on the same maze
+        bool winner = true;
+        for (const benchmark_result &other : results)
+            if ((other.maze_name == result.maze_name) and (other.statistics.average < result.statistics.average))
+                winner = false;
+
+        output << result.agent_name << (result.agent_name.size() < 8 ? "\t\t| " : "\t| ")
+               << result.index_bits << "\t| " << result.statistics.average << "\t| " << result.statistics.median << "\t| "
+               << result.statistics.percentile_90 << "\t| " << result.path_size << "\t| " << result.nodes_explored << "\t\t| "
+               << result.maze_name << (winner ? " (WINNER)" : "") << "\n";
+    }
+    output << "----------------|-------|---------------|---------------|---------------|-------|---------------|------\n";
+    output << "^all times are in seconds, " << results.size() << " runs\n";
+}
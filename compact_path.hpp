@@ -0,0 +1,409 @@
+/**
+ * @file compact_path.hpp
+ * @author Brendan Fallon (fallonbr@mcmaster.ca) (https://github.com/bren007pie)
+ * @brief This module contains the compact path class, a path stored as its start and run-length encoded moves.
+ * @version 1.0
+ * @date Sunday October 18, 2026
+ * @copyright Copyright (c) 2022 Brendan Fallon
+ */
+
+//// Preprocessor Directives ////
+#pragma once
+#include <vector>    // std::vector
+#include <span>      // std::span
+#include <algorithm> // std::reverse
+#include <iterator>  // std::forward_iterator_tag
+#include <cstddef>   // std::ptrdiff_t
+#include <cstdint>   // uint16_t, uint64_t
+#include <concepts>  // std::unsigned_integral, std::invocable
+
+////// ========= //////
+////// Interface //////
+////// ========= //////
+
+namespace NPC_Racer
+{
+    //// ------------------ ////
+    //// Compact Path Class ////
+    //// ------------------ ////
+    /**
+     * @brief A path stored as its start position and runs of moves in the same direction, decoded as it's walked.
+     *
+     * @tparam index_type The unsigned integer type used for indices, must match the maze.
+     * @result Each run takes 2 bytes no matter how long it is, so a path through corridors takes a small fraction of the memory of one index per position.
+     * @note Directions use the same order as connected_paths: 0 is up, 1 is down, 2 is left, and 3 is right.
+     */
+    template <std::unsigned_integral index_type>
+    class compact_path
+    {
+    public:
+        //// Iterator Class ////
+        /**
+         * @brief Forward iterator over the positions of a compact path, decoding the runs on the fly.
+         */
+        class iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = index_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const index_type *;
+            using reference = index_type;
+
+            iterator() = default;
+
+            /**
+             * @brief Constructs an iterator at a point along a path.
+             *
+             * @param walked_path The path to walk.
+             * @param steps_taken The number of positions already walked, the path size for the end iterator.
+             */
+            iterator(const compact_path *walked_path, const size_t steps_taken);
+
+            /**
+             * @brief Gives the position the iterator is at.
+             * @return The index of the position in the flattened maze.
+             */
+            index_type operator*() const { return position; }
+
+            /**
+             * @brief Moves to the next position along the path.
+             * @return The moved iterator.
+             */
+            iterator &operator++();
+
+            /**
+             * @brief Moves to the next position along the path.
+             * @return A copy of the iterator from before it moved.
+             */
+            iterator operator++(int);
+
+            /**
+             * @brief Iterators are equal if they are the same number of positions along the same path.
+             */
+            bool operator==(const iterator &other) const { return step == other.step; }
+
+        private:
+            /**
+             * @param decoded_path The path being walked.
+             */
+            const compact_path *decoded_path = nullptr;
+
+            /**
+             * @param position The current position.
+             */
+            index_type position = 0;
+
+            /**
+             * @param step The number of positions already walked.
+             */
+            size_t step = 0;
+
+            /**
+             * @param run The run the next move is taken from.
+             */
+            size_t run = 0;
+
+            /**
+             * @param run_moves The moves already taken from the current run.
+             */
+            size_t run_moves = 0;
+        };
+
+        //// Member Functions ////
+
+        /**
+         * @brief Empties the path.
+         */
+        void clear();
+
+        /**
+         * @brief Encodes a path of positions, replacing what was stored.
+         *
+         * @param path The positions of the path from start to destination, each next to the last.
+         * @param columns The number of columns of the maze the path is on.
+         */
+        void assign(const std::vector<index_type> &path, const size_t columns);
+
+        /**
+         * @brief Makes the path a single position, used when no path was found.
+         *
+         * @param position The only position of the path.
+         * @param columns The number of columns of the maze the path is on.
+         */
+        void assign(const index_type position, const size_t columns);
+
+        /**
+         * @brief Encodes a path straight from the previous nodes of a search, without building the positions first.
+         *
+         * @param previous_nodes The position each node was reached from, no_path if it wasn't reached.
+         * @param start_position The start of the path.
+         * @param destination_position The end of the path, backtracked from.
+         * @param columns The number of columns of the maze the path is on.
+         * @param no_path The value in previous_nodes marking a node with no previous node.
+         *
+         * @result The runs are built backwards from the destination then reversed, the same way agents build their path.
+         */
+        void backtrack(std::span<const index_type> previous_nodes, const index_type start_position, const index_type destination_position,
+                       const size_t columns, const index_type no_path);
+
+        /**
+         * @brief Encodes a path straight from a search that doesn't keep previous nodes, e.g. one that keeps the direction each node was reached by.
+         *
+         * @param previous_node Called with a position to get the position it was reached from, no_path if it wasn't reached.
+         * @param start_position The start of the path.
+         * @param destination_position The end of the path, backtracked from.
+         * @param columns The number of columns of the maze the path is on.
+         * @param no_path The value previous_node gives for a node with no previous node.
+         */
+        template <std::invocable<index_type> previous_function>
+        void backtrack(previous_function previous_node, const index_type start_position, const index_type destination_position,
+                       const size_t columns, const index_type no_path);
+
+        /**
+         * @brief Frees the unused capacity of the runs, for paths that are kept instead of reused by the next search.
+         */
+        void shrink_to_fit() { moves.shrink_to_fit(); }
+
+        /**
+         * @brief Decodes the path into positions.
+         *
+         * @param path Replaced by the positions of the path from start to destination.
+         */
+        void expand(std::vector<index_type> &path) const;
+
+        /**
+         * @brief Gives the number of positions in the path, including the start and destination.
+         * @return The length of the path.
+         */
+        size_t size() const { return length; }
+
+        /**
+         * @brief Says whether the path has any positions.
+         * @return True if there are no positions.
+         */
+        bool empty() const { return length == 0; }
+
+        /**
+         * @brief Gives the first position of the path.
+         * @return The index of the start position.
+         */
+        index_type front() const { return start; }
+
+        /**
+         * @brief Gives the number of runs of moves stored.
+         * @return The number of 2 byte runs.
+         */
+        size_t runs() const { return moves.size(); }
+
+        /**
+         * @brief Gives the memory used by the path, the object and the runs it holds.
+         * @return The size in bytes.
+         */
+        size_t memory_bytes() const { return sizeof(compact_path) + moves.capacity() * sizeof(uint16_t); }
+
+        //// Iterators ////
+        iterator begin() const { return iterator(this, 0); }
+        iterator end() const { return iterator(this, length); }
+
+    private:
+        //// Private Member Functions ////
+        /**
+         * @brief Adds one move to the last run, or starts a new run if the direction changed or the run is full.
+         *
+         * @param direction The direction of the move.
+         */
+        void push_move(const uint16_t direction);
+
+        /**
+         * @brief Finds the direction of a move between two neighbouring positions.
+         *
+         * @param from The position the move starts on.
+         * @param to The position the move ends on.
+         *
+         * @return The direction code of the move.
+         */
+        uint16_t direction_of(const index_type from, const index_type to) const;
+
+        //// Data Members ////
+
+        /**
+         * @param run_bits The number of low bits of a run used for its length, the top 2 bits are its direction.
+         */
+        static constexpr uint16_t run_bits = 14;
+
+        /**
+         * @param max_run The longest run, longer straight lines are split into more runs.
+         */
+        static constexpr uint16_t max_run = (1 << run_bits) - 1;
+
+        /**
+         * @param moves The runs of moves, each the direction in the top 2 bits and the number of moves in the rest.
+         */
+        std::vector<uint16_t> moves;
+
+        /**
+         * @param start The first position of the path.
+         */
+        index_type start = 0;
+
+        /**
+         * @param column_size The number of columns of the maze, the offset of an up or down move.
+         */
+        index_type column_size = 0;
+
+        /**
+         * @param length The number of positions in the path.
+         */
+        size_t length = 0;
+    };
+}
+
+////// ============== //////
+////// Implementation //////
+////// ============== //////
+
+//// Iterator Member Functions ////
+
+template <std::unsigned_integral index_type>
+NPC_Racer::compact_path<index_type>::iterator::iterator(const compact_path *walked_path, const size_t steps_taken)
+    : decoded_path(walked_path), position(walked_path->start), step(steps_taken)
+{
+}
+
+template <std::unsigned_integral index_type>
+typename NPC_Racer::compact_path<index_type>::iterator &NPC_Racer::compact_path<index_type>::iterator::operator++()
+{
+    if (++step == decoded_path->length) // the end, there's no move after the last position
+        return *this;
+
+    uint16_t current_run = decoded_path->moves[run];
+    switch (current_run >> run_bits)
+    {
+    case 0: // up
+        position = (index_type)(position - decoded_path->column_size);
+        break;
+    case 1: // down
+        position = (index_type)(position + decoded_path->column_size);
+        break;
+    case 2: // left
+        position = (index_type)(position - 1);
+        break;
+    default: // right
+        position = (index_type)(position + 1);
+        break;
+    }
+
+    // moving to the next run once this one is used up
+    if (++run_moves == (current_run & max_run))
+    {
+        run++;
+        run_moves = 0;
+    }
+    return *this;
+}
+
+template <std::unsigned_integral index_type>
+typename NPC_Racer::compact_path<index_type>::iterator NPC_Racer::compact_path<index_type>::iterator::operator++(int)
+{
+    iterator before = *this;
+    ++(*this);
+    return before;
+}
+
+//// Member Functions ////
+
+template <std::unsigned_integral index_type>
+void NPC_Racer::compact_path<index_type>::clear()
+{
+    moves.clear(); // keeps the capacity so repeated searches don't allocate
+    start = 0;
+    length = 0;
+}
+
+template <std::unsigned_integral index_type>
+void NPC_Racer::compact_path<index_type>::assign(const std::vector<index_type> &path, const size_t columns)
+{
+    clear();
+    column_size = (index_type)columns;
+    if (path.empty())
+        return;
+
+    start = path[0];
+    length = path.size();
+    for (size_t i = 1; i < path.size(); i++)
+        push_move(direction_of(path[i - 1], path[i]));
+}
+
+template <std::unsigned_integral index_type>
+void NPC_Racer::compact_path<index_type>::assign(const index_type position, const size_t columns)
+{
+    clear();
+    column_size = (index_type)columns;
+    start = position;
+    length = 1;
+}
+
+template <std::unsigned_integral index_type>
+void NPC_Racer::compact_path<index_type>::backtrack(std::span<const index_type> previous_nodes, const index_type start_position,
+                                                    const index_type destination_position, const size_t columns, const index_type no_path)
+{
+    backtrack([previous_nodes](const index_type position)
+              { return previous_nodes[position]; },
+              start_position, destination_position, columns, no_path);
+}
+
+template <std::unsigned_integral index_type>
+template <std::invocable<index_type> previous_function>
+void NPC_Racer::compact_path<index_type>::backtrack(previous_function previous_node, const index_type start_position,
+                                                    const index_type destination_position, const size_t columns, const index_type no_path)
+{
+    clear();
+    column_size = (index_type)columns;
+
+    // each move is recorded backwards, from the position to the one it was reached from
+    index_type position = destination_position;
+    length = 1;
+    while (position != start_position)
+    {
+        index_type previous_position = previous_node(position);
+        if (previous_position == no_path) // reached a node with nothing before it
+            break;
+        push_move(direction_of(position, previous_position));
+        position = previous_position;
+        length++;
+    }
+    start = position;
+
+    // the runs were built from the destination, reversing them and their directions walks from the start
+    std::reverse(moves.begin(), moves.end());
+    for (uint16_t &run : moves)
+        run = (uint16_t)(run ^ (1 << run_bits)); // up <-> down and left <-> right only differ in the low direction bit
+}
+
+template <std::unsigned_integral index_type>
+void NPC_Racer::compact_path<index_type>::expand(std::vector<index_type> &path) const
+{
+    path.assign(begin(), end());
+}
+
+template <std::unsigned_integral index_type>
+void NPC_Racer::compact_path<index_type>::push_move(const uint16_t direction)
+{
+    if (!moves.empty() and ((moves.back() >> run_bits) == direction) and ((moves.back() & max_run) < max_run))
+        moves.back()++;
+    else
+        moves.push_back((uint16_t)((direction << run_bits) | 1));
+}
+
+template <std::unsigned_integral index_type>
+uint16_t NPC_Racer::compact_path<index_type>::direction_of(const index_type from, const index_type to) const
+{
+    if (to + column_size == from)
+        return 0; // up
+    if (from + column_size == to)
+        return 1; // down
+    if (to + 1 == from)
+        return 2; // left
+    return 3;     // right
+}
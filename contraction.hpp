@@ -0,0 +1,754 @@
+/**
+ * @file contraction.hpp
+ * @author Brendan Fallon (fallonbr@mcmaster.ca) (https://github.com/bren007pie)
+ * @brief This module contains contraction hierarchies, a preprocessing of a static maze that answers shortest path queries between any two spaces with a small bidirectional search.
+ * @version 1.0
+ * @date Sunday October 18, 2026
+ * @copyright Copyright (c) 2022 Brendan Fallon
+ */
+
+//// Preprocessor Directives ////
+#pragma once
+#include <vector>     // std::vector
+#include <array>      // std::array
+#include <algorithm>  // std::make_heap, std::push_heap, std::pop_heap, std::min, std::max, std::reverse, std::fill, std::find
+#include <functional> // std::greater
+#include <chrono>     // std::chrono::steady_clock
+#include <random>     // std::mt19937_64, std::uniform_int_distribution
+#include <utility>    // std::pair
+#include <limits>     // std::numeric_limits
+#include <cstdint>    // uint32_t, uint64_t, int64_t
+#include <concepts>   // std::unsigned_integral
+#include "mazes.hpp"  // NPC_Racer::maze
+
+////// ========= //////
+////// Interface //////
+////// ========= //////
+
+namespace NPC_Racer
+{
+    //// ------- ////
+    //// Structs ////
+    //// ------- ////
+    /**
+     * @brief The preprocessing and query measurements of a contraction hierarchy on one maze.
+     */
+    struct hierarchy_result
+    {
+        /**
+         * @param preprocessing_seconds The time to order and contract every space.
+         */
+        double preprocessing_seconds = 0;
+
+        /**
+         * @param nodes The number of free spaces in the hierarchy.
+         */
+        size_t nodes = 0;
+
+        /**
+         * @param edges The number of edges between neighbouring free spaces in the maze.
+         */
+        size_t edges = 0;
+
+        /**
+         * @param shortcuts The number of shortcut edges added by contraction.
+         */
+        size_t shortcuts = 0;
+
+        /**
+         * @param shortcut_bytes The memory of the shortcut edges.
+         */
+        size_t shortcut_bytes = 0;
+
+        /**
+         * @param memory_bytes The memory of the whole hierarchy, including its query scratch arrays.
+         */
+        size_t memory_bytes = 0;
+
+        /**
+         * @param race_path_size The number of positions on the hierarchy's path from the maze's start to its destination, 0 if there is none.
+         */
+        size_t race_path_size = 0;
+
+        /**
+         * @param latencies The time in seconds of each random query, including unpacking its path.
+         */
+        std::vector<double> latencies;
+
+        /**
+         * @param search_latencies The time in seconds of a breadth-first search over the maze for each checked query, for comparison.
+         */
+        std::vector<double> search_latencies;
+
+        /**
+         * @param nodes_settled The nodes settled by the random queries in total, both directions.
+         */
+        uint64_t nodes_settled = 0;
+
+        /**
+         * @param mismatches The checked queries whose path was invalid or longer than the breadth-first search's.
+         */
+        size_t mismatches = 0;
+    };
+
+    //// --------------------------- ////
+    //// Contraction Hierarchy Class ////
+    //// --------------------------- ////
+    /**
+     * @brief A contraction hierarchy of the free spaces of a maze, built once and then queried for shortest paths.
+     *
+     * @tparam index_type The unsigned integer type used for the maze indices.
+     * @result Spaces are contracted one at a time from least to most important, adding a shortcut between two neighbours of a
+     *      contracted space whenever the path through it was their only shortest path. A query then only searches upward in the
+     *      order from both ends, which in a maze settles a few hundred spaces instead of most of the maze.
+     * @note The hierarchy copies what it needs from the maze, so mutating the maze afterwards isn't seen by it. Queries reuse
+     *      scratch arrays, so one hierarchy shouldn't be queried from several threads at once.
+     */
+    template <std::unsigned_integral index_type>
+    class contraction_hierarchy
+    {
+    public:
+        /**
+         * @brief An edge from a space to one contracted after it, either between neighbours or a shortcut.
+         */
+        struct upward_edge
+        {
+            index_type target; // the space contracted after the one owning the edge
+            index_type middle; // the space the shortcut skips, no_path for an edge between neighbours
+            uint32_t weight;   // the number of moves the edge stands for
+        };
+
+        /**
+         * @brief Contracts every free space of a maze.
+         *
+         * @param race_maze The maze to build the hierarchy of, its connected_paths are built if they aren't yet.
+         */
+        explicit contraction_hierarchy(const maze<index_type> &race_maze);
+
+        /**
+         * @brief Finds a shortest path between two positions.
+         *
+         * @param source The position the path starts on.
+         * @param destination The position the path ends on.
+         * @param path Replaced by the positions from source to destination, each next to the last.
+         *
+         * @return True if there is a path, false if there isn't or either position is a barrier.
+         */
+        bool query(const index_type source, const index_type destination, std::vector<index_type> &path);
+
+        /**
+         * @brief Gives the number of spaces the last query settled in both directions.
+         * @return The settled node count.
+         */
+        size_t last_settled() const { return settled_nodes; }
+
+        /**
+         * @brief Gives the number of free spaces in the hierarchy.
+         * @return The node count.
+         */
+        size_t nodes() const { return node_count; }
+
+        /**
+         * @brief Gives the number of edges between neighbouring free spaces.
+         * @return The original edge count, each edge counted once.
+         */
+        size_t edges() const { return upward_edges.size() - shortcut_count; }
+
+        /**
+         * @brief Gives the number of shortcuts added by contraction.
+         * @return The shortcut count, each shortcut counted once.
+         */
+        size_t shortcuts() const { return shortcut_count; }
+
+        /**
+         * @brief Gives the memory used by the hierarchy.
+         * @return The size in bytes of the edges, the order, and the query scratch arrays.
+         */
+        size_t memory_bytes() const;
+
+        /**
+         * @param preprocessing_time The time in seconds it took to order and contract every space.
+         */
+        double preprocessing_time = 0.0;
+
+        /**
+         * @param no_path The value of an edge's middle space when it isn't a shortcut, the same as the maze's.
+         */
+        static constexpr index_type no_path = maze<index_type>::no_path;
+
+    private:
+        //// Private Member Functions ////
+        /**
+         * @brief Contracts a space, or only counts the shortcuts contracting it would add.
+         *
+         * @param node The space to contract.
+         * @param simulate If true nothing is changed, which is how the contraction order is decided.
+         * @param settle_limit The most spaces each witness search settles before giving up and adding the shortcut anyway.
+         *
+         * @return The number of shortcuts contracting the space adds.
+         */
+        size_t contract_node(const index_type node, const bool simulate, const size_t settle_limit);
+
+        /**
+         * @brief Finds the distances from a space to the others near it without passing through the space being contracted.
+         *
+         * @param source The space to search from.
+         * @param skipped The space being contracted.
+         * @param max_distance The longest distance worth finding, the longest path through the skipped space.
+         * @param settle_limit The most spaces settled before stopping.
+         *
+         * @result The distances are left in witness_distances for the spaces with the current witness_stamp.
+         */
+        void witness_search(const index_type source, const index_type skipped, const uint32_t max_distance, const size_t settle_limit);
+
+        /**
+         * @brief Adds a shortcut between two uncontracted spaces, or shortens the edge already between them.
+         */
+        void add_shortcut(const index_type from, const index_type to, const index_type middle, const uint32_t weight);
+
+        /**
+         * @brief Gives the priority of contracting a space next, lower is sooner.
+         * @return The shortcuts it would add less the edges it removes, plus its contracted neighbours so contraction spreads out evenly.
+         */
+        int64_t contraction_priority(const index_type node);
+
+        /**
+         * @brief Finds the edge between two spaces, searched from whichever was contracted first.
+         * @return The edge, which exists for every pair of spaces next to each other on a query's path.
+         */
+        const upward_edge &find_edge(const index_type first, const index_type second) const;
+
+        /**
+         * @brief Adds the positions an edge stands for to a path, replacing shortcuts by the edges they skip.
+         *
+         * @param from The position already at the end of the path.
+         * @param to The position the edge ends on, added last.
+         * @param path The path being unpacked.
+         */
+        void unpack_edge(const index_type from, const index_type to, std::vector<index_type> &path);
+
+        //// Data Members ////
+
+        /**
+         * @param not_contracted The rank of a barrier, which is never contracted.
+         */
+        static constexpr uint32_t not_contracted = std::numeric_limits<uint32_t>::max();
+
+        /**
+         * @param unreached The distance of a space a search hasn't reached.
+         */
+        static constexpr uint32_t unreached = std::numeric_limits<uint32_t>::max();
+
+        /**
+         * @param ranks The order each space was contracted in, not_contracted for barriers.
+         */
+        std::vector<uint32_t> ranks;
+
+        /**
+         * @param first_edges The index in upward_edges of each space's first edge, one past the last space for the end.
+         */
+        std::vector<size_t> first_edges;
+
+        /**
+         * @param upward_edges The edges of every space to spaces contracted after it, grouped by space.
+         */
+        std::vector<upward_edge> upward_edges;
+
+        /**
+         * @param node_count The number of free spaces.
+         */
+        size_t node_count = 0;
+
+        /**
+         * @param shortcut_count The number of shortcuts among the upward edges.
+         */
+        size_t shortcut_count = 0;
+
+        /**
+         * @param remaining_edges The edges of each space to the spaces not contracted yet, only used while contracting.
+         */
+        std::vector<std::vector<upward_edge>> remaining_edges;
+
+        /**
+         * @param contracted_neighbours The number of neighbours of each space already contracted, only used while contracting.
+         */
+        std::vector<uint32_t> contracted_neighbours;
+
+        /**
+         * @param witness_distances The distances found by the last witness search, valid where witness_stamps matches.
+         */
+        std::vector<uint32_t> witness_distances;
+
+        /**
+         * @param witness_stamps The witness search each witness distance was written by, so they are never cleared.
+         */
+        std::vector<uint32_t> witness_stamps;
+
+        /**
+         * @param witness_stamp The current witness search.
+         */
+        uint32_t witness_stamp = 0;
+
+        /**
+         * @param query_distances The distance of each space from the source, then from the destination, valid where query_stamps matches.
+         */
+        std::array<std::vector<uint32_t>, 2> query_distances;
+
+        /**
+         * @param query_parents The space each space was reached from in each direction.
+         */
+        std::array<std::vector<index_type>, 2> query_parents;
+
+        /**
+         * @param query_stamps The query each distance was written by, so they are never cleared.
+         */
+        std::array<std::vector<uint32_t>, 2> query_stamps;
+
+        /**
+         * @param query_stamp The current query.
+         */
+        uint32_t query_stamp = 0;
+
+        /**
+         * @param frontiers The heaps of distances and spaces of the searches, the witness search uses the first.
+         */
+        std::array<std::vector<std::pair<uint32_t, index_type>>, 2> frontiers;
+
+        /**
+         * @param unpack_stack The edges still to unpack, latest first.
+         */
+        std::vector<std::pair<index_type, index_type>> unpack_stack;
+
+        /**
+         * @param hierarchy_path The spaces of the last query's path in the hierarchy, before its shortcuts are unpacked.
+         */
+        std::vector<index_type> hierarchy_path;
+
+        /**
+         * @param settled_nodes The spaces the last query settled.
+         */
+        size_t settled_nodes = 0;
+    };
+
+    //// --------- ////
+    //// Functions ////
+    //// --------- ////
+    /**
+     * @brief Builds the contraction hierarchy of a maze and times random queries on it.
+     *
+     * @param race_maze The maze to build the hierarchy of.
+     * @param queries The number of random queries between free spaces.
+     * @param seed The seed of the random queries, so runs are repeatable.
+     *
+     * @return The preprocessing, memory, and latency measurements, with up to 64 queries checked against a breadth-first search.
+     */
+    template <std::unsigned_integral index_type>
+    hierarchy_result run_hierarchy_queries(const maze<index_type> &race_maze, const size_t queries, const uint64_t seed = 1);
+}
+
+////// ============== //////
+////// Implementation //////
+////// ============== //////
+
+//// --------------------- ////
+//// Contraction Hierarchy ////
+//// --------------------- ////
+
+template <std::unsigned_integral index_type>
+NPC_Racer::contraction_hierarchy<index_type>::contraction_hierarchy(const maze<index_type> &race_maze)
+{
+    const std::vector<std::array<index_type, 4>> &connected_paths = race_maze.adjacency();
+    std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+    size_t elements = race_maze.bit_maze.size();
+    ranks.assign(elements, not_contracted);
+    remaining_edges.resize(elements);
+    contracted_neighbours.assign(elements, 0);
+    witness_distances.assign(elements, unreached);
+    witness_stamps.assign(elements, 0);
+
+    std::vector<index_type> free_spaces;
+    for (size_t i = 0; i < elements; i++)
+    {
+        if (!race_maze.bit_maze[i])
+            continue;
+        free_spaces.push_back((index_type)i);
+        for (index_type neighbour : connected_paths[i])
+            if (neighbour != no_path)
+                remaining_edges[i].push_back({neighbour, no_path, 1});
+    }
+    node_count = free_spaces.size();
+
+    // ordering by lazy updates: a space's priority is recomputed when it comes up and it waits again if it got worse
+    std::vector<int64_t> priorities(elements, 0);
+    std::vector<std::pair<int64_t, index_type>> order;
+    order.reserve(free_spaces.size());
+    for (index_type space : free_spaces)
+    {
+        priorities[space] = contraction_priority(space);
+        order.push_back({priorities[space], space});
+    }
+    auto contracted_later = std::greater<std::pair<int64_t, index_type>>();
+    std::make_heap(order.begin(), order.end(), contracted_later);
+
+    // every space keeps its edges to the spaces contracted after it, which are the ones still remaining when it's contracted
+    std::vector<std::vector<upward_edge>> edges_up(elements);
+    uint32_t rank = 0;
+    while (!order.empty())
+    {
+        std::pop_heap(order.begin(), order.end(), contracted_later);
+        auto [priority, node] = order.back();
+        order.pop_back();
+        if ((ranks[node] != not_contracted) or (priority != priorities[node])) // an outdated entry
+            continue;
+        priorities[node] = contraction_priority(node);
+        if (!order.empty() and (priorities[node] > order.front().first))
+        {
+            order.push_back({priorities[node], node});
+            std::push_heap(order.begin(), order.end(), contracted_later);
+            continue;
+        }
+
+        contract_node(node, false, 1000);
+        ranks[node] = rank++;
+        edges_up[node] = std::move(remaining_edges[node]);
+        for (const upward_edge &edge : edges_up[node])
+        {
+            // the neighbours forget the contracted space and are reconsidered now that their edges changed
+            std::vector<upward_edge> &neighbour_edges = remaining_edges[edge.target];
+            for (size_t i = 0; i < neighbour_edges.size(); i++)
+                if (neighbour_edges[i].target == node)
+                {
+                    neighbour_edges[i] = neighbour_edges.back();
+                    neighbour_edges.pop_back();
+                    break;
+                }
+            contracted_neighbours[edge.target]++;
+            priorities[edge.target] = contraction_priority(edge.target);
+            order.push_back({priorities[edge.target], edge.target});
+            std::push_heap(order.begin(), order.end(), contracted_later);
+        }
+    }
+
+    // flattening the upward edges into one array, which is all the queries read
+    first_edges.assign(elements + 1, 0);
+    for (size_t i = 0; i < elements; i++)
+        first_edges[i + 1] = first_edges[i] + edges_up[i].size();
+    upward_edges.reserve(first_edges[elements]);
+    for (size_t i = 0; i < elements; i++)
+        for (const upward_edge &edge : edges_up[i])
+        {
+            upward_edges.push_back(edge);
+            if (edge.middle != no_path)
+                shortcut_count++;
+        }
+
+    // the contraction scratch is done with, the query scratch is allocated once here
+    remaining_edges = std::vector<std::vector<upward_edge>>();
+    contracted_neighbours = std::vector<uint32_t>();
+    witness_distances = std::vector<uint32_t>();
+    witness_stamps = std::vector<uint32_t>();
+    for (size_t direction = 0; direction < 2; direction++)
+    {
+        query_distances[direction].assign(elements, unreached);
+        query_parents[direction].assign(elements, no_path);
+        query_stamps[direction].assign(elements, 0);
+    }
+    preprocessing_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+}
+
+template <std::unsigned_integral index_type>
+size_t NPC_Racer::contraction_hierarchy<index_type>::contract_node(const index_type node, const bool simulate, const size_t settle_limit)
+{
+    // copied since adding shortcuts can add to the neighbours' edge lists while they're read
+    std::vector<upward_edge> neighbours = remaining_edges[node];
+    size_t shortcuts_added = 0;
+    for (size_t i = 0; i < neighbours.size(); i++)
+    {
+        uint32_t longest_through = 0;
+        for (size_t j = i + 1; j < neighbours.size(); j++)
+            longest_through = std::max(longest_through, neighbours[i].weight + neighbours[j].weight);
+        if (longest_through == 0) // the last neighbour, every pair with it was already checked
+            continue;
+
+        // a shortcut is only needed if there isn't a path at least as short that avoids the contracted space
+        witness_search(neighbours[i].target, node, longest_through, settle_limit);
+        for (size_t j = i + 1; j < neighbours.size(); j++)
+        {
+            uint32_t through = neighbours[i].weight + neighbours[j].weight;
+            index_type other = neighbours[j].target;
+            if ((witness_stamps[other] == witness_stamp) and (witness_distances[other] <= through))
+                continue;
+            shortcuts_added++;
+            if (!simulate)
+                add_shortcut(neighbours[i].target, other, node, through);
+        }
+    }
+    return shortcuts_added;
+}
+
+template <std::unsigned_integral index_type>
+void NPC_Racer::contraction_hierarchy<index_type>::witness_search(const index_type source, const index_type skipped, const uint32_t max_distance, const size_t settle_limit)
+{
+    std::vector<std::pair<uint32_t, index_type>> &frontier = frontiers[0];
+    auto expanded_later = std::greater<std::pair<uint32_t, index_type>>();
+    witness_stamp++;
+    frontier.clear();
+    witness_stamps[source] = witness_stamp;
+    witness_distances[source] = 0;
+    frontier.push_back({0, source});
+
+    size_t settled = 0;
+    while (!frontier.empty() and (settled < settle_limit))
+    {
+        std::pop_heap(frontier.begin(), frontier.end(), expanded_later);
+        auto [distance, space] = frontier.back();
+        frontier.pop_back();
+        if (distance > witness_distances[space])
+            continue;
+        if (distance > max_distance)
+            break;
+        settled++;
+        for (const upward_edge &edge : remaining_edges[space])
+        {
+            if (edge.target == skipped)
+                continue;
+            uint32_t next_distance = distance + edge.weight;
+            if ((witness_stamps[edge.target] != witness_stamp) or (next_distance < witness_distances[edge.target]))
+            {
+                witness_stamps[edge.target] = witness_stamp;
+                witness_distances[edge.target] = next_distance;
+                frontier.push_back({next_distance, edge.target});
+                std::push_heap(frontier.begin(), frontier.end(), expanded_later);
+            }
+        }
+    }
+}
+
+template <std::unsigned_integral index_type>
+void NPC_Racer::contraction_hierarchy<index_type>::add_shortcut(const index_type from, const index_type to, const index_type middle, const uint32_t weight)
+{
+    // the graph is undirected so the shortcut is added from both ends
+    for (auto [owner, target] : {std::pair<index_type, index_type>{from, to}, std::pair<index_type, index_type>{to, from}})
+    {
+        bool replaced = false;
+        for (upward_edge &edge : remaining_edges[owner])
+            if (edge.target == target)
+            {
+                if (weight < edge.weight)
+                    edge = {target, middle, weight};
+                replaced = true;
+                break;
+            }
+        if (!replaced)
+            remaining_edges[owner].push_back({target, middle, weight});
+    }
+}
+
+template <std::unsigned_integral index_type>
+int64_t NPC_Racer::contraction_hierarchy<index_type>::contraction_priority(const index_type node)
+{
+    int64_t shortcuts_needed = (int64_t)contract_node(node, true, 50);
+    return shortcuts_needed - (int64_t)remaining_edges[node].size() + (int64_t)contracted_neighbours[node];
+}
+
+template <std::unsigned_integral index_type>
+const typename NPC_Racer::contraction_hierarchy<index_type>::upward_edge &NPC_Racer::contraction_hierarchy<index_type>::find_edge(const index_type first, const index_type second) const
+{
+    index_type lower = (ranks[first] < ranks[second]) ? first : second;
+    index_type higher = (lower == first) ? second : first;
+    size_t edge = first_edges[lower];
+    while (upward_edges[edge].target != higher)
+        edge++;
+    return upward_edges[edge];
+}
+
+template <std::unsigned_integral index_type>
+void NPC_Racer::contraction_hierarchy<index_type>::unpack_edge(const index_type from, const index_type to, std::vector<index_type> &path)
+{
+    // a stack instead of recursion since a long corridor can be shortcuts nested hundreds deep
+    unpack_stack.clear();
+    unpack_stack.push_back({from, to});
+    while (!unpack_stack.empty())
+    {
+        auto [first, second] = unpack_stack.back();
+        unpack_stack.pop_back();
+        index_type middle = find_edge(first, second).middle;
+        if (middle == no_path)
+        {
+            path.push_back(second);
+            continue;
+        }
+        unpack_stack.push_back({middle, second}); // the second half is unpacked after the first
+        unpack_stack.push_back({first, middle});
+    }
+}
+
+template <std::unsigned_integral index_type>
+bool NPC_Racer::contraction_hierarchy<index_type>::query(const index_type source, const index_type destination, std::vector<index_type> &path)
+{
+    path.clear();
+    settled_nodes = 0;
+    if ((source >= ranks.size()) or (destination >= ranks.size()) or (ranks[source] == not_contracted) or (ranks[destination] == not_contracted))
+        return false;
+    if (source == destination)
+    {
+        path.push_back(source);
+        return true;
+    }
+
+    // both searches only follow edges up the order, the shortest path's highest space is where they meet
+    query_stamp++;
+    auto expanded_later = std::greater<std::pair<uint32_t, index_type>>();
+    std::array<index_type, 2> ends = {source, destination};
+    for (size_t direction = 0; direction < 2; direction++)
+    {
+        frontiers[direction].clear();
+        frontiers[direction].push_back({0, ends[direction]});
+        query_stamps[direction][ends[direction]] = query_stamp;
+        query_distances[direction][ends[direction]] = 0;
+        query_parents[direction][ends[direction]] = no_path;
+    }
+
+    uint32_t best_distance = unreached;
+    index_type meeting_node = no_path;
+    while (true)
+    {
+        // expanding whichever direction has the closer space next, until neither can beat the best path
+        uint32_t forward_next = frontiers[0].empty() ? unreached : frontiers[0].front().first;
+        uint32_t backward_next = frontiers[1].empty() ? unreached : frontiers[1].front().first;
+        if (std::min(forward_next, backward_next) >= best_distance)
+            break;
+        size_t direction = (forward_next <= backward_next) ? 0 : 1;
+        std::vector<std::pair<uint32_t, index_type>> &frontier = frontiers[direction];
+        std::pop_heap(frontier.begin(), frontier.end(), expanded_later);
+        auto [distance, space] = frontier.back();
+        frontier.pop_back();
+        if (distance > query_distances[direction][space])
+            continue;
+        settled_nodes++;
+
+        size_t other = 1 - direction;
+        if ((query_stamps[other][space] == query_stamp) and (distance + query_distances[other][space] < best_distance))
+        {
+            best_distance = distance + query_distances[other][space];
+            meeting_node = space;
+        }
+
+        for (size_t edge = first_edges[space]; edge < first_edges[space + 1]; edge++)
+        {
+            const upward_edge &up = upward_edges[edge];
+            uint32_t next_distance = distance + up.weight;
+            if ((query_stamps[direction][up.target] != query_stamp) or (next_distance < query_distances[direction][up.target]))
+            {
+                query_stamps[direction][up.target] = query_stamp;
+                query_distances[direction][up.target] = next_distance;
+                query_parents[direction][up.target] = space;
+                frontier.push_back({next_distance, up.target});
+                std::push_heap(frontier.begin(), frontier.end(), expanded_later);
+            }
+        }
+    }
+    if (meeting_node == no_path)
+        return false;
+
+    // the spaces up to the meeting space from the source, reversed, then down from it to the destination
+    hierarchy_path.clear();
+    for (index_type space = meeting_node; space != no_path; space = query_parents[0][space])
+        hierarchy_path.push_back(space);
+    std::reverse(hierarchy_path.begin(), hierarchy_path.end());
+    for (index_type space = query_parents[1][meeting_node]; space != no_path; space = query_parents[1][space])
+        hierarchy_path.push_back(space);
+
+    // unpacking each edge of the hierarchy path into the moves it stands for
+    const std::vector<index_type> &spaces = hierarchy_path;
+    path.reserve((size_t)best_distance + 1);
+    path.push_back(spaces[0]);
+    for (size_t i = 1; i < spaces.size(); i++)
+        unpack_edge(spaces[i - 1], spaces[i], path);
+    return true;
+}
+
+template <std::unsigned_integral index_type>
+size_t NPC_Racer::contraction_hierarchy<index_type>::memory_bytes() const
+{
+    size_t bytes = sizeof(contraction_hierarchy) + ranks.capacity() * sizeof(uint32_t) + first_edges.capacity() * sizeof(size_t) +
+                   upward_edges.capacity() * sizeof(upward_edge);
+    for (size_t direction = 0; direction < 2; direction++)
+        bytes += query_distances[direction].capacity() * sizeof(uint32_t) + query_parents[direction].capacity() * sizeof(index_type) +
+                 query_stamps[direction].capacity() * sizeof(uint32_t) + frontiers[direction].capacity() * sizeof(std::pair<uint32_t, index_type>);
+    return bytes;
+}
+
+//// --------- ////
+//// Functions ////
+//// --------- ////
+
+template <std::unsigned_integral index_type>
+NPC_Racer::hierarchy_result NPC_Racer::run_hierarchy_queries(const maze<index_type> &race_maze, const size_t queries, const uint64_t seed /* 1 */)
+{
+    contraction_hierarchy<index_type> hierarchy(race_maze);
+    hierarchy_result result;
+    result.preprocessing_seconds = hierarchy.preprocessing_time;
+    result.nodes = hierarchy.nodes();
+    result.edges = hierarchy.edges();
+    result.shortcuts = hierarchy.shortcuts();
+    result.shortcut_bytes = hierarchy.shortcuts() * sizeof(typename contraction_hierarchy<index_type>::upward_edge);
+    result.memory_bytes = hierarchy.memory_bytes();
+
+    std::vector<index_type> path;
+    if (hierarchy.query(race_maze.start_position, race_maze.destination_position, path))
+        result.race_path_size = path.size();
+
+    std::vector<index_type> free_positions;
+    for (size_t i = 0; i < race_maze.bit_maze.size(); i++)
+        if (race_maze.bit_maze[i])
+            free_positions.push_back((index_type)i);
+    if (free_positions.empty())
+        return result;
+    std::mt19937_64 generator(seed);
+    std::uniform_int_distribution<size_t> pick(0, free_positions.size() - 1);
+
+    // the checked queries also time a breadth-first search, the fastest search without preprocessing on a maze
+    const std::vector<std::array<index_type, 4>> &connected_paths = race_maze.adjacency();
+    constexpr size_t checked_queries = 64;
+    std::vector<index_type> search_distances(race_maze.bit_maze.size());
+    std::vector<index_type> search_queue;
+    search_queue.reserve(free_positions.size());
+    for (size_t query = 0; query < queries; query++)
+    {
+        index_type source = free_positions[pick(generator)];
+        index_type destination = free_positions[pick(generator)];
+        std::chrono::steady_clock::time_point query_start = std::chrono::steady_clock::now();
+        bool found = hierarchy.query(source, destination, path);
+        result.latencies.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - query_start).count());
+        result.nodes_settled += hierarchy.last_settled();
+        if (query >= checked_queries)
+            continue;
+
+        std::chrono::steady_clock::time_point search_start = std::chrono::steady_clock::now();
+        std::fill(search_distances.begin(), search_distances.end(), maze<index_type>::no_path);
+        search_queue.clear();
+        search_queue.push_back(source);
+        search_distances[source] = 0;
+        for (size_t front = 0; (front < search_queue.size()) and (search_queue[front] != destination); front++)
+            for (index_type next : connected_paths[search_queue[front]])
+                if ((next != maze<index_type>::no_path) and (search_distances[next] == maze<index_type>::no_path))
+                {
+                    search_distances[next] = (index_type)(search_distances[search_queue[front]] + 1);
+                    search_queue.push_back(next);
+                }
+        result.search_latencies.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - search_start).count());
+
+        // the path has to be as short as the search's and every move has to be between neighbours
+        bool reachable = (search_distances[destination] != maze<index_type>::no_path);
+        bool valid = (found == reachable) and (!found or ((path.size() == (size_t)search_distances[destination] + 1) and (path.front() == source) and (path.back() == destination)));
+        for (size_t i = 1; valid and (i < path.size()); i++)
+        {
+            const std::array<index_type, 4> &neighbours = connected_paths[path[i - 1]];
+            valid = std::find(neighbours.begin(), neighbours.end(), path[i]) != neighbours.end();
+        }
+        if (!valid)
+            result.mismatches++;
+    }
+    return result;
+}
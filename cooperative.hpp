@@ -0,0 +1,771 @@
+/**
+ * @file cooperative.hpp
+ * @author Brendan Fallon (fallonbr@mcmaster.ca) (https://github.com/bren007pie)
+ * @brief This module contains cooperative pathfinding: many agents planning windowed space-time A* paths against a shared reservation table so they never collide.
+ * @version 1.0
+ * @date Sunday October 18, 2026
+ * @copyright Copyright (c) 2022 Brendan Fallon
+ */
+
+//// Preprocessor Directives ////
+#pragma once
+#include <vector>    // std::vector
+#include <array>     // std::array
+#include <algorithm> // std::push_heap, std::pop_heap, std::shuffle, std::min, std::max
+#include <chrono>    // std::chrono::steady_clock
+#include <random>    // std::mt19937_64
+#include <utility>   // std::pair
+#include <limits>    // std::numeric_limits
+#include <cstdint>   // uint32_t, uint64_t
+#include <concepts>  // std::unsigned_integral
+#include "mazes.hpp" // NPC_Racer::maze
+
+////// ========= //////
+////// Interface //////
+////// ========= //////
+
+namespace NPC_Racer
+{
+    //// ------- ////
+    //// Structs ////
+    //// ------- ////
+    /**
+     * @brief The outcome of a group of agents pathfinding cooperatively to their destinations.
+     *
+     * @tparam index_type The unsigned integer type used for the maze indices.
+     */
+    template <std::unsigned_integral index_type>
+    struct cooperative_result
+    {
+        /**
+         * @param trajectories The position of each agent at every tick, starting at its start.
+         */
+        std::vector<std::vector<index_type>> trajectories;
+
+        /**
+         * @param ticks The number of ticks until every agent arrived, or the tick limit.
+         */
+        uint64_t ticks = 0;
+
+        /**
+         * @param arrived The number of agents on their destination at the end.
+         */
+        size_t arrived = 0;
+
+        /**
+         * @param distance_seconds The time spent on each agent's first reverse search, from its destination until it reaches its start, before the first tick.
+         */
+        double distance_seconds = 0;
+
+        /**
+         * @param planning_seconds The total time spent planning the windows, including resuming the reverse searches but not moving the agents.
+         */
+        double planning_seconds = 0;
+
+        /**
+         * @param heuristic_positions The positions the reverse searches of every agent hold a distance for at the end, the memory of the heuristics.
+         */
+        uint64_t heuristic_positions = 0;
+
+        /**
+         * @param plans The number of windowed plans made, one per agent per replanning tick.
+         */
+        uint64_t plans = 0;
+
+        /**
+         * @param nodes_expanded The space-time nodes expanded by every plan.
+         */
+        uint64_t nodes_expanded = 0;
+
+        /**
+         * @param collisions The number of times two agents were on the same position or swapped positions, 0 unless an agent was boxed in, e.g. head on in a one-wide corridor.
+         */
+        uint64_t collisions = 0;
+    };
+
+    //// ----------------------- ////
+    //// Reservation Table Class ////
+    //// ----------------------- ////
+    /**
+     * @brief Which agent holds each maze position at each time in a sliding window of ticks.
+     *
+     * @tparam index_type The unsigned integer type used for the maze indices.
+     * @note A ring buffer of one slice of positions per tick, so the reservations checked together, the neighbours of a position at the next tick, are next to each other in memory. Each reservation stores the planning round it was made in so the table is never cleared, a new round makes every older reservation stale.
+     */
+    template <std::unsigned_integral index_type>
+    class reservation_table
+    {
+    public:
+        /**
+         * @param no_agent The agent given for a position nobody holds.
+         */
+        static constexpr uint32_t no_agent = std::numeric_limits<uint32_t>::max();
+
+        /**
+         * @brief Constructs an empty reservation table.
+         *
+         * @param positions The number of elements in the maze.
+         * @param window The number of ticks after the current one that can be reserved.
+         */
+        reservation_table(const size_t positions, const size_t window);
+
+        /**
+         * @brief Starts a planning round, dropping every reservation made before it.
+         */
+        void begin_round() { round++; }
+
+        /**
+         * @brief Gives the agent holding a position at a tick.
+         *
+         * @param position The index of the position.
+         * @param tick The tick, within the window of the current one.
+         *
+         * @return The agent, or no_agent if nobody holds it.
+         */
+        uint32_t holder(const index_type position, const uint64_t tick) const;
+
+        /**
+         * @brief Reserves a position at a tick for an agent.
+         *
+         * @param position The index of the position.
+         * @param tick The tick, within the window of the current one.
+         * @param agent The agent reserving it.
+         */
+        void reserve(const index_type position, const uint64_t tick, const uint32_t agent);
+
+        /**
+         * @brief Says whether an agent can move between two positions from one tick to the next without colliding.
+         *
+         * @param from The position at the tick.
+         * @param to The position at the next tick, the same as from to wait.
+         * @param tick The tick the move starts on.
+         * @param agent The agent moving.
+         *
+         * @return False if another agent holds the position at the next tick, or would swap positions with the agent.
+         */
+        bool can_move(const index_type from, const index_type to, const uint64_t tick, const uint32_t agent) const;
+
+    private:
+        /**
+         * @brief One reservation, only held if it was made this round.
+         * @note A tick only has one slice in a round since a round covers at most the window and the current tick.
+         */
+        struct reservation
+        {
+            uint32_t round = 0;
+            uint32_t agent = no_agent;
+        };
+
+        /**
+         * @param position_count The number of positions in each slice.
+         */
+        size_t position_count;
+
+        /**
+         * @param slice_count The number of ticks held at once, the window and the current tick.
+         */
+        size_t slice_count;
+
+        /**
+         * @param slots The reservations, tick major: slots[(tick % slice_count) * position_count + position].
+         */
+        std::vector<reservation> slots;
+
+        /**
+         * @param round The current planning round, starting at 1 so the zeroed slots are stale.
+         */
+        uint32_t round = 1;
+    };
+
+    //// ------------------------------ ////
+    //// Reverse Resumable Search Class ////
+    //// ------------------------------ ////
+    /**
+     * @brief The true distance to an agent's destination, found lazily with a reverse resumable A* (RRA*) from the destination towards the agent's start.
+     *
+     * @tparam index_type The unsigned integer type used for the maze indices.
+     * @result Asking for a position the search hasn't closed yet resumes it until that position is closed. Closed positions have their
+     *      true distance since the Manhattan distance to the start never overestimates and moves cost 1.
+     * @note Only the positions the search has closed are stored, in a hash table of position and distance pairs, so its memory grows
+     *      with what the agent's plans have asked about rather than with the maze. On open maps that is a band around the agent's route,
+     *      but in a maze of dead ends it can be much of the maze, and a destination that can't reach the start is only known once its
+     *      whole area is searched.
+     */
+    template <std::unsigned_integral index_type>
+    class reverse_resumable_search
+    {
+    public:
+        /**
+         * @brief Starts a search from a destination, nothing is searched until a distance is asked for.
+         *
+         * @param search_maze The maze, kept by pointer so searches can be kept in a vector.
+         * @param destination The destination, where the search starts.
+         * @param origin The agent's start, which the search is directed towards.
+         */
+        reverse_resumable_search(const maze<index_type> &search_maze, const index_type destination, const index_type origin);
+
+        /**
+         * @brief Gives the distance from a position to the destination, resuming the search if the position isn't closed yet.
+         *
+         * @param position The index of the position.
+         *
+         * @return The number of moves, no_path if the position can't reach the destination.
+         */
+        index_type distance(const index_type position);
+
+        /**
+         * @brief Gives the number of positions the search holds a distance for.
+         */
+        size_t stored_positions() const { return closed_count; }
+
+    private:
+        /**
+         * @brief A closed position and its distance, a slot of the hash table.
+         */
+        struct closed_slot
+        {
+            index_type position = maze<index_type>::no_path; // no_path for an empty slot
+            index_type distance = 0;
+        };
+
+        /**
+         * @brief A position on the open list.
+         */
+        struct open_node
+        {
+            uint64_t estimate; // distance plus the Manhattan distance to the origin
+            index_type distance;
+            index_type position;
+        };
+
+        /**
+         * @brief Orders the open heap so the lowest estimate, then the furthest from the destination, is on top.
+         */
+        static bool expanded_later(const open_node &first, const open_node &second)
+        {
+            return (first.estimate > second.estimate) or ((first.estimate == second.estimate) and (first.distance < second.distance));
+        }
+
+        /**
+         * @param searched_maze The maze searched.
+         */
+        const maze<index_type> *searched_maze;
+
+        /**
+         * @param origin_row The row of the agent's start.
+         */
+        size_t origin_row;
+
+        /**
+         * @param origin_column The column of the agent's start.
+         */
+        size_t origin_column;
+
+        /**
+         * @param open The open list as a binary heap, a position can be on it more than once and only its first copy is expanded.
+         */
+        std::vector<open_node> open;
+
+        /**
+         * @param closed_slots The closed positions, an open addressing hash table with linear probing, its size a power of two and at most half full.
+         */
+        std::vector<closed_slot> closed_slots;
+
+        /**
+         * @param closed_count The number of closed positions.
+         */
+        size_t closed_count = 0;
+
+        /**
+         * @brief Finds the slot of a position, or the empty slot it would go in.
+         */
+        closed_slot &find_slot(const index_type position);
+
+        /**
+         * @brief Gives the Manhattan distance of a position to the origin, the heuristic of the reverse search.
+         */
+        uint64_t origin_distance(const index_type position) const;
+    };
+
+    //// -------------------------- ////
+    //// Cooperative Planner Class ////
+    //// -------------------------- ////
+    /**
+     * @brief Plans paths for many agents on one maze with windowed hierarchical cooperative A* (WHCA*).
+     *
+     * @tparam index_type The unsigned integer type used for the maze indices.
+     * @result Each agent in turn runs a space-time A* for the next window of ticks, avoiding the positions the agents before it reserved, then reserves its own plan. Agents move along their plans and replan every replan_interval ticks.
+     * @note Agents are planned in a fixed order so the first has priority. The heuristic is the true distance to each agent's destination, since the Manhattan distance leads windowed searches into dead ends.
+     *      It comes from a reverse_resumable_search per agent that only searches as far as the agent's plans ask, so thousands of agents don't each need a distance for every maze element.
+     */
+    template <std::unsigned_integral index_type>
+    class cooperative_planner
+    {
+    public:
+        /**
+         * @brief Constructs a planner for a maze, allocating all of its scratch memory.
+         *
+         * @param shared_maze The maze the agents move on, kept by reference.
+         * @param plan_window The number of ticks each agent plans ahead.
+         * @param replan_ticks The number of ticks the agents move before replanning, 0 for half the window.
+         */
+        cooperative_planner(const maze<index_type> &shared_maze, const size_t plan_window = 16, const size_t replan_ticks = 0);
+
+        /**
+         * @brief Moves a group of agents to their destinations without collisions.
+         *
+         * @param agents The start and destination of each agent, all starts and all destinations must be different free positions.
+         * @param max_ticks The tick limit, agents that haven't arrived by then are left where they are. 0 for four times the longest distance of an agent to its destination plus a window.
+         *
+         * @return The trajectories of the agents and how long the planning took.
+         * @note Agents that can't reach their destination wait where they are and aren't waited for.
+         */
+        cooperative_result<index_type> run(const std::vector<std::pair<index_type, index_type>> &agents, const uint64_t max_ticks = 0);
+
+    private:
+        //// Private Member Functions ////
+        /**
+         * @brief Plans one agent's next window of ticks against the reservations of the agents planned before it, then reserves it.
+         *
+         * @param agent The agent, its priority.
+         * @param position The position of the agent at the current tick.
+         * @param distances The agent's reverse search, giving the distance of a position to its destination.
+         * @param now The current tick.
+         * @param plan Replaced by the position of the agent at each tick from now to the end of the window.
+         *
+         * @return The number of space-time nodes expanded.
+         */
+        uint64_t plan_agent(const uint32_t agent, const index_type position, const index_type destination, reverse_resumable_search<index_type> &distances, const uint64_t now, std::vector<index_type> &plan);
+
+        /**
+         * @brief A space-time node on the A* frontier.
+         */
+        struct frontier_node
+        {
+            uint32_t estimate;  // ticks so far plus the heuristic
+            uint32_t heuristic; // breaks ties towards the destination
+            uint32_t depth;     // ticks after now
+            index_type position;
+        };
+
+        /**
+         * @brief Orders the frontier heap so the node with the lowest estimate, then the closest, is on top.
+         */
+        static bool expanded_later(const frontier_node &first, const frontier_node &second)
+        {
+            return (first.estimate > second.estimate) or ((first.estimate == second.estimate) and (first.heuristic > second.heuristic));
+        }
+
+        //// Data Members ////
+
+        /**
+         * @param planning_maze The maze the agents move on.
+         */
+        const maze<index_type> &planning_maze;
+
+        /**
+         * @param window The number of ticks each agent plans ahead.
+         */
+        size_t window;
+
+        /**
+         * @param replan_interval The number of ticks the agents move before replanning.
+         */
+        size_t replan_interval;
+
+        /**
+         * @param reservations The positions the agents hold over the window.
+         */
+        reservation_table<index_type> reservations;
+
+        //// Scratch Arrays ////
+        // sized once for every space-time node in the window so planning never allocates
+
+        /**
+         * @param frontier The A* frontier as a binary heap, cleared between plans keeping its capacity.
+         */
+        std::vector<frontier_node> frontier;
+
+        /**
+         * @param visited_stamps The plan that last expanded each space-time node, so nothing is cleared between plans.
+         */
+        std::vector<uint64_t> visited_stamps;
+
+        /**
+         * @param previous_positions The position each space-time node was reached from at the tick before.
+         */
+        std::vector<index_type> previous_positions;
+
+        /**
+         * @param plan_stamp The number of plans made, the stamp of the current one.
+         */
+        uint64_t plan_stamp = 0;
+
+        /**
+         * @param heuristics The reverse search of each agent, its heuristic.
+         */
+        std::vector<reverse_resumable_search<index_type>> heuristics;
+    };
+
+    //// --------- ////
+    //// Functions ////
+    //// --------- ////
+    /**
+     * @brief Times cooperative planning for growing numbers of agents between random free positions.
+     *
+     * @param race_maze The maze to plan on.
+     * @param max_agents The most agents, the counts run are powers of two up to it and it.
+     * @param window The number of ticks each agent plans ahead.
+     * @param seed The seed of the random starts and destinations, so runs are repeatable.
+     *
+     * @return One result per agent count, the agent count is its number of trajectories.
+     */
+    template <std::unsigned_integral index_type>
+    std::vector<cooperative_result<index_type>> run_cooperative_scaling(const maze<index_type> &race_maze, const size_t max_agents, const size_t window, const uint64_t seed = 1);
+}
+
+////// ============== //////
+////// Implementation //////
+////// ============== //////
+
+//// ----------------- ////
+//// Reservation Table ////
+//// ----------------- ////
+
+template <std::unsigned_integral index_type>
+NPC_Racer::reservation_table<index_type>::reservation_table(const size_t positions, const size_t window)
+    : position_count(positions), slice_count(window + 1), slots(positions * (window + 1))
+{
+}
+
+template <std::unsigned_integral index_type>
+uint32_t NPC_Racer::reservation_table<index_type>::holder(const index_type position, const uint64_t tick) const
+{
+    const reservation &slot = slots[(tick % slice_count) * position_count + position];
+    return (slot.round == round) ? slot.agent : no_agent; // reservations from earlier rounds are stale
+}
+
+template <std::unsigned_integral index_type>
+void NPC_Racer::reservation_table<index_type>::reserve(const index_type position, const uint64_t tick, const uint32_t agent)
+{
+    slots[(tick % slice_count) * position_count + position] = {round, agent};
+}
+
+template <std::unsigned_integral index_type>
+bool NPC_Racer::reservation_table<index_type>::can_move(const index_type from, const index_type to, const uint64_t tick, const uint32_t agent) const
+{
+    uint32_t next_holder = holder(to, tick + 1);
+    if ((next_holder != no_agent) and (next_holder != agent)) // someone will be there
+        return false;
+    if (from == to)
+        return true;
+
+    // two agents swapping positions would pass through each other
+    uint32_t current_holder = holder(to, tick);
+    return (current_holder == no_agent) or (current_holder == agent) or (holder(from, tick + 1) != current_holder);
+}
+
+//// ------------------------ ////
+//// Reverse Resumable Search ////
+//// ------------------------ ////
+
+template <std::unsigned_integral index_type>
+NPC_Racer::reverse_resumable_search<index_type>::reverse_resumable_search(const maze<index_type> &search_maze, const index_type destination, const index_type origin)
+    : searched_maze(&search_maze), origin_row(origin / search_maze.columns()), origin_column(origin % search_maze.columns()), closed_slots(16)
+{
+    open.push_back({origin_distance(destination), 0, destination});
+}
+
+template <std::unsigned_integral index_type>
+index_type NPC_Racer::reverse_resumable_search<index_type>::distance(const index_type position)
+{
+    constexpr index_type no_path = maze<index_type>::no_path;
+    const closed_slot &known = find_slot(position);
+    if (known.position != no_path)
+        return known.distance;
+
+    // resuming until the position is closed, moves are the same both ways so this is the distance from it
+    const std::vector<std::array<index_type, 4>> &connected_paths = searched_maze->adjacency();
+    while (!open.empty())
+    {
+        std::pop_heap(open.begin(), open.end(), expanded_later);
+        open_node current = open.back();
+        open.pop_back();
+        closed_slot &slot = find_slot(current.position);
+        if (slot.position != no_path) // a copy closed earlier with a shorter distance
+            continue;
+        slot = {current.position, current.distance};
+
+        // keeping the table at most half full so probes stay short
+        if (++closed_count * 2 > closed_slots.size())
+        {
+            std::vector<closed_slot> old_slots(closed_slots.size() * 2);
+            old_slots.swap(closed_slots);
+            for (const closed_slot &old_slot : old_slots)
+                if (old_slot.position != no_path)
+                    find_slot(old_slot.position) = old_slot;
+        }
+
+        for (index_type next : connected_paths[current.position])
+            if ((next != no_path) and (find_slot(next).position == no_path))
+            {
+                open.push_back({current.distance + 1 + origin_distance(next), (index_type)(current.distance + 1), next});
+                std::push_heap(open.begin(), open.end(), expanded_later);
+            }
+
+        if (current.position == position)
+            return current.distance;
+    }
+    return no_path; // searched everything that can reach the destination
+}
+
+template <std::unsigned_integral index_type>
+typename NPC_Racer::reverse_resumable_search<index_type>::closed_slot &NPC_Racer::reverse_resumable_search<index_type>::find_slot(const index_type position)
+{
+    size_t mask = closed_slots.size() - 1;
+    size_t slot = ((uint64_t)position * 0x9E3779B97F4A7C15) >> 32 & mask; // Fibonacci hashing spreads neighbouring positions apart
+    while ((closed_slots[slot].position != position) and (closed_slots[slot].position != maze<index_type>::no_path))
+        slot = (slot + 1) & mask;
+    return closed_slots[slot];
+}
+
+template <std::unsigned_integral index_type>
+uint64_t NPC_Racer::reverse_resumable_search<index_type>::origin_distance(const index_type position) const
+{
+    size_t row = position / searched_maze->columns(), column = position % searched_maze->columns();
+    return (std::max(row, origin_row) - std::min(row, origin_row)) + (std::max(column, origin_column) - std::min(column, origin_column));
+}
+
+//// ------------------- ////
+//// Cooperative Planner ////
+//// ------------------- ////
+
+template <std::unsigned_integral index_type>
+NPC_Racer::cooperative_planner<index_type>::cooperative_planner(const maze<index_type> &shared_maze, const size_t plan_window, const size_t replan_ticks)
+    : planning_maze(shared_maze), window(std::max<size_t>(1, plan_window)),
+      replan_interval((replan_ticks == 0) ? std::max<size_t>(1, window / 2) : std::min(replan_ticks, window)),
+      reservations(shared_maze.bit_maze.size(), window)
+{
+    size_t space_time_nodes = planning_maze.bit_maze.size() * (window + 1);
+    visited_stamps.assign(space_time_nodes, 0);
+    previous_positions.assign(space_time_nodes, 0);
+    frontier.reserve(planning_maze.bit_maze.size());
+}
+
+template <std::unsigned_integral index_type>
+NPC_Racer::cooperative_result<index_type> NPC_Racer::cooperative_planner<index_type>::run(const std::vector<std::pair<index_type, index_type>> &agents, const uint64_t max_ticks)
+{
+    cooperative_result<index_type> result;
+    size_t agent_count = agents.size();
+    result.trajectories.resize(agent_count);
+    std::vector<index_type> positions(agent_count);
+    for (size_t i = 0; i < agent_count; i++)
+    {
+        positions[i] = agents[i].first;
+        result.trajectories[i].assign(1, agents[i].first);
+    }
+    std::vector<std::vector<index_type>> plans(agent_count);
+    constexpr index_type no_path = maze<index_type>::no_path;
+
+    // the true distances guide each agent's windowed search, each reverse search runs until it reaches the agent's start and resumes when a plan goes further
+    std::chrono::steady_clock::time_point distance_start = std::chrono::steady_clock::now();
+    heuristics.clear();
+    heuristics.reserve(agent_count);
+    std::vector<bool> reachable(agent_count);
+    uint64_t longest_distance = 0;
+    for (size_t i = 0; i < agent_count; i++)
+    {
+        heuristics.emplace_back(planning_maze, agents[i].second, agents[i].first);
+        index_type start_distance = heuristics[i].distance(agents[i].first);
+        reachable[i] = (start_distance != no_path);
+        if (reachable[i])
+            longest_distance = std::max<uint64_t>(longest_distance, start_distance);
+    }
+    result.distance_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - distance_start).count();
+    uint64_t tick_limit = (max_ticks == 0) ? 4 * longest_distance + window : max_ticks;
+
+    auto all_arrived = [&]()
+    {
+        for (size_t i = 0; i < agent_count; i++)
+            if ((positions[i] != agents[i].second) and reachable[i])
+                return false;
+        return true;
+    };
+
+    uint64_t now = 0;
+    while ((now < tick_limit) and !all_arrived())
+    {
+        // planning in priority order, each against the reservations of the ones before it
+        // every agent holds where it is now so nobody plans to swap with an agent that plans after them
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        reservations.begin_round();
+        for (size_t i = 0; i < agent_count; i++)
+            reservations.reserve(positions[i], now, (uint32_t)i);
+        for (size_t i = 0; i < agent_count; i++)
+            result.nodes_expanded += plan_agent((uint32_t)i, positions[i], agents[i].second, heuristics[i], now, plans[i]);
+        result.planning_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result.plans += agent_count;
+
+        // moving every agent along its plan until the next replan
+        size_t steps = (size_t)std::min<uint64_t>(replan_interval, tick_limit - now);
+        for (size_t step = 1; step <= steps; step++)
+            for (size_t i = 0; i < agent_count; i++)
+            {
+                positions[i] = plans[i][step];
+                result.trajectories[i].push_back(positions[i]);
+            }
+        now += steps;
+    }
+    result.ticks = now;
+    for (const reverse_resumable_search<index_type> &heuristic : heuristics)
+        result.heuristic_positions += heuristic.stored_positions();
+
+    for (size_t i = 0; i < agent_count; i++)
+        if (positions[i] == agents[i].second)
+            result.arrived++;
+
+    // checking the trajectories, marking where every agent is on this tick and the last one
+    std::array<std::vector<uint64_t>, 2> occupied_stamps;
+    std::array<std::vector<size_t>, 2> occupants;
+    for (size_t parity = 0; parity < 2; parity++)
+    {
+        occupied_stamps[parity].assign(planning_maze.bit_maze.size(), 0);
+        occupants[parity].assign(planning_maze.bit_maze.size(), 0);
+    }
+    for (uint64_t tick = 0; tick <= result.ticks; tick++)
+    {
+        size_t current = tick % 2, last = (tick + 1) % 2;
+        for (size_t i = 0; i < agent_count; i++)
+        {
+            index_type position = result.trajectories[i][tick];
+            if (occupied_stamps[current][position] == tick + 1) // two agents on the same position
+                result.collisions++;
+            else if ((tick > 0) and (occupied_stamps[last][position] == tick)) // swapped with whoever was here, counted once per pair
+            {
+                size_t other = occupants[last][position];
+                index_type previous = result.trajectories[i][tick - 1];
+                if ((other > i) and (previous != position) and (result.trajectories[other][tick] == previous))
+                    result.collisions++;
+            }
+            occupied_stamps[current][position] = tick + 1;
+            occupants[current][position] = i;
+        }
+    }
+    return result;
+}
+
+template <std::unsigned_integral index_type>
+uint64_t NPC_Racer::cooperative_planner<index_type>::plan_agent(const uint32_t agent, const index_type position, const index_type destination, reverse_resumable_search<index_type> &distances, const uint64_t now, std::vector<index_type> &plan)
+{
+    const std::vector<std::array<index_type, 4>> &connected_paths = planning_maze.adjacency();
+    constexpr index_type no_path = maze<index_type>::no_path;
+    size_t positions = planning_maze.bit_maze.size();
+    uint64_t expanded = 0;
+    plan_stamp++;
+
+    // can the agent stay on its destination from a tick to the end of the window?
+    auto can_stay = [&](const uint64_t from_tick)
+    {
+        for (uint64_t tick = from_tick + 1; tick <= now + window; tick++)
+        {
+            uint32_t holder = reservations.holder(destination, tick);
+            if ((holder != reservation_table<index_type>::no_agent) and (holder != agent))
+                return false;
+        }
+        return true;
+    };
+    auto push = [&](const index_type next, const uint32_t depth, const index_type previous)
+    {
+        size_t node = depth * positions + next;
+        if (visited_stamps[node] == plan_stamp)
+            return;
+        previous_positions[node] = previous;
+        index_type distance = distances.distance(next);
+        if (distance == no_path) // can't reach the destination from there
+            return;
+        uint32_t heuristic = (uint32_t)distance; // fits since a path is never longer than the elements of a maze that can be planned on
+        frontier.push_back({depth + heuristic, heuristic, depth, next});
+        std::push_heap(frontier.begin(), frontier.end(), expanded_later);
+    };
+
+    // space-time A*, waiting in place is a move too
+    frontier.clear();
+    push(position, 0, position);
+    frontier_node end = {0, 0, 0, position}; // the deepest node expanded if the window can't be filled
+    while (!frontier.empty())
+    {
+        std::pop_heap(frontier.begin(), frontier.end(), expanded_later);
+        frontier_node current = frontier.back();
+        frontier.pop_back();
+        size_t node = current.depth * positions + current.position;
+        if (visited_stamps[node] == plan_stamp)
+            continue;
+        visited_stamps[node] = plan_stamp;
+        expanded++;
+
+        // done on reaching the destination for good, or the end of the window closest to it
+        if ((current.depth > end.depth) or ((current.depth == end.depth) and (current.heuristic < end.heuristic)))
+            end = current;
+        if (((current.position == destination) and can_stay(now + current.depth)) or (current.depth == window))
+            break;
+
+        uint64_t tick = now + current.depth;
+        if (reservations.can_move(current.position, current.position, tick, agent))
+            push(current.position, current.depth + 1, current.position);
+        for (size_t i = 0; i < 4; i++)
+        {
+            index_type next = connected_paths[current.position][i];
+            if ((next != no_path) and reservations.can_move(current.position, next, tick, agent))
+                push(next, current.depth + 1, current.position);
+        }
+    }
+
+    // backtracking the plan, then waiting at its end for the rest of the window
+    // if the agent was boxed in before the end of the window it waits where it got to and may collide
+    plan.assign(window + 1, end.position);
+    index_type backtrack = end.position;
+    for (size_t depth = end.depth; depth > 0; depth--)
+    {
+        plan[depth] = backtrack;
+        backtrack = previous_positions[depth * positions + backtrack];
+    }
+    plan[0] = backtrack;
+
+    for (size_t depth = 0; depth <= window; depth++)
+        reservations.reserve(plan[depth], now + depth, agent);
+    return expanded;
+}
+
+//// --------- ////
+//// Functions ////
+//// --------- ////
+
+template <std::unsigned_integral index_type>
+std::vector<NPC_Racer::cooperative_result<index_type>> NPC_Racer::run_cooperative_scaling(const maze<index_type> &race_maze, const size_t max_agents, const size_t window, const uint64_t seed /* 1 */)
+{
+    // every agent needs its own start and destination
+    std::vector<index_type> free_positions;
+    for (size_t i = 0; i < race_maze.bit_maze.size(); i++)
+        if (race_maze.bit_maze[i])
+            free_positions.push_back((index_type)i);
+    std::mt19937_64 generator(seed);
+    std::shuffle(free_positions.begin(), free_positions.end(), generator);
+    size_t agent_limit = std::min(max_agents, free_positions.size() / 2);
+
+    std::vector<size_t> agent_counts;
+    for (size_t agent_count = 1; agent_count <= agent_limit; agent_count *= 2)
+        agent_counts.push_back(agent_count);
+    if (!agent_counts.empty() and (agent_counts.back() != agent_limit))
+        agent_counts.push_back(agent_limit);
+
+    std::vector<cooperative_result<index_type>> results;
+    cooperative_planner<index_type> planner(race_maze, window);
+    for (size_t agent_count : agent_counts)
+    {
+        std::vector<std::pair<index_type, index_type>> agents(agent_count);
+        for (size_t i = 0; i < agent_count; i++)
+            agents[i] = {free_positions[i], free_positions[agent_limit + i]};
+        results.push_back(planner.run(agents));
+    }
+    return results;
+}
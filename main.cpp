@@ -8,12 +8,64 @@
  */
 
 //// Preprocessor Directives ////
-#include <iostream>       // std::cout
+#include <iostream>       // std::cout, std::cerr, std::cin, std::ostream
+#include <sstream>        // std::ostringstream
 #include <vector>         // std::vector
-#include <algorithm>      // std::min_element, std::distance
-#include "mazes.hpp"      // NPC_Racer::maze
-#include "agents.hpp"     // NPC_Racer::depth_first_agent, NPC_Racer::dijkstra_agent
-#include "timekeeper.hpp" // NPC_Racer::timekeeper, NPC_Racer::run_average, NPC_Racer::run_percentage_difference
+#include <algorithm>      // std::min_element, std::distance, std::count_if
+#include <string>         // std::string, std::to_string
+#include <limits>         // std::numeric_limits
+#include <cstdint>        // uint16_t, uint32_t, uint64_t
+#include <concepts>       // std::unsigned_integral
+#include <mutex>          // std::mutex, std::lock_guard
+#include <exception>      // std::exception
+#include <filesystem>     // std::filesystem::path
+#include <array>          // std::array
+#include <memory>         // std::unique_ptr, std::make_unique
+#include <memory_resource> // std::pmr::memory_resource, std::pmr::get_default_resource
+#include <tuple>          // std::apply
+#include <type_traits>    // std::remove_cvref_t
+#include "mazes.hpp"      // NPC_Racer::maze, NPC_Racer::index_fits, NPC_Racer::read_maze_elements
+#include "agents.hpp"     // NPC_Racer::race_agents, NPC_Racer::for_each_agent, NPC_Racer::nearest_target_agent
+#include "timekeeper.hpp" // NPC_Racer::timekeeper, NPC_Racer::summarize_run, NPC_Racer::run_percentage_difference
+#include "benchmark.hpp"  // NPC_Racer::benchmark_options, NPC_Racer::run_trials, NPC_Racer::write_results_csv, NPC_Racer::write_results_json
+#include "race_runner.hpp" // NPC_Racer::collect_maze_files, NPC_Racer::run_worker_pool, NPC_Racer::run_head_to_head
+#include "regression.hpp"  // NPC_Racer::make_suite_mazes, NPC_Racer::write_baseline, NPC_Racer::read_baseline, NPC_Racer::compare_to_baseline
+#include "trace.hpp"       // NPC_Racer::write_trace_files
+#include "path_server.hpp" // NPC_Racer::path_server
+#include "async_paths.hpp" // NPC_Racer::async_pathfinder, NPC_Racer::run_async_load
+#include "compact_path.hpp" // NPC_Racer::compact_path
+#include "cooperative.hpp"  // NPC_Racer::run_cooperative_scaling
+#include "maze_cache.hpp"   // NPC_Racer::maze_cache, NPC_Racer::maze_artifacts
+#include "contraction.hpp"  // NPC_Racer::run_hierarchy_queries
+#include "allocation.hpp"   // NPC_Racer::scratch_arena, NPC_Racer::allocation_counts
+
+/**
+ * @brief Runs a race of all the agents on one maze and prints the results.
+ *
+ * @tparam index_type The unsigned integer type used for the maze and agent indices.
+ * @param filename The maze file name of the `*.txt` or `*.csv` file.
+ * @param options The benchmark options for the number of trials, warmup runs, and outlier rejection.
+ * @param output The stream the race results are printed to.
+ * @param print_paths If true the maze and the path of each agent are printed.
+ *
+ * @return The results of each agent's run.
+ */
+template <std::unsigned_integral index_type>
+std::vector<NPC_Racer::benchmark_result> run_race(const std::string filename, const NPC_Racer::benchmark_options &options,
+                                                  std::ostream &output, const bool print_paths);
+
+/**
+ * @brief Runs a race on one maze file with the smallest index type that fits every element of the maze.
+ *
+ * @param filename The maze file name of the `*.txt` or `*.csv` file.
+ * @param options The benchmark options for the number of trials, warmup runs, and outlier rejection.
+ * @param output The stream the race results are printed to.
+ * @param print_paths If true the maze and the path of each agent are printed.
+ *
+ * @return The results of each agent's run.
+ */
+std::vector<NPC_Racer::benchmark_result> race_maze_file(const std::string filename, const NPC_Racer::benchmark_options &options,
+                                                        std::ostream &output, const bool print_paths);
 
 /**
  * @brief Runs the races of the mazes passed to the program as arguments.
@@ -21,140 +73,462 @@
 int main(int argc, char *argv[])
 {
     // Argument Parsing //
-    // for now the program can only run one race at a time.
     if (argc == 1)
     {
-        std::cout << "### Welcome to NPC Racer! ###\n"
-                  << "- The only argument is the filename of the maze.\n"
-                  << "- Make sure the maze file is in the same directory as the executable.\n"
-                  << "- For example on Windows Powershell type: \n\t .\\NPCRacer.exe 10_10_test_maze.txt \n";
+        NPC_Racer::print_usage();
         exit(EXIT_SUCCESS);
     }
-    else if (argc != 2)
+
+    NPC_Racer::benchmark_options options = NPC_Racer::parse_arguments(argc, argv);
+
+    // the regression suite races the sample mazes and the generated ones
+    if (options.suite)
     {
-        std::cout << "ERROR: More than 1 maze argument, only 1 should be given.\n"
-                  << (argc - 1) << " arguments were given.\n";
-        exit(EXIT_FAILURE);
+        NPC_Racer::make_suite_mazes();
+        options.maze_files.push_back("sample_mazes");
+        options.maze_files.push_back(NPC_Racer::suite_maze_directory);
     }
 
-    //// Race variables ////
-    size_t trials_per_run = 11; // The number of times to loop each pathfinding algorithm.
+    // directories are expanded into the mazes inside them
+    std::vector<std::string> maze_files = NPC_Racer::collect_maze_files(options.maze_files);
 
-    // Timers Setup //
-    NPC_Racer::timekeeper total_program_timer;
-    NPC_Racer::timekeeper maze_parsing_timer;
-    NPC_Racer::timekeeper depth_first_timer;
-    NPC_Racer::timekeeper dijkstra_timer;
+    // Path Server //
+    // stays running answering queries instead of racing, mazes given as arguments are loaded under their file names
+    if (options.serve)
+    {
+        std::ios::sync_with_stdio(false); // so pipelined requests are buffered and answered together
+        NPC_Racer::path_server server;
+        for (const std::string &maze_file : maze_files)
+            std::cerr << server.handle_request("load " + std::filesystem::path(maze_file).stem().string() + " " + maze_file); // stdout only carries responses
+        if (!options.socket_file.empty())
+            exit(server.serve_socket(options.socket_file) ? EXIT_SUCCESS : EXIT_FAILURE);
+        server.serve_stream(std::cin, std::cout);
+        exit(EXIT_SUCCESS);
+    }
+
+    if (maze_files.empty())
+    {
+        std::cout << "ERROR: At least 1 maze file or directory of mazes should be given.\n";
+        exit(EXIT_FAILURE);
+    }
 
+    NPC_Racer::timekeeper total_program_timer;
     total_program_timer.start(); // starting measurement of the program
 
-    // Statistics //
-    std::vector<double> depth_first_trials; // For only 11 trials don't need to reserve space
-    std::vector<double> dijkstra_trials;
-    std::vector<double> run_averages; // the average of each run stored
-    double depth_first_average;       // averages, standard deviations, and percentage differences
-    double dijkstra_average;
-    double depth_first_standard_deviation;
-    double dijkstra_standard_deviation;
-    double depth_first_percentage_difference;
-    double dijkstra_percentage_difference;
+    std::vector<NPC_Racer::benchmark_result> results;
+    if (maze_files.size() == 1)
+        results = race_maze_file(maze_files[0], options, std::cout, true);
+    else
+    {
+        // Multi-maze Races //
+        // each race prints into its own buffer so races running at the same time don't interleave their output
+        std::vector<std::vector<NPC_Racer::benchmark_result>> maze_results(maze_files.size());
+        std::mutex output_mutex;
+        NPC_Racer::run_worker_pool(maze_files.size(), options.jobs, options.pin_cores, [&](const size_t i)
+                                   {
+            std::ostringstream race_output;
+            try
+            {
+                maze_results[i] = race_maze_file(maze_files[i], options, race_output, false);
+            }
+            catch (const std::exception &error)
+            {
+                race_output << "ERROR: Race on maze `" << maze_files[i] << "` failed: " << error.what() << "\n";
+            }
+            std::lock_guard<std::mutex> output_lock(output_mutex);
+            std::cout << race_output.str(); });
+
+        // keeping the results in the order the mazes were given, not the order they finished
+        for (const std::vector<NPC_Racer::benchmark_result> &maze_result : maze_results)
+            results.insert(results.end(), maze_result.begin(), maze_result.end());
+        NPC_Racer::print_results_table(results, std::cout);
+    }
+
+    // Machine-readable Results //
+    if (!options.csv_file.empty())
+        NPC_Racer::write_results_csv(results, options.csv_file);
+    if (!options.json_file.empty())
+        NPC_Racer::write_results_json(results, options.json_file);
+
+    // Regression Suite //
+    size_t regressions = 0;
+    if (!options.compare_baseline_file.empty())
+        regressions = NPC_Racer::compare_to_baseline(results, NPC_Racer::read_baseline(options.compare_baseline_file), options.regression_threshold, std::cout);
+    if (!options.save_baseline_file.empty())
+        NPC_Racer::write_baseline(results, options.save_baseline_file);
+
+    total_program_timer.end(); // end of the program
+    std::cout << "\nTotal program time: " << total_program_timer.race_time() << " seconds\n";
+
+    if (regressions > 0) // failing so scripts and CI can catch the regression
+        exit(EXIT_FAILURE);
+}
+
+std::vector<NPC_Racer::benchmark_result> race_maze_file(const std::string filename, const NPC_Racer::benchmark_options &options,
+                                                        std::ostream &output, const bool print_paths)
+{
+    // Picking the smallest index type that fits every element of the maze //
+    // halves or quarters the memory of the graph and agent arrays compared to 64-bit indices
+    uint64_t maze_elements = NPC_Racer::read_maze_elements(filename);
+    if (NPC_Racer::index_fits<uint16_t>(maze_elements))
+        return run_race<uint16_t>(filename, options, output, print_paths);
+    else if (NPC_Racer::index_fits<uint32_t>(maze_elements))
+        return run_race<uint32_t>(filename, options, output, print_paths);
+    else
+        return run_race<uint64_t>(filename, options, output, print_paths);
+}
+
+template <std::unsigned_integral index_type>
+std::vector<NPC_Racer::benchmark_result> run_race(const std::string filename, const NPC_Racer::benchmark_options &options,
+                                                  std::ostream &output, const bool print_paths)
+{
+    // Timers Setup //
+    NPC_Racer::timekeeper maze_loading_timer;
 
     // Agent Setup //
-    NPC_Racer::depth_first_agent depth_first_racer;
-    NPC_Racer::dijkstra_agent dijkstra_racer;
+    // one of each registered agent, add new agents to NPC_Racer::race_agents instead of here
+    constexpr size_t agent_count = NPC_Racer::race_agents::size;
+    // with --arena each agent gets its own scratch arena, reset before every search, instead of keeping its arrays on the heap
+    std::array<NPC_Racer::scratch_arena, agent_count> arenas;
+    std::array<std::pmr::memory_resource *, agent_count> scratch_resources;
+    for (size_t i = 0; i < agent_count; i++)
+        scratch_resources[i] = options.scratch_arenas ? &arenas[i] : std::pmr::get_default_resource();
+    typename NPC_Racer::race_agents::template agents<index_type> racers = NPC_Racer::race_agents::make_agents<index_type>(scratch_resources);
+    NPC_Racer::for_each_agent(racers, [&](auto &racer, const size_t)
+                              {
+        if constexpr (requires { racer.memory_limit; })
+            racer.memory_limit = options.memory_limit; });
+
+    // Statistics //
+    std::array<NPC_Racer::run_measurements, agent_count> measurements;
+    std::array<NPC_Racer::run_statistics, agent_count> statistics;
+    std::array<double, agent_count> percentage_differences;
+    std::vector<NPC_Racer::benchmark_result> results(agent_count);
 
     // Parsing Maze //
-    maze_parsing_timer.start();
-    NPC_Racer::maze race_maze(argv[1]); // parsing the maze based on the argument given.
-    maze_parsing_timer.end();
-    std::cout << race_maze; // printing it out
+    // restored from the cache when one is given, otherwise parsed based on the argument given
+    NPC_Racer::maze_artifacts<index_type> artifacts;
+    std::unique_ptr<NPC_Racer::maze<index_type>> loaded_maze;
+    bool cache_hit = false;
+    double cache_restore_time = 0.0;
+    maze_loading_timer.start();
+    if (options.cache_directory.empty())
+        loaded_maze = std::make_unique<NPC_Racer::maze<index_type>>(filename);
+    else
+    {
+        NPC_Racer::maze_cache cache(options.cache_directory);
+        loaded_maze = cache.load(filename, artifacts);
+        cache_hit = cache.last_load_hit();
+        cache_restore_time = cache.last_restore_time();
+    }
+    NPC_Racer::maze<index_type> &race_maze = *loaded_maze;
+    race_maze.adjacency(); // building the graph now so it's timed apart from the first trial
+    maze_loading_timer.end();
+    if (print_paths)
+        output << race_maze; // printing it out
+    output << "Using " << (sizeof(index_type) * 8) << "-bit indices.\n";
 
     //// Runs ////
-    // Depth-first Pathfinding //
-    std::cout << "Running depth-first search pathfinding.\n";
-    for (size_t i = 0; i < trials_per_run; i++)
-    {
-        depth_first_timer.start();
-        depth_first_racer.pathfind(race_maze); // doing the pathfinding
-        depth_first_timer.end();
-        depth_first_trials.push_back(depth_first_timer.race_time()); // adding to trial container
-    }
+    NPC_Racer::for_each_agent(racers, [&](auto &racer, const size_t i)
+                              {
+        using agent_type = std::remove_cvref_t<decltype(racer)>;
+        output << "Running " << agent_type::display_name << " pathfinding.\n";
+        measurements[i] = NPC_Racer::run_trials(racer, race_maze, options, options.scratch_arenas ? &arenas[i] : nullptr);
+
+        if (racer.path.size() > 1) // If maze didn't encounter an error
+            output << agent_type::display_name << " pathfinding complete, path was successfully found!\n";
+
+        if (print_paths)
+            race_maze.print_path_on_maze(racer.path);
+        if (!options.trace_prefix.empty()) // the trace of the last trial
+            NPC_Racer::write_trace_files(racer.trace, race_maze, std::string(agent_type::name), options.trace_prefix + "_" + std::filesystem::path(filename).stem().string() + "_" + std::string(agent_type::name));
+        output << "\n"; // space for a bit of separation
+
+        // race statistics
+        statistics[i] = NPC_Racer::summarize_run(measurements[i].trial_times, options.reject_outliers);
+        results[i] = {race_maze.file_name, std::string(agent_type::name), sizeof(index_type) * 8, statistics[i], measurements[i].iterations_per_trial, measurements[i].counters, racer.path.size(), racer.nodes_explored, measurements[i].trial_times}; });
+
+    // finding the shortest of all the runs, based on https://en.cppreference.com/w/cpp/algorithm/min_element
+    size_t minimum_index = (size_t)std::distance(statistics.begin(), std::min_element(statistics.begin(), statistics.end(), [](const NPC_Racer::run_statistics &first, const NPC_Racer::run_statistics &second)
+                                                                                      { return first.average < second.average; }));
+    double minimum_average = statistics[minimum_index].average;
+
+    // percentage difference
+    for (size_t i = 0; i < agent_count; i++)
+        percentage_differences[i] = NPC_Racer::run_percentage_difference(statistics[i].average, minimum_average);
+
+    //// Race Results ////
+    output << "\n## RACE RESULTS ##.\n";
+    output << "Maze loading time: " << maze_loading_timer.race_time() << "\n";
+    output << "Maze parsing time: " << race_maze.parsing_time << "\n";
+    output << "Graph construction time: " << race_maze.graph_construction_time << "\n";
+    if (cache_hit) // replaces both parsing and graph construction
+        output << "Maze cache restore time: " << cache_restore_time << "\n";
+    if (!options.cache_directory.empty())
+        output << "Maze cache: " << (cache_hit ? "hit, restored from " : "miss, saved to ") << "`" << options.cache_directory << "` ("
+               << artifacts.component_count << " connected components, destination reachable from "
+               << std::count_if(artifacts.destination_distances.begin(), artifacts.destination_distances.end(), [](const index_type distance)
+                                { return distance != NPC_Racer::maze<index_type>::no_path; })
+               << " spaces)\n";
+    output << "Trials per run: " << options.trials << " (" << options.warmup_runs << " warmup)\n";
+    output << "Timer: " << (measurements[0].cycle_counter_timed ? "cycle counter" : "steady clock");
+    if (options.cycle_counter_timer and !measurements[0].cycle_counter_timed)
+        output << " (the cycle counter isn't available on this machine)";
+    output << "\n";
+
+    NPC_Racer::for_each_agent(racers, [&](auto &racer, const size_t i)
+                              {
+        using agent_type = std::remove_cvref_t<decltype(racer)>;
+        output << "\n# " << agent_type::display_name << " pathfinding #\n";
+        output << "Average pathfinding time: " << statistics[i].average << " seconds\n";
+        output << "Pathfinding standard deviation: " << statistics[i].standard_deviation << " seconds\n";
+        output << "Iterations per trial: " << measurements[i].iterations_per_trial << "\n";
+        output << "Size of the path found: " << racer.path.size() << "\n";
+        NPC_Racer::compact_path<index_type> compact;
+        compact.assign(racer.path, race_maze.columns());
+        compact.shrink_to_fit(); // sized as a stored path would be
+        output << "Path memory: " << racer.path.size() * sizeof(index_type) << " bytes as indices, " << compact.memory_bytes() << " bytes compact (" << compact.runs() << " runs)\n";
+        output << "Number of nodes explored: " << racer.nodes_explored << "\n";
+        if constexpr (requires { racer.peak_memory_bytes; }) // the agents searching under a memory limit
+            output << "Search memory: " << racer.peak_memory_bytes << " bytes searching " << (racer.frontier_search ? "by divide-and-conquer frontier search" : "breadth-first")
+                   << ((racer.memory_limit == std::numeric_limits<size_t>::max()) ? std::string() : " (limit " + std::to_string(racer.memory_limit) + " bytes)") << "\n";
+        if constexpr (NPC_Racer::allocation_counts::enabled)
+            output << "Heap allocations per search: " << measurements[i].allocations_per_search << " (" << measurements[i].allocated_bytes_per_search << " bytes), "
+                   << measurements[i].first_search_allocations.allocations << " in the first search (" << measurements[i].first_search_allocations.bytes << " bytes)\n";
+        if (options.scratch_arenas)
+            output << "Scratch arena: " << arenas[i].capacity() << " bytes\n";
+        output << racer.statistics; // only prints when compiled with NPC_RACER_SEARCH_STATISTICS
+        if (options.reject_outliers)
+            output << "Outlier trials rejected: " << statistics[i].rejected_trials << "\n"; });
+
+    // Summary Table //
+    // each cell is padded with tabs to 16 characters so the columns line up
+    auto cell = [](const auto &value)
+    {
+        std::ostringstream text;
+        text << value;
+        return text.str() + ((text.str().size() < 6) ? "\t\t| " : "\t| ");
+    };
+    auto table_row = [&](const std::string &label, auto value_of)
+    {
+        output << label << ((label.size() < 8) ? "\t| " : "| ");
+        for (size_t i = 0; i < agent_count; i++)
+            output << cell(value_of(i));
+        output << "\n";
+    };
+    std::string separator = "--------|";
+    for (size_t i = 0; i < agent_count; i++)
+        separator += "---------------|";
 
-    if (depth_first_racer.path.size() > 1) // If maze didn't encounter an error
+    output << "\n# Summary Table #\n";
+    output << "Race on maze: '" << race_maze.file_name << "'\n";
+    output << "\t| ";
+    NPC_Racer::for_each_agent(racers, [&](auto &racer, const size_t)
+                              { output << cell(std::remove_cvref_t<decltype(racer)>::display_name); });
+    output << "Algorithm\t\n";
+    output << separator << "\n";
+    table_row("Winner", [&](const size_t i)
+              { return (i == minimum_index) ? "WINNER" : ""; });
+    table_row("Average", [&](const size_t i)
+              { return statistics[i].average; });
+    table_row("% diff.", [&](const size_t i)
+              { return (percentage_differences[i] == 0) ? std::string("0 %") : std::to_string(percentage_differences[i]) + " %"; });
+    table_row("STDDEVP.", [&](const size_t i)
+              { return statistics[i].standard_deviation; });
+    table_row("Minimum", [&](const size_t i)
+              { return statistics[i].minimum; });
+    table_row("Median", [&](const size_t i)
+              { return statistics[i].median; });
+    table_row("P90", [&](const size_t i)
+              { return statistics[i].percentile_90; });
+    table_row("P99", [&](const size_t i)
+              { return statistics[i].percentile_99; });
+    table_row("Path", [&](const size_t i)
+              { return results[i].path_size; });
+    table_row("Explored", [&](const size_t i)
+              { return results[i].nodes_explored; });
+    if constexpr (NPC_Racer::allocation_counts::enabled) // heap allocations per timed search, then in the first search of the new agent
     {
-        std::cout << "Depth-first pathfinding complete, path was successfully found!\n";
+        table_row("Allocs", [&](const size_t i)
+                  { return measurements[i].allocations_per_search; });
+        table_row("Alloc B", [&](const size_t i)
+                  { return measurements[i].allocated_bytes_per_search; });
+        table_row("1st alloc", [&](const size_t i)
+                  { return measurements[i].first_search_allocations.allocations; });
     }
+    if (options.hardware_counters and measurements[0].counters.available)
+    {
+        // counters are averaged per iteration, -1 counters weren't supported or never scheduled, * ones were multiplexed and scaled
+        auto counter_row = [&](const std::string &label, double NPC_Racer::hardware_counter_values::*counter)
+        {
+            table_row(label, [&](const size_t i)
+                      { double value = measurements[i].counters.*counter;
+                        return (value < 0) ? std::string("n/a") : std::to_string((uint64_t)value) + (measurements[i].counters.multiplexed ? "*" : ""); });
+        };
+        counter_row("Cycles", &NPC_Racer::hardware_counter_values::cycles);
+        counter_row("Instr.", &NPC_Racer::hardware_counter_values::instructions);
+        counter_row("L1 miss", &NPC_Racer::hardware_counter_values::l1_data_misses);
+        counter_row("LLC miss", &NPC_Racer::hardware_counter_values::last_level_cache_misses);
+        counter_row("Br. miss", &NPC_Racer::hardware_counter_values::branch_misses);
+    }
+    output << separator << "\n";
+    output << "Value\n";
+    output << "^all times are in seconds";
+    if (options.scratch_arenas)
+        output << ", scratch arrays made in arenas reset before every search";
+    if (options.hardware_counters)
+    {
+        output << (measurements[0].counters.available ? ", counters are averaged per trial" : "\nHardware counters are unavailable on this machine, only wall time was measured");
+        if (std::any_of(measurements.begin(), measurements.end(), [](const NPC_Racer::run_measurements &measurement)
+                        { return measurement.counters.multiplexed; }))
+            output << ", * counters were multiplexed and scaled up from the time they ran";
+    }
+    output << "\n";
 
-    race_maze.print_path_on_maze(depth_first_racer.path);
-    std::cout << "\n"; // space for a bit of separation
+    //// Head-to-head Race ////
+    // the agents race at the same time on their own threads, sharing the maze and the memory bandwidth
+    if (options.head_to_head)
+    {
+        std::vector<NPC_Racer::head_to_head_result> head_to_head = std::apply([&](auto &...agents)
+                                                                              { return NPC_Racer::run_head_to_head(race_maze, options.trials, options.pin_cores, agents...); },
+                                                                              racers);
+        std::vector<std::string> agent_names;
+        NPC_Racer::for_each_agent(racers, [&](auto &racer, const size_t)
+                                  { agent_names.push_back(std::string(std::remove_cvref_t<decltype(racer)>::display_name)); });
 
-    // Dijkstra Agent Pathfinding //
-    std::cout << "Running Dijkstra's algorithm pathfinding.\n";
+        output << "\n# Head-to-head Race #\n";
+        output << options.trials << " rounds with every agent started together" << (options.pin_cores ? " on pinned cores" : "") << "\n";
+        output << "\t| ";
+        for (const std::string &agent_name : agent_names)
+            output << cell(agent_name);
+        output << "Algorithm\t\n";
+        output << separator << "\n";
+        table_row("Wins", [&](const size_t i)
+                  { return head_to_head[i].wins; });
+        table_row("Average", [&](const size_t i)
+                  { return NPC_Racer::run_average(head_to_head[i].finish_times); });
+        table_row("Median", [&](const size_t i)
+                  { return NPC_Racer::run_median(head_to_head[i].finish_times); });
+        table_row("Minimum", [&](const size_t i)
+                  { return NPC_Racer::run_minimum(head_to_head[i].finish_times); });
+        output << separator << "\n";
+        output << "Value\n";
+        output << "^times to first path in seconds from the start of each round\n";
 
-    for (size_t i = 0; i < trials_per_run; i++)
-    {
-        dijkstra_timer.start();
-        dijkstra_racer.pathfind(race_maze); // doing the pathfinding
-        dijkstra_timer.end();
-        dijkstra_trials.push_back(dijkstra_timer.race_time()); // adding to trial container
+        // finishing order of the last round
+        output << "Last round finishing order:";
+        for (size_t place = 1; place <= head_to_head.size(); place++)
+            for (size_t i = 0; i < head_to_head.size(); i++)
+                if (head_to_head[i].places.back() == place)
+                    output << " " << place << ". " << agent_names[i];
+        output << "\n";
     }
 
-    if (dijkstra_racer.path.size() > 1) // If maze didn't encounter an error
+    //// Async Requests ////
+    // every request is outstanding at once, each awaited by its own coroutine resumed on the worker that answers it
+    if (options.async_requests > 0)
     {
-        std::cout << "Dijkstra's algorithm pathfinding complete, path was successfully found!\n";
+        NPC_Racer::async_pathfinder<index_type> pathfinder(race_maze, options.async_workers, options.pin_cores);
+        std::vector<NPC_Racer::async_load_result> loads(agent_count);
+        for (size_t i = 0; i < agent_count; i++)
+            loads[i] = NPC_Racer::run_async_load(pathfinder, i, options.async_requests);
+
+        output << "\n# Async Requests #\n";
+        output << options.async_requests << " requests at once per agent between random free spaces on "
+               << pathfinder.pool().size() << " work-stealing worker" << (pathfinder.pool().size() == 1 ? "" : "s") << "\n";
+        output << "\t| ";
+        NPC_Racer::for_each_agent(racers, [&](auto &racer, const size_t)
+                                  { output << cell(std::remove_cvref_t<decltype(racer)>::display_name); });
+        output << "Algorithm\t\n";
+        output << separator << "\n";
+        table_row("Req./s", [&](const size_t i)
+                  { return (double)loads[i].requests / loads[i].seconds; });
+        table_row("Median", [&](const size_t i)
+                  { return NPC_Racer::run_median(loads[i].latencies); });
+        table_row("P90", [&](const size_t i)
+                  { return NPC_Racer::run_percentile(loads[i].latencies, 90); });
+        table_row("P99", [&](const size_t i)
+                  { return NPC_Racer::run_percentile(loads[i].latencies, 99); });
+        table_row("Maximum", [&](const size_t i)
+                  { return NPC_Racer::run_percentile(loads[i].latencies, 100); });
+        table_row("Steals", [&](const size_t i)
+                  { return loads[i].steals; });
+        output << separator << "\n";
+        output << "Value\n";
+        output << "^latencies in seconds from each request to its coroutine resuming\n";
     }
 
-    race_maze.print_path_on_maze(dijkstra_racer.path);
-    std::cout << "\n"; // space for a bit of separation
+    //// Cooperative Planning ////
+    // growing groups of agents plan around each other's reservations, planning time against the number of agents
+    if (options.cooperative_agents > 0)
+    {
+        std::vector<NPC_Racer::cooperative_result<index_type>> groups = NPC_Racer::run_cooperative_scaling(race_maze, options.cooperative_agents, options.cooperative_window);
 
-    // race statistics //
-    depth_first_average = NPC_Racer::run_average(depth_first_trials);
-    depth_first_standard_deviation = NPC_Racer::run_standard_deviation(depth_first_trials);
+        output << "\n# Cooperative Planning #\n";
+        output << "Windowed cooperative A* between random free spaces, planning " << options.cooperative_window << " ticks ahead\n";
+        output << "Agents\t| " << cell("Arrived") << cell("Ticks") << cell("Distances") << cell("Planning") << cell("Per tick") << cell("Per plan") << cell("Expanded") << cell("Collisions") << cell("Heuristic") << "\n";
+        output << "--------|---------------|---------------|---------------|---------------|---------------|---------------|---------------|---------------|---------------|\n";
+        for (const NPC_Racer::cooperative_result<index_type> &group : groups)
+        {
+            size_t agents = group.trajectories.size();
+            double replans = (double)group.plans / (double)agents;
+            output << agents << "\t| " << cell(group.arrived) << cell(group.ticks) << cell(group.distance_seconds) << cell(group.planning_seconds)
+                   << cell(group.planning_seconds / replans) << cell(group.planning_seconds / (double)group.plans) << cell(group.nodes_expanded) << cell(group.collisions)
+                   << cell(group.heuristic_positions / agents) << "\n";
+        }
+        output << "^times in seconds, per tick is the whole group replanning once, heuristic is the positions each agent's reverse search holds\n";
+    }
 
-    dijkstra_average = NPC_Racer::run_average(dijkstra_trials);
-    dijkstra_standard_deviation = NPC_Racer::run_standard_deviation(dijkstra_trials);
+    //// Contraction Hierarchy ////
+    // preprocessing once so any two spaces can be queried without searching most of the maze
+    if (options.hierarchy_queries > 0)
+    {
+        NPC_Racer::hierarchy_result hierarchy = NPC_Racer::run_hierarchy_queries(race_maze, options.hierarchy_queries);
 
-    // finding the shortest of all the runs
-    run_averages = {depth_first_average, dijkstra_average}; // make sure to add all the algorithm averages here
-    // finding index of the minimum, used also for printing, based on https://en.cppreference.com/w/cpp/algorithm/min_element
-    uint64_t minimum_index = (uint64_t)std::distance(run_averages.begin(), std::min_element(run_averages.begin(), run_averages.end()));
+        output << "\n# Contraction Hierarchy #\n";
+        output << "Preprocessing time: " << hierarchy.preprocessing_seconds << "\n";
+        output << "Spaces: " << hierarchy.nodes << ", edges: " << hierarchy.edges << ", shortcuts: " << hierarchy.shortcuts
+               << " (" << hierarchy.shortcut_bytes << " bytes)\n";
+        output << "Hierarchy memory: " << hierarchy.memory_bytes << " bytes\n";
+        output << "Start to destination path length: " << hierarchy.race_path_size << "\n";
+        output << "Queries\t| " << cell("Median") << cell("P90") << cell("P99") << cell("Settled") << cell("BFS median") << cell("Mismatches") << "\n";
+        output << "--------|---------------|---------------|---------------|---------------|---------------|---------------|\n";
+        output << hierarchy.latencies.size() << "\t| " << cell(NPC_Racer::run_median(hierarchy.latencies)) << cell(NPC_Racer::run_percentile(hierarchy.latencies, 90))
+               << cell(NPC_Racer::run_percentile(hierarchy.latencies, 99)) << cell((double)hierarchy.nodes_settled / (double)hierarchy.latencies.size())
+               << cell(NPC_Racer::run_median(hierarchy.search_latencies)) << cell(hierarchy.mismatches) << "\n";
+        output << "^latencies in seconds including unpacking the path, settled is per query, the first " << hierarchy.search_latencies.size()
+               << " queries are checked against a breadth-first search\n";
+    }
 
-    double minimum_average = run_averages[minimum_index];
+    //// Nearest Target ////
+    // mazes with several starts or destinations also time one multi-source search against a search for every pair
+    if ((race_maze.start_positions.size() > 1) or (race_maze.destination_positions.size() > 1))
+    {
+        NPC_Racer::nearest_target_agent<index_type> nearest;
+        NPC_Racer::run_measurements nearest_measurements = NPC_Racer::run_trials(nearest, race_maze, options);
+        NPC_Racer::run_statistics nearest_statistics = NPC_Racer::summarize_run(nearest_measurements.trial_times, options.reject_outliers);
 
-    // percentage difference
-    depth_first_percentage_difference = NPC_Racer::run_percentage_difference(depth_first_average, minimum_average);
-    dijkstra_percentage_difference = NPC_Racer::run_percentage_difference(dijkstra_average, minimum_average);
+        NPC_Racer::bidirectional_dijkstra_agent<index_type> pair_racer;
+        pair_racer.warnings = false;
+        size_t shortest_pair = 0;
+        NPC_Racer::timekeeper pair_timer;
+        pair_timer.start();
+        for (index_type start : race_maze.start_positions)
+            for (index_type destination : race_maze.destination_positions)
+                if (pair_racer.pathfind(race_maze, start, destination).size() > 1)
+                    shortest_pair = (shortest_pair == 0) ? pair_racer.path.size() : std::min(shortest_pair, pair_racer.path.size());
+        pair_timer.end();
 
-    //// Race Results ////
-    std::cout << "\n## RACE RESULTS ##.\n";
-    std::cout << "Maze Parsing time: " << maze_parsing_timer.race_time() << "\n";
-
-    std::cout << "\n# Depth-first pathfinding #\n";
-    std::cout << "Average depth-first pathfinding time: " << depth_first_average << " seconds\n";
-    std::cout << "Depth-first pathfinding standard deviation: " << depth_first_standard_deviation << " seconds\n";
-    std::cout << "Size of the depth-first path found: " << depth_first_racer.path.size() << "\n";
-    std::cout << "Number of depth-first nodes explored: " << depth_first_racer.nodes_explored << "\n";
-
-    std::cout << "\n# Dijkstra's algorithm pathfinding #\n";
-    std::cout << "Average Dijkstra pathfinding time: " << dijkstra_average << " seconds\n";
-    std::cout << "Dijkstra pathfinding standard deviation: " << dijkstra_standard_deviation << " seconds\n";
-    std::cout << "Size of the Dijkstra path found: " << dijkstra_racer.path.size() << "\n";
-    std::cout << "Number of Dijkstra nodes explored: " << dijkstra_racer.nodes_explored << "\n";
-
-    std::cout << "\n# Summary Table #\n";
-    std::cout << "Race on maze: '" << race_maze.file_name << "'\n";
-    std::cout << "\t| Depth-first\t| Dijkstra's\t| Algorithm\t\n";
-    std::cout << "--------|---------------|---------------|\n";
-    std::cout << "Winner\t| " << (minimum_index == 0 ? "WINNER" : "\t") << "\t| " << (minimum_index == 1 ? "WINNER" : "\t") << "\t| \n";
-    std::cout << "Average\t| " << depth_first_average << "\t| " << dijkstra_average << "\t| \n";
-    std::cout << "% diff.\t| " << (depth_first_percentage_difference == 0 ? "0\t" : std::to_string(depth_first_percentage_difference)) << " %\t| " << (dijkstra_percentage_difference == 0 ? "0\t" : std::to_string(dijkstra_percentage_difference)) << " %\t| \n";
-    std::cout << "STDDEVP.| " << depth_first_standard_deviation << "\t| " << dijkstra_standard_deviation << "\t| \n";
-    std::cout << "Path\t| " << depth_first_racer.path.size() << "\t\t| " << dijkstra_racer.path.size() << "\t\t| \n";
-    std::cout << "Explored| " << depth_first_racer.nodes_explored << "\t\t| " << dijkstra_racer.nodes_explored << "\t\t| \n";
-    std::cout << "--------|---------------|---------------|\n";
-    std::cout << "Value\n";
-    std::cout << "^average and standard deviation time is in seconds\n";
+        output << "\n# Nearest Target #\n";
+        output << race_maze.start_positions.size() << " start" << (race_maze.start_positions.size() == 1 ? "" : "s") << " and "
+               << race_maze.destination_positions.size() << " destination" << (race_maze.destination_positions.size() == 1 ? "" : "s") << "\n";
+        if (nearest.pathfinding_completed)
+            output << "Nearest pair: start " << (nearest.found_source + 1) << " at index " << race_maze.start_positions[nearest.found_source]
+                   << " to destination " << (nearest.found_target + 1) << " at index " << race_maze.destination_positions[nearest.found_target] << "\n";
+        output << "Multi-source search: " << nearest_statistics.average << " seconds, path size " << nearest.path.size() << ", " << nearest.nodes_explored << " nodes explored\n";
+        output << "A search per pair: " << pair_timer.race_time() << " seconds for " << (race_maze.start_positions.size() * race_maze.destination_positions.size())
+               << " bidirectional searches, shortest path size " << shortest_pair << "\n";
+    }
 
-    total_program_timer.end(); // end of the program
-    std::cout << "\nTotal program time: " << total_program_timer.race_time() << " seconds\n";
+    return results;
 }
@@ -0,0 +1,617 @@
+/**
+ * @file maze_cache.hpp
+ * @author Brendan Fallon (fallonbr@mcmaster.ca) (https://github.com/bren007pie)
+ * @brief This module contains the maze cache, which saves parsed mazes and their precomputed structures in sidecar files keyed by a hash of the maze file.
+ * @version 1.0
+ * @date Sunday October 18, 2026
+ * @copyright Copyright (c) 2022 Brendan Fallon
+ */
+
+//// Preprocessor Directives ////
+#pragma once
+#include <iostream>     // std::cout
+#include <fstream>      // std::ifstream, std::ofstream
+#include <sstream>      // std::ostringstream
+#include <iomanip>      // std::hex, std::setw, std::setfill
+#include <string>       // std::string
+#include <vector>       // std::vector
+#include <array>        // std::array
+#include <memory>       // std::unique_ptr, std::make_unique
+#include <filesystem>   // std::filesystem::create_directories, std::filesystem::rename
+#include <thread>       // std::this_thread::get_id
+#include <functional>   // std::hash
+#include <cstring>      // std::memcpy
+#include <algorithm>    // std::max
+#include <iterator>     // std::istreambuf_iterator
+#include <cstdint>      // uint32_t, uint64_t
+#include <concepts>     // std::unsigned_integral
+#include "mazes.hpp"    // NPC_Racer::maze
+#include "timekeeper.hpp" // NPC_Racer::timekeeper
+
+// sidecar files are memory mapped where mmap is available, read into memory elsewhere
+#if defined(__unix__) || defined(__APPLE__)
+#define NPC_RACER_MEMORY_MAPPED_CACHE
+#include <sys/mman.h> // mmap, munmap
+#include <sys/stat.h> // fstat
+#include <fcntl.h>    // open
+#include <unistd.h>   // close
+#endif
+
+////// ========= //////
+////// Interface //////
+////// ========= //////
+
+namespace NPC_Racer
+{
+    //// --------- ////
+    //// Constants ////
+    //// --------- ////
+    /**
+     * @param fnv_offset_basis The starting value of a 64-bit FNV-1a hash, also used by the word-wise hash.
+     */
+    constexpr uint64_t fnv_offset_basis = 14695981039346656037ull;
+
+    /**
+     * @param fnv_prime The multiplier of a 64-bit FNV-1a hash, also used by the word-wise hash.
+     */
+    constexpr uint64_t fnv_prime = 1099511628211ull;
+
+    //// ------- ////
+    //// Structs ////
+    //// ------- ////
+    /**
+     * @brief Structures precomputed from a maze that are saved in the cache alongside it.
+     *
+     * @tparam index_type The unsigned integer type used for the maze indices.
+     */
+    template <std::unsigned_integral index_type>
+    struct maze_artifacts
+    {
+        /**
+         * @param components The connected component of each element, counted from 0. Barriers are no_component.
+         * @note Two positions only have a path between them if they are in the same component, so it answers "no path" without a search.
+         */
+        std::vector<uint32_t> components;
+
+        /**
+         * @param component_count The number of connected components of free spaces.
+         */
+        uint32_t component_count = 0;
+
+        /**
+         * @param destination_distances The number of moves from each element to the maze's destination, no_path if it can't reach it.
+         */
+        std::vector<index_type> destination_distances;
+
+        /**
+         * @param no_component The component of a barrier.
+         */
+        static constexpr uint32_t no_component = 0xFFFFFFFF;
+    };
+
+    /**
+     * @brief The start of a sidecar file, followed by its section table.
+     * @note Every field is a fixed width so the file can be mapped straight into memory.
+     */
+    struct cache_header
+    {
+        char magic[8];             // "NPCCACHE"
+        uint32_t format_version;   // cache_format_version when written
+        uint32_t byte_order;       // 0x01020304 as written, so a file from a machine of the other byte order is rejected
+        uint32_t index_bits;       // the bits of index_type
+        uint32_t section_count;    // entries in the section table
+        uint64_t content_hash;     // word_hash of the maze file
+        uint64_t content_size;     // size of the maze file in bytes
+        uint64_t rows;             // rows of the maze
+        uint64_t columns;          // columns of the maze
+        uint64_t start;            // start position
+        uint64_t destination;      // destination position
+        uint64_t component_count;  // connected components of free spaces
+    };
+
+    /**
+     * @brief One entry of the section table of a sidecar file.
+     */
+    struct cache_section
+    {
+        uint32_t id;           // what the section holds, a cache_section_id
+        uint32_t element_size; // bytes per element
+        uint64_t offset;       // from the start of the file, a multiple of cache_alignment
+        uint64_t count;        // number of elements
+        uint64_t checksum;     // word_hash of the section bytes
+    };
+
+    /**
+     * @brief The sections a sidecar file holds, new ones are added at the end.
+     */
+    enum cache_section_id : uint32_t
+    {
+        bits_section = 1,       // bit_maze, one byte per element
+        characters_section = 2, // character_maze
+        edges_section = 3,      // connected_paths, four indices per element
+        components_section = 4, // maze_artifacts::components
+        distances_section = 5   // maze_artifacts::destination_distances
+    };
+
+    //// ----------------- ////
+    //// Mapped File Class ////
+    //// ----------------- ////
+    /**
+     * @brief A read-only view of a whole file, memory mapped where mmap is available or read into memory elsewhere.
+     */
+    class mapped_file
+    {
+    public:
+        /**
+         * @brief Maps a file.
+         *
+         * @param filename The file to map.
+         * @result Maps the file, or leaves the view empty if it can't be opened.
+         */
+        explicit mapped_file(const std::string &filename);
+
+        ~mapped_file();
+        mapped_file(const mapped_file &) = delete;
+        mapped_file &operator=(const mapped_file &) = delete;
+
+        /**
+         * @brief Gives the bytes of the file.
+         * @return The first byte, null if the file couldn't be opened.
+         */
+        const char *data() const { return bytes; }
+
+        /**
+         * @brief Gives the size of the file.
+         * @return The size in bytes, 0 if the file couldn't be opened.
+         */
+        size_t size() const { return length; }
+
+    private:
+        /**
+         * @param bytes The start of the view.
+         */
+        const char *bytes = nullptr;
+
+        /**
+         * @param length The size of the view in bytes.
+         */
+        size_t length = 0;
+
+        /**
+         * @param buffer Holds the file when it can't be memory mapped.
+         */
+        std::vector<char> buffer;
+    };
+
+    //// ---------------- ////
+    //// Maze Cache Class ////
+    //// ---------------- ////
+    /**
+     * @brief A directory of sidecar files holding parsed mazes, their connected_paths, and their maze_artifacts, named by a hash of the maze file contents.
+     *
+     * @note A changed maze file hashes differently so it never picks up a stale sidecar, and every sidecar is checked against the file's hash, size, the index type, and the checksum of each section before it's used.
+     */
+    class maze_cache
+    {
+    public:
+        /**
+         * @param cache_format_version The version of the sidecar file layout, increased whenever it changes.
+         */
+        static constexpr uint32_t cache_format_version = 2;
+
+        /**
+         * @param cache_alignment The alignment of every section in a sidecar file, a cache line.
+         */
+        static constexpr uint64_t cache_alignment = 64;
+
+        /**
+         * @brief Constructs a cache in a directory, which is created when the first sidecar is written.
+         *
+         * @param cache_directory The directory the sidecar files are kept in.
+         */
+        explicit maze_cache(const std::string cache_directory);
+
+        /**
+         * @brief Loads a maze from its sidecar file, or parses it and writes the sidecar if there isn't a valid one.
+         *
+         * @param filename The maze file name of the `*.txt` or `*.csv` file.
+         * @param artifacts Filled with the precomputed structures of the maze.
+         *
+         * @return The maze with its connected_paths built.
+         * @note A sidecar that fails validation prints a warning and is rebuilt.
+         */
+        template <std::unsigned_integral index_type>
+        std::unique_ptr<maze<index_type>> load(const std::string &filename, maze_artifacts<index_type> &artifacts);
+
+        /**
+         * @brief Says whether the last load was answered from a sidecar file.
+         * @return True for a cache hit.
+         */
+        bool last_load_hit() const { return last_hit; }
+
+        /**
+         * @brief Gives the time the last load spent restoring the maze from its sidecar file, from mapping it to the maze being built.
+         * @return The time in seconds, 0 for a cache miss. The maze's parsing_time and graph_construction_time are 0 on a hit.
+         */
+        double last_restore_time() const { return restore_time; }
+
+        /**
+         * @brief Gives the path of the sidecar file for a maze file.
+         *
+         * @param content_hash The hash of the maze file contents.
+         * @param index_bits The bits of the index type, since the edges are saved at that width.
+         *
+         * @return The sidecar file path.
+         */
+        std::string sidecar_path(const uint64_t content_hash, const size_t index_bits) const;
+
+    private:
+        //// Private Member Functions ////
+        /**
+         * @brief Restores a maze from a sidecar file after checking it matches the maze file.
+         *
+         * @return The maze, or null if there is no sidecar or it isn't valid.
+         */
+        template <std::unsigned_integral index_type>
+        std::unique_ptr<maze<index_type>> read_sidecar(const std::string &path, const std::string &filename, const uint64_t content_hash,
+                                                       const uint64_t content_size, maze_artifacts<index_type> &artifacts) const;
+
+        /**
+         * @brief Writes a sidecar file, to a temporary file first that is renamed over it so readers never see half a file.
+         */
+        template <std::unsigned_integral index_type>
+        void write_sidecar(const std::string &path, const uint64_t content_hash, const uint64_t content_size, const maze<index_type> &race_maze,
+                           const maze_artifacts<index_type> &artifacts) const;
+
+        //// Data Members ////
+
+        /**
+         * @param directory The directory the sidecar files are kept in.
+         */
+        std::string directory;
+
+        /**
+         * @param last_hit True if the last load was answered from a sidecar file.
+         */
+        bool last_hit = false;
+
+        /**
+         * @param restore_time The time in seconds the last load spent restoring from a sidecar file.
+         */
+        double restore_time = 0.0;
+    };
+
+    //// --------- ////
+    //// Functions ////
+    //// --------- ////
+    /**
+     * @brief Hashes bytes a 64-bit word at a time with the FNV-1a step, folding the high half of the hash into the low half after each word so every bit of a word reaches every bit of the hash.
+     *
+     * @param data The bytes to hash.
+     * @param size The number of bytes.
+     * @param hash The hash to continue from, to hash data in pieces. Every piece but the last must be a multiple of 32 bytes.
+     *
+     * @return The hash.
+     * @note Used for both the maze file and the section checksums, a byte at a time FNV-1a cost more than the copies it was checking.
+     */
+    uint64_t word_hash(const char *data, const size_t size, uint64_t hash = fnv_offset_basis);
+
+    /**
+     * @brief Computes the structures saved alongside a maze in the cache.
+     *
+     * @param race_maze The maze, its connected_paths are built if they aren't yet.
+     * @return The connected components and the distances to the destination.
+     */
+    template <std::unsigned_integral index_type>
+    maze_artifacts<index_type> build_maze_artifacts(const maze<index_type> &race_maze);
+}
+
+////// ============== //////
+////// Implementation //////
+////// ============== //////
+
+//// ----------- ////
+//// Mapped File ////
+//// ----------- ////
+
+NPC_Racer::mapped_file::mapped_file(const std::string &filename)
+{
+#if defined(NPC_RACER_MEMORY_MAPPED_CACHE)
+    int file = open(filename.c_str(), O_RDONLY);
+    if (file < 0)
+        return;
+    struct stat file_status;
+    if ((fstat(file, &file_status) == 0) and (file_status.st_size > 0))
+    {
+        void *mapping = mmap(nullptr, (size_t)file_status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (mapping != MAP_FAILED)
+        {
+            bytes = static_cast<const char *>(mapping);
+            length = (size_t)file_status.st_size;
+        }
+    }
+    close(file); // the mapping stays valid after the file is closed
+#else
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open())
+        return;
+    buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    bytes = buffer.data();
+    length = buffer.size();
+#endif
+}
+
+NPC_Racer::mapped_file::~mapped_file()
+{
+#if defined(NPC_RACER_MEMORY_MAPPED_CACHE)
+    if (bytes != nullptr)
+        munmap(const_cast<char *>(bytes), length);
+#endif
+}
+
+//// ---------- ////
+//// Maze Cache ////
+//// ---------- ////
+
+NPC_Racer::maze_cache::maze_cache(const std::string cache_directory) : directory(cache_directory)
+{
+}
+
+std::string NPC_Racer::maze_cache::sidecar_path(const uint64_t content_hash, const size_t index_bits) const
+{
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << content_hash << std::dec << "_" << index_bits << ".npcmaze";
+    return (std::filesystem::path(directory) / name.str()).string();
+}
+
+template <std::unsigned_integral index_type>
+std::unique_ptr<NPC_Racer::maze<index_type>> NPC_Racer::maze_cache::load(const std::string &filename, maze_artifacts<index_type> &artifacts)
+{
+    // hashing the file contents, a cache hit still reads the maze file once but skips parsing it
+    uint64_t content_hash = fnv_offset_basis;
+    uint64_t content_size = 0;
+    {
+        std::ifstream file(filename, std::ios::binary);
+        std::array<char, 1 << 16> chunk;
+        while (file.read(chunk.data(), chunk.size()) or (file.gcount() > 0))
+        {
+            content_hash = word_hash(chunk.data(), (size_t)file.gcount(), content_hash);
+            content_size += (uint64_t)file.gcount();
+        }
+    }
+    std::string path = sidecar_path(content_hash, sizeof(index_type) * 8);
+
+    timekeeper restore_timer;
+    restore_timer.start();
+    std::unique_ptr<maze<index_type>> cached_maze = read_sidecar<index_type>(path, filename, content_hash, content_size, artifacts);
+    restore_timer.end();
+    last_hit = (cached_maze != nullptr);
+    restore_time = last_hit ? restore_timer.race_time() : 0.0;
+    if (last_hit)
+        return cached_maze;
+
+    // a miss parses the maze as usual and saves everything for next time
+    std::unique_ptr<maze<index_type>> parsed_maze = std::make_unique<maze<index_type>>(filename);
+    parsed_maze->adjacency();
+    artifacts = build_maze_artifacts(*parsed_maze);
+    write_sidecar(path, content_hash, content_size, *parsed_maze, artifacts);
+    return parsed_maze;
+}
+
+template <std::unsigned_integral index_type>
+std::unique_ptr<NPC_Racer::maze<index_type>> NPC_Racer::maze_cache::read_sidecar(const std::string &path, const std::string &filename, const uint64_t content_hash,
+                                                                                  const uint64_t content_size, maze_artifacts<index_type> &artifacts) const
+{
+    if (!std::filesystem::exists(path))
+        return nullptr;
+    mapped_file sidecar(path);
+    auto reject = [&](const std::string &reason) -> std::unique_ptr<maze<index_type>>
+    {
+        std::cout << "WARNING: Ignoring maze cache file `" << path << "` for `" << filename << "`, " << reason << ". It will be rebuilt.\n";
+        return nullptr;
+    };
+
+    // checking the header matches this maze file and build
+    cache_header header;
+    if (sidecar.size() < sizeof(cache_header))
+        return reject("it is too small");
+    std::memcpy(&header, sidecar.data(), sizeof(cache_header));
+    if ((std::string(header.magic, sizeof(header.magic)) != "NPCCACHE") or (header.format_version != cache_format_version) or (header.byte_order != 0x01020304))
+        return reject("it has a different format");
+    if ((header.content_hash != content_hash) or (header.content_size != content_size))
+        return reject("it was made from a different maze file");
+    if (header.index_bits != sizeof(index_type) * 8)
+        return reject("it has a different index type");
+    uint64_t elements = header.rows * header.columns;
+    if ((header.rows == 0) or (header.columns == 0) or (elements / header.columns != header.rows) or !index_fits<index_type>(elements) or
+        (header.start >= elements) or (header.destination >= elements))
+        return reject("its maze size or positions are invalid");
+
+    // checking every section is inside the file, the right size, and unchanged
+    uint64_t table_end = sizeof(cache_header) + header.section_count * sizeof(cache_section);
+    if ((header.section_count > 64) or (table_end > sidecar.size()))
+        return reject("its section table is cut off");
+    std::array<const cache_section *, distances_section + 1> sections = {};
+    std::vector<cache_section> table(header.section_count);
+    std::memcpy(table.data(), sidecar.data() + sizeof(cache_header), header.section_count * sizeof(cache_section));
+    for (const cache_section &section : table)
+    {
+        if ((section.offset % cache_alignment != 0) or (section.offset > sidecar.size()) or
+            (section.count > (sidecar.size() - section.offset) / std::max<uint64_t>(1, section.element_size)))
+            return reject("a section is outside the file");
+        if (word_hash(sidecar.data() + section.offset, section.count * section.element_size) != section.checksum)
+            return reject("a section checksum doesn't match");
+        if ((section.id >= bits_section) and (section.id <= distances_section))
+            sections[section.id] = &section;
+    }
+    std::array<uint64_t, distances_section + 1> element_sizes = {0, 1, 1, 4 * sizeof(index_type), 4, sizeof(index_type)};
+    for (uint32_t id = bits_section; id <= distances_section; id++)
+        if ((sections[id] == nullptr) or (sections[id]->count != elements) or (sections[id]->element_size != element_sizes[id]))
+            return reject("a section is missing or the wrong size");
+
+    // the sections are laid out the same as in memory and start on cache lines, so each is one bulk copy straight from the mapping
+    const char *character_bytes = sidecar.data() + sections[characters_section]->offset;
+    std::vector<char> characters(character_bytes, character_bytes + elements);
+    const std::array<index_type, 4> *first_edges = reinterpret_cast<const std::array<index_type, 4> *>(sidecar.data() + sections[edges_section]->offset);
+    std::vector<std::array<index_type, 4>> edges(first_edges, first_edges + elements);
+    const uint32_t *first_component = reinterpret_cast<const uint32_t *>(sidecar.data() + sections[components_section]->offset);
+    artifacts.components.assign(first_component, first_component + elements);
+    artifacts.component_count = (uint32_t)header.component_count;
+    const index_type *first_distance = reinterpret_cast<const index_type *>(sidecar.data() + sections[distances_section]->offset);
+    artifacts.destination_distances.assign(first_distance, first_distance + elements);
+
+    // std::vector<bool> packs its bits out of reach, so it is the one section filled an element at a time
+    const char *bit_bytes = sidecar.data() + sections[bits_section]->offset;
+    std::vector<bool> bits(bit_bytes, bit_bytes + elements);
+
+    return std::make_unique<maze<index_type>>(filename, header.rows, header.columns, (index_type)header.start, (index_type)header.destination,
+                                              std::move(bits), std::move(characters), std::move(edges));
+}
+
+template <std::unsigned_integral index_type>
+void NPC_Racer::maze_cache::write_sidecar(const std::string &path, const uint64_t content_hash, const uint64_t content_size, const maze<index_type> &race_maze,
+                                          const maze_artifacts<index_type> &artifacts) const
+{
+    size_t elements = race_maze.bit_maze.size();
+    std::vector<char> bit_bytes(elements);
+    for (size_t i = 0; i < elements; i++)
+        bit_bytes[i] = race_maze.bit_maze[i] ? 1 : 0;
+    const std::vector<std::array<index_type, 4>> &edges = race_maze.adjacency();
+
+    // the sections in the order they are written, each starting on a cache line
+    struct section_source
+    {
+        cache_section_id id;
+        uint32_t element_size;
+        const char *bytes;
+    };
+    std::array<section_source, 5> sources = {{{bits_section, 1, bit_bytes.data()},
+                                              {characters_section, 1, race_maze.character_maze.data()},
+                                              {edges_section, (uint32_t)(4 * sizeof(index_type)), reinterpret_cast<const char *>(edges.data())},
+                                              {components_section, 4, reinterpret_cast<const char *>(artifacts.components.data())},
+                                              {distances_section, (uint32_t)sizeof(index_type), reinterpret_cast<const char *>(artifacts.destination_distances.data())}}};
+
+    cache_header header = {};
+    std::memcpy(header.magic, "NPCCACHE", sizeof(header.magic));
+    header.format_version = cache_format_version;
+    header.byte_order = 0x01020304;
+    header.index_bits = (uint32_t)(sizeof(index_type) * 8);
+    header.section_count = (uint32_t)sources.size();
+    header.content_hash = content_hash;
+    header.content_size = content_size;
+    header.rows = race_maze.rows();
+    header.columns = race_maze.columns();
+    header.start = race_maze.start_position;
+    header.destination = race_maze.destination_position;
+    header.component_count = artifacts.component_count;
+
+    std::vector<cache_section> table;
+    uint64_t offset = sizeof(cache_header) + sources.size() * sizeof(cache_section);
+    for (const section_source &source : sources)
+    {
+        offset = (offset + cache_alignment - 1) / cache_alignment * cache_alignment;
+        uint64_t size = elements * source.element_size;
+        table.push_back({source.id, source.element_size, offset, elements, word_hash(source.bytes, size)});
+        offset += size;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    std::string temporary_path = path + "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+    {
+        std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            std::cout << "WARNING: Could not write maze cache file `" << path << "`, the maze will be parsed again next time.\n";
+            return;
+        }
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(table.data()), (std::streamsize)(table.size() * sizeof(cache_section)));
+        uint64_t written = sizeof(cache_header) + table.size() * sizeof(cache_section);
+        for (size_t i = 0; i < sources.size(); i++)
+        {
+            for (; written < table[i].offset; written++) // padding to the section's cache line
+                file.put('\0');
+            file.write(sources[i].bytes, (std::streamsize)(table[i].count * table[i].element_size));
+            written += table[i].count * table[i].element_size;
+        }
+    }
+    std::filesystem::rename(temporary_path, path, error); // replaces any older sidecar at once
+    if (error)
+        std::filesystem::remove(temporary_path, error);
+}
+
+//// --------- ////
+//// Functions ////
+//// --------- ////
+
+uint64_t NPC_Racer::word_hash(const char *data, const size_t size, uint64_t hash /* fnv_offset_basis */)
+{
+    // four words at a time into separate lanes so the multiplies don't wait on each other, then the lanes are hashed into one
+    auto step = [](uint64_t lane, const uint64_t word)
+    {
+        lane = (lane ^ word) * fnv_prime;
+        return lane ^ (lane >> 32);
+    };
+    constexpr size_t block_size = 4 * sizeof(uint64_t);
+    size_t whole_blocks = size / block_size * block_size;
+    uint64_t first_lane = hash, second_lane = hash + 1, third_lane = hash + 2, fourth_lane = hash + 3;
+    for (size_t i = 0; i < whole_blocks; i += block_size)
+    {
+        std::array<uint64_t, 4> words;
+        std::memcpy(words.data(), data + i, block_size); // any alignment, compiles to plain loads
+        first_lane = step(first_lane, words[0]);
+        second_lane = step(second_lane, words[1]);
+        third_lane = step(third_lane, words[2]);
+        fourth_lane = step(fourth_lane, words[3]);
+    }
+    if (whole_blocks > 0)
+        hash = step(step(step(step(hash, first_lane), second_lane), third_lane), fourth_lane);
+    for (size_t i = whole_blocks; i < size; i++) // the last few bytes one at a time
+        hash = step(hash, (uint8_t)data[i]);
+    return hash;
+}
+
+template <std::unsigned_integral index_type>
+NPC_Racer::maze_artifacts<index_type> NPC_Racer::build_maze_artifacts(const maze<index_type> &race_maze)
+{
+    const std::vector<std::array<index_type, 4>> &connected_paths = race_maze.adjacency();
+    constexpr index_type no_path = maze<index_type>::no_path;
+    size_t elements = race_maze.bit_maze.size();
+    maze_artifacts<index_type> artifacts;
+    artifacts.components.assign(elements, maze_artifacts<index_type>::no_component);
+    artifacts.destination_distances.assign(elements, no_path);
+
+    // labelling each component with a breadth-first search from its first free element
+    std::vector<index_type> queue;
+    queue.reserve(elements);
+    for (size_t first = 0; first < elements; first++)
+    {
+        if (!race_maze.bit_maze[first] or (artifacts.components[first] != maze_artifacts<index_type>::no_component))
+            continue;
+        queue.clear();
+        queue.push_back((index_type)first);
+        artifacts.components[first] = artifacts.component_count;
+        for (size_t front = 0; front < queue.size(); front++)
+            for (index_type next : connected_paths[queue[front]])
+                if ((next != no_path) and (artifacts.components[next] == maze_artifacts<index_type>::no_component))
+                {
+                    artifacts.components[next] = artifacts.component_count;
+                    queue.push_back(next);
+                }
+        artifacts.component_count++;
+    }
+
+    // every move costs 1 so a breadth-first search from the destination finds the distances
+    queue.clear();
+    queue.push_back(race_maze.destination_position);
+    artifacts.destination_distances[race_maze.destination_position] = 0;
+    for (size_t front = 0; front < queue.size(); front++)
+        for (index_type next : connected_paths[queue[front]])
+            if ((next != no_path) and (artifacts.destination_distances[next] == no_path))
+            {
+                artifacts.destination_distances[next] = (index_type)(artifacts.destination_distances[queue[front]] + 1);
+                queue.push_back(next);
+            }
+    return artifacts;
+}
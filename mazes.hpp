@@ -9,12 +9,23 @@
 
 //// Preprocessor Directives ////
 #pragma once
-#include <iostream> // std::cout, std::ostream
-#include <fstream>  // std::ofstream, std::ifstream
-#include <string>   // std::string, std::to_string, std::stoull
-#include <vector>   // std::vector
-#include <array>    // std::array
-#include <deque>    // std::deque
+#include <iostream>       // std::cout, std::ostream
+#include <fstream>        // std::ofstream, std::ifstream
+#include <string>         // std::string, std::to_string, std::stoull
+#include <vector>         // std::vector
+#include <array>          // std::array
+#include <deque>          // std::deque
+#include <thread>         // std::thread
+#include <mutex>          // std::once_flag, std::call_once
+#include <algorithm>      // std::min, std::max, std::fill
+#include <cstdint>        // uint16_t, uint32_t, uint64_t
+#include <concepts>       // std::unsigned_integral
+#include <limits>         // std::numeric_limits
+#include <type_traits>    // std::conditional_t
+#include <random>         // std::mt19937_64
+#include <utility>        // std::swap, std::move
+#include <memory>         // std::unique_ptr, std::make_unique
+#include "timekeeper.hpp" // NPC_Racer::timekeeper
 
 ////// ========= //////
 ////// Interface //////
@@ -37,15 +48,71 @@ namespace NPC_Racer // using namespace across multiple files: https://stackoverf
      */
     void make_empty_maze_file(const size_t &rows, const size_t &columns, const bool comma_separated = false);
 
+    /**
+     * @brief Writes a randomly generated maze with corridors one element wide to a text file.
+     *
+     * @param rows The number of rows, odd numbers leave no wall along the bottom edge.
+     * @param columns The number of columns, odd numbers leave no wall along the right edge.
+     * @param seed The random seed, the same seed always generates the same maze on every platform.
+     * @param directory The directory to write the maze to. By default is the current working directory.
+     *
+     * @return The name of the file written, `directory/rows_cols_generated_maze_seed.txt`.
+     * @result The maze is carved by a depth-first backtracker from the start `@` in the top left to the destination `X`
+     *      in the bottom right, then about 1 in 16 of the remaining inner walls are opened so there is more than one path.
+     * @warning Overwrites any previous file with the same name.
+     */
+    std::string make_generated_maze_file(const size_t &rows, const size_t &columns, const uint64_t seed, const std::string directory = ".");
+
+    /**
+     * @brief Checks if every element of a maze can be indexed with an index type.
+     *
+     * @tparam index_type The unsigned integer type used for indices and distances.
+     * @param elements The number of elements in the maze, i.e. rows * columns.
+     *
+     * @return True if the maze fits. The largest two values of the type are reserved for "no path" and "infinite distance".
+     */
+    template <std::unsigned_integral index_type>
+    constexpr bool index_fits(const uint64_t elements);
+
+    /**
+     * @brief Reads just the size header of a maze file to find how many elements it has.
+     *
+     * @param filename The maze file name of the `*.txt` or `*.csv` file.
+     *
+     * @return The number of elements, rows * columns, in the maze. 0 if the header can't be read.
+     * @note Used to pick the smallest index type before parsing. Doesn't error check, if the file is invalid the maze constructor will report it.
+     */
+    uint64_t read_maze_elements(const std::string filename);
+
+    /**
+     * @brief Reads just the size header of a maze from a stream to find how many elements it has.
+     *
+     * @param input The stream at the start of the maze, e.g. over a maze held in memory. The header line is consumed.
+     *
+     * @return The number of elements, rows * columns, in the maze. 0 if the header can't be read.
+     */
+    uint64_t read_maze_elements(std::istream &input);
+
+    /**
+     * @brief The smallest of uint16_t, uint32_t, and uint64_t that can index a maze with this many elements.
+     *
+     * @tparam elements The number of elements in the maze, i.e. rows * columns.
+     */
+    template <uint64_t elements>
+    using fitting_index_type = std::conditional_t<index_fits<uint16_t>(elements), uint16_t,
+                                                  std::conditional_t<index_fits<uint32_t>(elements), uint32_t, uint64_t>>;
+
     //// ---------- ////
     //// Maze Class ////
     //// ---------- ////
     /**
      * @brief Grid based maze with free spaces, barrier spaces, a starting point, and a destination point.
      *
+     * @tparam index_type The unsigned integer type used for the indices of elements and stored edges. Smaller types use less memory, e.g. uint32_t halves connected_paths compared to uint64_t.
      * @result Maze object that contains data read from a file.
      * @cite Inspired by matrix class from https://baraksh.com/CSE701/notes.php
      */
+    template <std::unsigned_integral index_type = uint64_t>
     class maze
     {
     public:
@@ -59,6 +126,42 @@ namespace NPC_Racer // using namespace across multiple files: https://stackoverf
          */
         maze(const std::string filename);
 
+        /**
+         * @brief Construct a maze object from a stream in the maze file format, e.g. a maze held in memory.
+         *
+         * @param input The stream to read the maze from, starting at its size header.
+         * @param name The name used for the maze in error messages and results.
+         * @param comma_separated If the maze is comma separated format (CSV). True if yes, false if no.
+         * @result Loads the contents of the maze into the object. Unlike a file nothing is printed when it's read.
+         */
+        maze(std::istream &input, const std::string name, const bool comma_separated);
+
+        /**
+         * @brief Construct a maze object from parts that were already parsed and checked, e.g. restored from a maze cache.
+         *
+         * @param name The file name of the maze.
+         * @param rows The number of rows of the maze.
+         * @param columns The number of columns of the maze.
+         * @param start The index of the start position.
+         * @param destination The index of the destination position.
+         * @param bits The bit_maze, rows * columns elements.
+         * @param characters The character_maze, rows * columns elements.
+         * @param edges The connected_paths graph, or empty to build it on first use as usual.
+         * @result Takes the parts without checking them again, so they must come from a valid maze.
+         */
+        maze(const std::string name, const size_t rows, const size_t columns, const index_type start, const index_type destination,
+             std::vector<bool> &&bits, std::vector<char> &&characters, std::vector<std::array<index_type, 4>> &&edges);
+
+        //// Graph Member Functions ////
+
+        /**
+         * @brief Gives the edges of the maze, building them from the bit_maze on first use.
+         *
+         * @return The connected_paths graph, see the connected_paths data member for the layout.
+         * @note Safe to call from many threads at once, only the first call builds and the rest wait for it. The build is timed in graph_construction_time.
+         */
+        const std::vector<std::array<index_type, 4>> &adjacency() const;
+
         //// Member Functions ////
         /**
          * @brief Returns a string of of the maze as a fixed-width 2D array of the maze character elements.
@@ -79,12 +182,14 @@ namespace NPC_Racer // using namespace across multiple files: https://stackoverf
         /**
          * @brief Prints a given path on a maze as a 2D maze to the terminal.
          *
+         * @tparam path_type Any path that can be walked in order and has a size, e.g. std::vector<index_type> or compact_path<index_type>.
          * @param path A path that corresponds to this maze.
          *
          * @result Prints characters of the maze to the terminal with the path as a connected series of numbers.
          * @warning Errors may occur if you attempt to print a path on a maze of the wrong size.
          */
-        void print_path_on_maze(const std::deque<uint64_t> &path) const;
+        template <typename path_type>
+        void print_path_on_maze(const path_type &path) const;
 
         /**
          * @brief Says whether the maze element at that position is free or not.
@@ -99,6 +204,92 @@ namespace NPC_Racer // using namespace across multiple files: https://stackoverf
          */
         bool is_free(const int64_t row, const int64_t column, const bool out_of_bounds_warning = true) const;
 
+        /**
+         * @brief Gives the number of rows of the maze.
+         * @return The number of rows of the rectangular maze.
+         */
+        size_t rows() const;
+
+        /**
+         * @brief Gives the number of columns of the maze.
+         * @return The number of columns of the rectangular maze.
+         */
+        size_t columns() const;
+
+        //// Mutation Member Functions ////
+        // Each of these changes only the element given and the edges of its neighbours so they are O(1).
+
+        /**
+         * @brief Makes the maze element at that position a free space.
+         *
+         * @param row The row position of the element, indexed from 0 at the top of the maze.
+         * @param column The column position of the element, indexed from 0 at the left of the maze.
+         *
+         * @result Updates the bit_maze, character_maze, and the connected_paths of the neighbours then bumps the version and graph version.
+         * @note Does nothing if the element is already free.
+         */
+        void set_free(const size_t row, const size_t column);
+
+        /**
+         * @brief Makes the maze element at that position a barrier space.
+         *
+         * @param row The row position of the element, indexed from 0 at the top of the maze.
+         * @param column The column position of the element, indexed from 0 at the left of the maze.
+         * @param barrier_character The character to display the barrier with. By default is `#`.
+         *
+         * @result Updates the bit_maze, character_maze, and the connected_paths of the neighbours then bumps the version and graph version.
+         * @warning Throws an invalid_position exception if the element is a start or destination position.
+         */
+        void set_blocked(const size_t row, const size_t column, const char barrier_character = '#');
+
+        /**
+         * @brief Moves the start position to another free space.
+         *
+         * @param row The row position of the new start, indexed from 0 at the top of the maze.
+         * @param column The column position of the new start, indexed from 0 at the left of the maze.
+         *
+         * @result Updates the start_position, the first of start_positions, and character_maze then bumps the version. The graph is unchanged.
+         * @warning Throws an invalid_position exception if the element is a barrier or another start or destination position.
+         */
+        void move_start(const size_t row, const size_t column);
+
+        /**
+         * @brief Moves the destination position to another free space.
+         *
+         * @param row The row position of the new destination, indexed from 0 at the top of the maze.
+         * @param column The column position of the new destination, indexed from 0 at the left of the maze.
+         *
+         * @result Updates the destination_position, the first of destination_positions, and character_maze then bumps the version. The graph is unchanged.
+         * @warning Throws an invalid_position exception if the element is a barrier or another start or destination position.
+         */
+        void move_destination(const size_t row, const size_t column);
+
+        //// Version Member Functions ////
+        // Caches and precomputed structures can store these when built and compare them later to know if they are stale.
+
+        /**
+         * @brief Gives the version of the maze, bumped on every change.
+         * @return The number of changes made to the maze since it was read.
+         */
+        uint64_t version() const;
+
+        /**
+         * @brief Gives the version of the maze graph, only bumped when barriers change.
+         * @return The number of changes made to the bit_maze and connected_paths since the maze was read.
+         * @note Moving the start or destination doesn't change this so structures that only depend on the graph can be kept.
+         */
+        uint64_t graph_version() const;
+
+        /**
+         * @brief Gives the version of the maze when the row was last changed.
+         *
+         * @param row The row to check, indexed from 0 at the top of the maze.
+         *
+         * @return The version() after the last change to the row, 0 if it has never changed.
+         * @note Lets structures that only cover part of the maze check just the rows they use.
+         */
+        uint64_t row_version(const size_t row) const;
+
         //// Exceptions ////
 
         /**
@@ -138,12 +329,12 @@ namespace NPC_Racer // using namespace across multiple files: https://stackoverf
         };
 
         /**
-         * @exception Exception to be thrown if maze file has two characters in a row with no separator or two `X` or two `@` in a file.
+         * @exception Exception to be thrown if maze file has two characters in a row with no separator.
          */
         class double_character : public std::invalid_argument
         {
         public:
-            double_character() : std::invalid_argument("All positions must be only one character wide and separated by a comma or whitespace. There can only be one `@` and one `X` in a maze."){};
+            double_character() : std::invalid_argument("All positions must be only one character wide and separated by a comma or whitespace."){};
         };
 
         /**
@@ -161,7 +352,7 @@ namespace NPC_Racer // using namespace across multiple files: https://stackoverf
         class invalid_maze : public std::invalid_argument
         {
         public:
-            invalid_maze() : std::invalid_argument("There must be one start position '@' and one destination position `X` in a maze."){};
+            invalid_maze() : std::invalid_argument("There must be at least one start position '@' and one destination position `X` in a maze."){};
         };
 
         /**
@@ -173,25 +364,55 @@ namespace NPC_Racer // using namespace across multiple files: https://stackoverf
             out_of_bounds() : std::out_of_range("Attempting to access an elements out of the bounds of the maze."){};
         };
 
+        /**
+         * @exception Exception to be thrown if a change would put a barrier on, or move the start or destination onto, an invalid position.
+         */
+        class invalid_position : public std::invalid_argument
+        {
+        public:
+            invalid_position() : std::invalid_argument("Start and destination positions must each be on their own free space and cannot be made barriers."){};
+        };
+
+        /**
+         * @exception Exception to be thrown if the maze has more elements than the index type can index.
+         */
+        class index_overflow : public std::length_error
+        {
+        public:
+            index_overflow() : std::length_error("Maze has too many elements for the index type, use a wider index type."){};
+        };
+
         //// Public Data Members ////
         // For use by pathfinding functions
+
+        /**
+         * @param no_path The value stored in connected_paths when there is no connected path in that direction.
+         */
+        static constexpr index_type no_path = std::numeric_limits<index_type>::max();
+
         /**
          * @param start_position index of the start position in the flattened maze vector.
          * @note Indexed from zero.
          */
-        uint64_t start_position;
+        index_type start_position;
 
         /**
          * @param destination_position index of the destination position in the flattened maze vector.
          * @note Indexed from zero.
          */
-        uint64_t destination_position;
+        index_type destination_position;
 
         /**
-         * @param connected_paths The edges of the maze in flattened (1-dimensional) form. In each index of the inner array signifies one of the four movement directions. array[0] is up, array[1] is down, array[2] is left, and array[3] is right. At the movement direction we either store the index of the free space in that direction if it's connected. If not we store -1 to designate there is no connected path in that direction.
-         * @note This acts as the stored edges of the path graph.
+         * @param start_positions The index of every start position `@` in the maze, in the order they are in the file.
+         * @note The first is start_position, which is what single-start agents search from.
          */
-        std::vector<std::array<int64_t, 4>> connected_paths;
+        std::vector<index_type> start_positions;
+
+        /**
+         * @param destination_positions The index of every destination position `X` in the maze, in the order they are in the file.
+         * @note The first is destination_position, which is what single-destination agents search for.
+         */
+        std::vector<index_type> destination_positions;
 
         /**
          * @param character_maze A vector storing the char elements of the maze in flattened (1-dimensional) form. Used for printing.
@@ -209,6 +430,17 @@ namespace NPC_Racer // using namespace across multiple files: https://stackoverf
          */
         std::string file_name;
 
+        /**
+         * @param parsing_time The time in seconds it took to read and error check the maze file.
+         */
+        double parsing_time = 0.0;
+
+        /**
+         * @param graph_construction_time The time in seconds it took to build connected_paths from the bit_maze.
+         * @note Stays 0 until adjacency() is first called.
+         */
+        mutable double graph_construction_time = 0.0;
+
     private:
         //// Private Member Functions ////
         /**
@@ -222,8 +454,122 @@ namespace NPC_Racer // using namespace across multiple files: https://stackoverf
          */
         void parse_maze_file(const std::string trimmed_filename, const bool comma_separated);
 
+        /**
+         * @brief Parses and error checks a maze from a stream, used by both constructors.
+         *
+         * @param input The stream to read the maze from, starting at its size header.
+         * @param comma_separated If the maze is comma separated format (CSV). True if yes, false if no.
+         *
+         * @result Loads the contents of the maze into the object. file_name must already be set for the error messages.
+         */
+        void parse_maze_stream(std::istream &input, const bool comma_separated);
+
+        /**
+         * @brief Builds connected_paths from the bit_maze, splitting the rows across threads for large mazes.
+         *
+         * @result Fills connected_paths with the index of each connected neighbour or no_path.
+         */
+        void build_connected_paths() const;
+
+        /**
+         * @brief Builds connected_paths for a contiguous block of rows.
+         *
+         * @param first_row The first row to build, inclusive.
+         * @param last_row The last row to build, exclusive.
+         *
+         * @result Fills connected_paths for every element in the rows [first_row, last_row).
+         * @note Works a row at a time so no division is needed to find the row and column of an element. Each row and its neighbours are unpacked from the bit_maze into padded byte rows so the inner loop has no bounds checks or branches and can be vectorized.
+         */
+        void build_connected_path_rows(const size_t first_row, const size_t last_row) const;
+
+        /**
+         * @brief Checks a position given to a mutation function is within the bounds of the maze.
+         *
+         * @param row The row position of the requested element.
+         * @param column The column position of the requested element.
+         *
+         * @return The index of the position in the flattened maze.
+         * @warning Prints a warning and throws an out_of_bounds exception if the position is out of bounds.
+         */
+        size_t checked_index(const size_t row, const size_t column) const;
+
+        /**
+         * @brief Says whether a position is one of the start or destination positions.
+         *
+         * @param index The index of the position in the flattened maze.
+         * @return True if any `@` or `X` is there, read from the character maze so it doesn't search the position lists.
+         */
+        bool is_endpoint(const size_t index) const;
+
+        /**
+         * @brief Points the edges of the neighbours of an element towards it or disconnects them.
+         *
+         * @param index The index of the element that changed.
+         * @param connected True to connect the neighbours to the element, false to disconnect them.
+         *
+         * @result Updates up to four entries of connected_paths.
+         */
+        void update_neighbour_paths(const size_t index, const bool connected);
+
+        /**
+         * @brief Bumps the version of the maze and records it on the row that changed.
+         *
+         * @param row The row that changed.
+         * @param graph_changed True if the bit_maze and connected_paths changed.
+         */
+        void bump_version(const size_t row, const bool graph_changed);
+
         //// Data Members ////
 
+        /**
+         * @param parallel_construction_threshold The number of elements a maze needs before the graph is built with multiple threads.
+         * @note Below this starting threads costs more than it saves.
+         */
+        static constexpr size_t parallel_construction_threshold = 1 << 16;
+
+        /**
+         * @param connected_paths The edges of the maze in flattened (1-dimensional) form. In each index of the inner array signifies one of the four movement directions. array[0] is up, array[1] is down, array[2] is left, and array[3] is right. At the movement direction we either store the index of the free space in that direction if it's connected. If not we store no_path to designate there is no connected path in that direction.
+         * @note This acts as the stored edges of the path graph. Empty until adjacency() builds it, so loading a maze only costs parsing.
+         */
+        mutable std::vector<std::array<index_type, 4>> connected_paths;
+
+        /**
+         * @brief Whether connected_paths has been built, and the flag that builds it once even when many threads ask for it at the same time.
+         * @note std::once_flag can't be copied or moved, so it's held by pointer and a copy gets a fresh flag that is already used if the
+         *      graph came with it. Keeps the maze copyable and movable, but copying while another thread builds the graph isn't safe.
+         */
+        struct graph_build_state
+        {
+            std::unique_ptr<std::once_flag> once = std::make_unique<std::once_flag>();
+            bool built = false; // mutations only update built graphs
+
+            graph_build_state() = default;
+            graph_build_state(const graph_build_state &other);
+            graph_build_state(graph_build_state &&other);
+            graph_build_state &operator=(const graph_build_state &other);
+            graph_build_state &operator=(graph_build_state &&other);
+        };
+
+        /**
+         * @param graph_state Whether connected_paths is built and the flag that builds it.
+         */
+        mutable graph_build_state graph_state;
+
+        /**
+         * @param maze_version The number of changes made to the maze since it was read.
+         */
+        uint64_t maze_version = 0;
+
+        /**
+         * @param maze_graph_version The number of changes made to the barriers of the maze since it was read.
+         */
+        uint64_t maze_graph_version = 0;
+
+        /**
+         * @param row_versions The maze_version after the last change to each row.
+         */
+        std::vector<uint64_t> row_versions;
+
         /**
          * @param row_size The number of rows of the rectangular maze.
          */
@@ -235,6 +581,109 @@ namespace NPC_Racer // using namespace across multiple files: https://stackoverf
         size_t column_size = 0;
     };
 
+    //// ----------------- ////
+    //// Static Maze Class ////
+    //// ----------------- ////
+    /**
+     * @brief Fixed-size grid based maze known at compile time with free spaces, barrier spaces, a starting point, and a destination point.
+     *
+     * @tparam row_count The number of rows of the maze.
+     * @tparam column_count The number of columns of the maze.
+     * @result Maze object stored in std::arrays that can be built and pathfound on at compile time with no heap allocations.
+     * @note Uses the same data members as NPC_Racer::maze so the agents work the same way on both.
+     */
+    template <size_t row_count, size_t column_count>
+    class static_maze
+    {
+    public:
+        //// Types and Constants ////
+
+        /**
+         * @param element_count The number of elements in the flattened maze.
+         */
+        static constexpr size_t element_count = row_count * column_count;
+
+        /**
+         * @param index_type The smallest unsigned integer type that can index every element.
+         */
+        using index_type = fitting_index_type<element_count>;
+
+        /**
+         * @param no_path The value stored in connected_paths when there is no connected path in that direction.
+         */
+        static constexpr index_type no_path = std::numeric_limits<index_type>::max();
+
+        //// Constructors ////
+
+        /**
+         * @brief Construct a static maze from a string literal of the maze elements.
+         *
+         * @param layout The maze characters row by row, using the same characters as maze files. Spaces, commas, tabs, and newlines are ignored so rows can be laid out in the source.
+         * @result Loads the maze into the object and builds the connected_paths graph.
+         * @warning Throws the same exceptions as NPC_Racer::maze if the layout is the wrong size or doesn't have one `@` and one `X`. In a constant expression this is a compile error.
+         * @note There is no size header, the size comes from the template arguments.
+         */
+        template <size_t length>
+        constexpr static_maze(const char (&layout)[length]);
+
+        //// Member Functions ////
+        /**
+         * @brief Returns a string of of the maze as a fixed-width 2D array of the maze character elements.
+         *
+         * @return A string of fixed-width 2D array of the maze character elements.
+         */
+        std::string stringify() const;
+
+        /**
+         * @brief Says whether the maze element at that position is free or not.
+         *
+         * @param row The row position of the requested element, indexed from 0 at the top of the maze.
+         * @param column The column position of the requested element, indexed from 0 at the left of the maze.
+         *
+         * @return Boolean of if the position is free. Free is true, barrier or out of bounds is false.
+         */
+        constexpr bool is_free(const int64_t row, const int64_t column) const;
+
+        /**
+         * @brief Gives the number of rows of the maze.
+         * @return The number of rows of the rectangular maze.
+         */
+        static constexpr size_t rows() { return row_count; }
+
+        /**
+         * @brief Gives the number of columns of the maze.
+         * @return The number of columns of the rectangular maze.
+         */
+        static constexpr size_t columns() { return column_count; }
+
+        //// Public Data Members ////
+        /**
+         * @param start_position index of the start position in the flattened maze array.
+         */
+        index_type start_position = 0;
+
+        /**
+         * @param destination_position index of the destination position in the flattened maze array.
+         */
+        index_type destination_position = 0;
+
+        /**
+         * @param connected_paths The edges of the maze in flattened (1-dimensional) form, same layout as NPC_Racer::maze::connected_paths.
+         */
+        std::array<std::array<index_type, 4>, element_count> connected_paths = {};
+
+        /**
+         * @param character_maze An array storing the char elements of the maze in flattened (1-dimensional) form. Used for printing.
+         */
+        std::array<char, element_count> character_maze = {};
+
+        /**
+         * @param bit_maze A bitmap representation of the maze in flattened (1-dimensional) form. True is a free space, false is a barrier.
+         * @note std::array<bool> instead of std::bitset because std::bitset can't be changed in a constant expression until C++23.
+         */
+        std::array<bool, element_count> bit_maze = {};
+    };
+
     //// External Overloaded Operators ////
     /**
      * @brief Overloaded binary operator << to print out a fixed-width 2D array of the maze elements as characters to a stream.
@@ -245,7 +694,19 @@ namespace NPC_Racer // using namespace across multiple files: https://stackoverf
      * @return A reference of out for extraction chaining.
      * @warning This print out is just for display purposes, cannot be copied into a maze file.
      */
-    std::ostream &operator<<(std::ostream &out, const maze &print_maze);
+    template <std::unsigned_integral index_type>
+    std::ostream &operator<<(std::ostream &out, const maze<index_type> &print_maze);
+
+    /**
+     * @brief Overloaded binary operator << to print out a fixed-width 2D array of the static maze elements as characters to a stream.
+     *
+     * @param out Output stream buffer that accepts strings.
+     * @param print_maze The static maze you want to print the characters of.
+     *
+     * @return A reference of out for extraction chaining.
+     */
+    template <size_t row_count, size_t column_count>
+    std::ostream &operator<<(std::ostream &out, const static_maze<row_count, column_count> &print_maze);
 
 #include <deque> // std::deque
 
@@ -309,13 +770,148 @@ void NPC_Racer::make_empty_maze_file(const size_t &rows, const size_t &columns,
     std::cout << "Empty maze file `" << file_name << "` was successfully created.\n ";
 }
 
+std::string NPC_Racer::make_generated_maze_file(const size_t &rows, const size_t &columns, const uint64_t seed, const std::string directory /* "." */)
+{
+    if ((rows < 2) or (columns < 2))
+    {
+        std::cout << "ERROR: A generated maze of size " << rows << " x " << columns << " is too small, it must be at least 2 x 2.\n";
+        throw std::invalid_argument("generated maze too small");
+    }
+
+    // cells are on even rows and columns with a wall or corridor between each pair of neighbouring cells
+    std::vector<bool> free(rows * columns, false);
+    std::mt19937_64 generator(seed); // mt19937_64 gives the same sequence everywhere, unlike the standard distributions, so using % instead
+
+    // Carving with an iterative depth-first backtracker //
+    std::vector<size_t> stack = {0};
+    free[0] = true;
+    while (!stack.empty())
+    {
+        size_t row = stack.back() / columns;
+        size_t column = stack.back() % columns;
+
+        // unvisited cells two steps away
+        std::array<size_t, 4> neighbours;
+        size_t neighbour_count = 0;
+        if ((row >= 2) and !free[(row - 2) * columns + column])
+            neighbours[neighbour_count++] = (row - 2) * columns + column;
+        if ((row + 2 < rows) and !free[(row + 2) * columns + column])
+            neighbours[neighbour_count++] = (row + 2) * columns + column;
+        if ((column >= 2) and !free[row * columns + column - 2])
+            neighbours[neighbour_count++] = row * columns + column - 2;
+        if ((column + 2 < columns) and !free[row * columns + column + 2])
+            neighbours[neighbour_count++] = row * columns + column + 2;
+
+        if (neighbour_count == 0) // dead end, backtrack
+        {
+            stack.pop_back();
+            continue;
+        }
+
+        size_t next = neighbours[generator() % neighbour_count];
+        free[next] = true;
+        free[(stack.back() + next) / 2] = true; // the wall between is halfway between the two indices
+        stack.push_back(next);
+    }
+
+    // Opening some inner walls to make loops //
+    for (size_t row = 0; row < rows; row++)
+        for (size_t column = 0; column < columns; column++)
+        {
+            bool between_row_cells = ((row % 2) == 1) and ((column % 2) == 0) and (row + 1 < rows);
+            bool between_column_cells = ((row % 2) == 0) and ((column % 2) == 1) and (column + 1 < columns);
+            if ((between_row_cells or between_column_cells) and ((generator() % 16) == 0))
+                free[row * columns + column] = true;
+        }
+
+    // Writing the maze //
+    std::string file_name = directory + "/" + std::to_string(rows) + "_" + std::to_string(columns) + "_generated_maze_" + std::to_string(seed) + ".txt";
+    std::ofstream output(file_name);
+    if (!output.is_open())
+    {
+        std::cout << "ERROR: Error opening output file `" << file_name << "`!\n";
+        exit(EXIT_FAILURE);
+    }
+
+    size_t destination = ((rows - 1) / 2 * 2) * columns + ((columns - 1) / 2 * 2); // last cell on an even row and column
+    output << rows << " " << columns << "\n";
+    for (size_t row = 0; row < rows; row++)
+    {
+        for (size_t column = 0; column < columns; column++)
+        {
+            size_t element = row * columns + column;
+            char character = free[element] ? '.' : '#';
+            if (element == 0)
+                character = '@';
+            else if (element == destination)
+                character = 'X';
+            output << character << ((column == (columns - 1)) ? "" : " ");
+        }
+        output << "\n";
+    }
+    output.close();
+    return file_name;
+}
+
+template <std::unsigned_integral index_type>
+constexpr bool NPC_Racer::index_fits(const uint64_t elements)
+{
+    // the largest value is no_path and the one below is used by agents as infinite distance
+    return elements <= (uint64_t)std::numeric_limits<index_type>::max() - 1;
+}
+
+uint64_t NPC_Racer::read_maze_elements(const std::string filename)
+{
+    const std::string whitespace = " \n\t\v\r\f"; // same trimming as the maze constructor
+    size_t start = filename.find_first_not_of(whitespace);
+    size_t end = filename.find_last_not_of(whitespace);
+    if (start == std::string::npos)
+        return 0;
+
+    std::ifstream input(filename.substr(start, end - start + 1));
+    if (!input.is_open())
+        return 0;
+    return read_maze_elements(input);
+}
+
+uint64_t NPC_Racer::read_maze_elements(std::istream &input)
+{
+    std::string header;
+    if (!std::getline(input, header))
+        return 0;
+
+    // header is `rows columns` or `rows,columns,,,` so splitting at the first non-digit
+    size_t separator_position = header.find_first_not_of("0123456789");
+    if ((separator_position == 0) or (separator_position == std::string::npos))
+        return 0;
+    size_t column_start = separator_position + 1;
+    size_t column_end = header.find_first_not_of("0123456789", column_start);
+    if (column_end == column_start)
+        return 0;
+
+    // getting the header as digits was checked above, but could still be too big for 64 bits
+    try
+    {
+        uint64_t rows = std::stoull(header.substr(0, separator_position));
+        uint64_t columns = std::stoull(header.substr(column_start, column_end - column_start));
+        if ((columns != 0) and (rows > std::numeric_limits<uint64_t>::max() / columns))
+            return std::numeric_limits<uint64_t>::max();
+        return rows * columns;
+    }
+    catch (const std::exception &)
+    {
+        return 0;
+    }
+}
+
 //// ---------- ////
 //// Maze Class ////
 //// ---------- ////
 
 //// Constructors ////
 
-NPC_Racer::maze::maze(const std::string filename)
+template <std::unsigned_integral index_type>
+NPC_Racer::maze<index_type>::maze(const std::string filename)
 {
     // Initial variables //
     bool comma_separated;                         // true if a comma separated value file. False if space separated value file.
@@ -354,36 +950,112 @@ NPC_Racer::maze::maze(const std::string filename)
     }
 
     // separated into private function to parse the maze because it's very long
+    timekeeper construction_timer;
+    construction_timer.start();
     parse_maze_file(trimmed_filename, comma_separated);
+    construction_timer.end();
+    parsing_time = construction_timer.race_time();
 
-    // creating the graph from the bit_maze //
-    size_t flattened_maze_size = row_size * column_size;
+    // the graph is built from the bit_maze on first use by adjacency() //
 
-    const std::array<int64_t, 4> empty_connected_paths = {-1, -1, -1, -1}; // default is all paths are not connected to anything.
+    row_versions.resize(row_size, 0); // no rows have changed yet
+}
 
-    connected_paths.resize(flattened_maze_size, empty_connected_paths); // an initialized graph filled with all empty path connections.
+template <std::unsigned_integral index_type>
+NPC_Racer::maze<index_type>::maze(std::istream &input, const std::string name, const bool comma_separated)
+{
+    file_name = name;
 
-    // looping through the bit_maze and filling in indicies if it works
-    for (size_t i = 0; i < flattened_maze_size; i++)
+    // same steps as reading from a file once it's open
+    timekeeper construction_timer;
+    construction_timer.start();
+    parse_maze_stream(input, comma_separated);
+    construction_timer.end();
+    parsing_time = construction_timer.race_time();
+
+    row_versions.resize(row_size, 0);
+}
+
+template <std::unsigned_integral index_type>
+NPC_Racer::maze<index_type>::maze(const std::string name, const size_t rows, const size_t columns, const index_type start, const index_type destination,
+                                  std::vector<bool> &&bits, std::vector<char> &&characters, std::vector<std::array<index_type, 4>> &&edges)
+    : start_position(start), destination_position(destination), character_maze(std::move(characters)), bit_maze(std::move(bits)),
+      file_name(name), row_size(rows), column_size(columns)
+{
+    if (!edges.empty()) // already built, so adjacency() has nothing left to do
+        std::call_once(*graph_state.once, [this, &edges]()
+                       {
+            connected_paths = std::move(edges);
+            graph_state.built = true; });
+
+    // the other starts and destinations are only kept as characters, the given ones stay first
+    start_positions.assign(1, start_position);
+    destination_positions.assign(1, destination_position);
+    for (size_t i = 0; i < character_maze.size(); i++)
     {
-        // index conversion, future work could make a private is_free function that avoids doing index arithmetic
-        int64_t row_index = (int64_t)i / (int64_t)column_size; // rounds down to nearest int?
-        int64_t column_index = (int64_t)i - (row_index * (int64_t)column_size);
-        // populating each direction in the array
-        if (is_free(row_index - 1, column_index, false))        // if up path is free
-            connected_paths[i][0] = (int64_t)(i - column_size); // storing the up index
-        if (is_free(row_index + 1, column_index, false))        // if down path is free
-            connected_paths[i][1] = (int64_t)(i + column_size); // storing the down index
-        if (is_free(row_index, column_index - 1, false))        // if left path is free
-            connected_paths[i][2] = (int64_t)(i - 1);           // storing the left index
-        if (is_free(row_index, column_index + 1, false))        // if right path is free
-            connected_paths[i][3] = (int64_t)(i + 1);           // storing the right index
+        if ((character_maze[i] == '@') and (i != start_position))
+            start_positions.push_back((index_type)i);
+        else if ((character_maze[i] == 'X') and (i != destination_position))
+            destination_positions.push_back((index_type)i);
     }
+
+    row_versions.resize(row_size, 0);
+}
+
+//// Graph Member Functions ////
+
+template <std::unsigned_integral index_type>
+const std::vector<std::array<index_type, 4>> &NPC_Racer::maze<index_type>::adjacency() const
+{
+    std::call_once(*graph_state.once, [this]()
+                   {
+        timekeeper construction_timer;
+        construction_timer.start();
+        build_connected_paths();
+        construction_timer.end();
+        graph_construction_time = construction_timer.race_time();
+        graph_state.built = true; });
+    return connected_paths;
+}
+
+template <std::unsigned_integral index_type>
+NPC_Racer::maze<index_type>::graph_build_state::graph_build_state(const graph_build_state &other) : built(other.built)
+{
+    if (built) // the copied connected_paths is already built, so adjacency() has nothing to do
+        std::call_once(*once, []() {});
+}
+
+template <std::unsigned_integral index_type>
+NPC_Racer::maze<index_type>::graph_build_state::graph_build_state(graph_build_state &&other) : once(std::move(other.once)), built(other.built)
+{
+    // the moved from maze has lost its connected_paths, so it is left unbuilt with a fresh flag like a new maze
+    other.once = std::make_unique<std::once_flag>();
+    other.built = false;
+}
+
+template <std::unsigned_integral index_type>
+typename NPC_Racer::maze<index_type>::graph_build_state &NPC_Racer::maze<index_type>::graph_build_state::operator=(const graph_build_state &other)
+{
+    graph_build_state copy(other);
+    return *this = std::move(copy);
+}
+
+template <std::unsigned_integral index_type>
+typename NPC_Racer::maze<index_type>::graph_build_state &NPC_Racer::maze<index_type>::graph_build_state::operator=(graph_build_state &&other)
+{
+    if (this == &other)
+        return *this;
+    once = std::move(other.once);
+    built = other.built;
+    other.once = std::make_unique<std::once_flag>();
+    other.built = false;
+    return *this;
 }
 
 //// Public Member Functions ////
 
-std::string NPC_Racer::maze::stringify() const
+template <std::unsigned_integral index_type>
+std::string NPC_Racer::maze<index_type>::stringify() const
 {
     std::string print_accumulator;
     // print maze as characters surrounded by spaces with newlines
@@ -399,13 +1071,16 @@ std::string NPC_Racer::maze::stringify() const
     return print_accumulator;
 }
 
-void NPC_Racer::maze::print_maze() const
+template <std::unsigned_integral index_type>
+void NPC_Racer::maze<index_type>::print_maze() const
 {
     std::cout << "Printing maze `" << file_name << "`\n";
     std::cout << this->stringify();
 }
 
-void NPC_Racer::maze::print_path_on_maze(const std::deque<uint64_t> &path) const
+template <std::unsigned_integral index_type>
+template <typename path_type>
+void NPC_Racer::maze<index_type>::print_path_on_maze(const path_type &path) const
 {
     // variables
     std::vector<char> character_path_maze = character_maze; // version of the maze with the path on it
@@ -413,21 +1088,25 @@ void NPC_Racer::maze::print_path_on_maze(const std::deque<uint64_t> &path) const
     // Path displays can only be single characters but we can still use [0-9][A-Z][a-z] if the path is 62 long or shorter
     std::string short_path_characters = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
 
-    // looping through the path and adding it to the character version
-    for (size_t i = 0; i < path.size(); i++)
+    // looping through the path and adding it to the character version, walked in order so compact paths decode as they go
+    size_t path_point = 0;
+    for (index_type position : path)
     {
         // using ASCII table letters to display but has a limit of 57 characters before we run out of upper/lowercase
         if (path.size() <= 62)
-            path_char = short_path_characters[i]; // based on https://stackoverflow.com/questions/4629050/convert-an-int-to-ascii-character
+            path_char = short_path_characters[path_point]; // based on https://stackoverflow.com/questions/4629050/convert-an-int-to-ascii-character
 
-        character_path_maze[path[i]] = path_char; // adds the position number of the path point to the character_path_maze
+        character_path_maze[position] = path_char; // adds the position number of the path point to the character_path_maze
+        path_point++;
     }
 
     // if path large adding back start and end characters to make it more readable
     if (path.size() > 61)
     {
-        character_path_maze[start_position] = '@';
-        character_path_maze[destination_position] = 'X';
+        for (index_type start : start_positions)
+            character_path_maze[start] = '@';
+        for (index_type destination : destination_positions)
+            character_path_maze[destination] = 'X';
     }
 
     std::cout << "Printing path on maze `" << file_name << "`\n";
@@ -448,7 +1127,8 @@ void NPC_Racer::maze::print_path_on_maze(const std::deque<uint64_t> &path) const
     std::cout << print_accumulator << "\n";
 }
 
-bool NPC_Racer::maze::is_free(const int64_t row, const int64_t column, const bool out_of_bounds_warning) const
+template <std::unsigned_integral index_type>
+bool NPC_Racer::maze<index_type>::is_free(const int64_t row, const int64_t column, const bool out_of_bounds_warning) const
 {
     // bound checking guard, ints are signed so can be negative or bigger than maze size
     if ((row < 0) or (row > ((int64_t)row_size - 1)) or (column < 0) or (column > ((int64_t)column_size - 1))) // need to cast unsigned ints
@@ -472,9 +1152,254 @@ bool NPC_Racer::maze::is_free(const int64_t row, const int64_t column, const boo
     return bit_maze[(size_t)index];
 }
 
+template <std::unsigned_integral index_type>
+size_t NPC_Racer::maze<index_type>::rows() const
+{
+    return row_size;
+}
+
+template <std::unsigned_integral index_type>
+size_t NPC_Racer::maze<index_type>::columns() const
+{
+    return column_size;
+}
+
+//// Mutation Member Functions ////
+
+template <std::unsigned_integral index_type>
+void NPC_Racer::maze<index_type>::set_free(const size_t row, const size_t column)
+{
+    size_t index = checked_index(row, column);
+    if (bit_maze[index]) // already free, nothing changes. Also keeps `@` and `X` from being overwritten
+        return;
+
+    bit_maze[index] = true;
+    character_maze[index] = '.';
+    update_neighbour_paths(index, true);
+    bump_version(row, true);
+}
+
+template <std::unsigned_integral index_type>
+void NPC_Racer::maze<index_type>::set_blocked(const size_t row, const size_t column, const char barrier_character /* '#' */)
+{
+    size_t index = checked_index(row, column);
+    if (is_endpoint(index))
+    {
+        std::cout << "ERROR: Cannot place a barrier on a start or destination of `" << file_name << "` at"
+                  << "\n\trow   : " << row << "\n\tcolumn: " << column << "\n";
+        throw invalid_position();
+    }
+
+    character_maze[index] = barrier_character; // can change the displayed barrier even if it was already one
+    if (!bit_maze[index])                      // already a barrier so the graph doesn't change
+    {
+        bump_version(row, false);
+        return;
+    }
+
+    bit_maze[index] = false;
+    update_neighbour_paths(index, false);
+    bump_version(row, true);
+}
+
+template <std::unsigned_integral index_type>
+void NPC_Racer::maze<index_type>::move_start(const size_t row, const size_t column)
+{
+    size_t index = checked_index(row, column);
+    if (index == start_position) // not moving
+        return;
+    if ((!bit_maze[index]) or is_endpoint(index))
+    {
+        std::cout << "ERROR: Cannot move the start of `" << file_name << "` onto a barrier, another start, or a destination at"
+                  << "\n\trow   : " << row << "\n\tcolumn: " << column << "\n";
+        throw invalid_position();
+    }
+
+    character_maze[start_position] = '.'; // the old start stays a free space
+    bump_version(start_position / column_size, false);
+    start_position = (index_type)index;
+    start_positions[0] = start_position; // the other starts stay where they are
+    character_maze[index] = '@';
+    bump_version(row, false);
+}
+
+template <std::unsigned_integral index_type>
+void NPC_Racer::maze<index_type>::move_destination(const size_t row, const size_t column)
+{
+    size_t index = checked_index(row, column);
+    if (index == destination_position) // not moving
+        return;
+    if ((!bit_maze[index]) or is_endpoint(index))
+    {
+        std::cout << "ERROR: Cannot move the destination of `" << file_name << "` onto a barrier, a start, or another destination at"
+                  << "\n\trow   : " << row << "\n\tcolumn: " << column << "\n";
+        throw invalid_position();
+    }
+
+    character_maze[destination_position] = '.'; // the old destination stays a free space
+    bump_version(destination_position / column_size, false);
+    destination_position = (index_type)index;
+    destination_positions[0] = destination_position; // the other destinations stay where they are
+    character_maze[index] = 'X';
+    bump_version(row, false);
+}
+
+//// Version Member Functions ////
+
+template <std::unsigned_integral index_type>
+uint64_t NPC_Racer::maze<index_type>::version() const
+{
+    return maze_version;
+}
+
+template <std::unsigned_integral index_type>
+uint64_t NPC_Racer::maze<index_type>::graph_version() const
+{
+    return maze_graph_version;
+}
+
+template <std::unsigned_integral index_type>
+uint64_t NPC_Racer::maze<index_type>::row_version(const size_t row) const
+{
+    return row_versions.at(row); // at() because this is not on a hot path and rows can be out of range
+}
+
 //// Private Member Functions ////
 
-void NPC_Racer::maze::parse_maze_file(const std::string trimmed_filename, const bool comma_separated)
+template <std::unsigned_integral index_type>
+size_t NPC_Racer::maze<index_type>::checked_index(const size_t row, const size_t column) const
+{
+    if ((row >= row_size) or (column >= column_size))
+    {
+        std::cout << "ERROR: Attempting to change an element outside the bounds of `"
+                  << file_name << "` at"
+                  << "\n\trow   : " << row << "\n\tcolumn: " << column
+                  << "\nMaze row bounds   : 0 to " << (row_size - 1)
+                  << "\nMaze column bounds: 0 to " << (column_size - 1)
+                  << "\nElements must be within the maze bounds.\n";
+        throw out_of_bounds();
+    }
+    return row * column_size + column;
+}
+
+template <std::unsigned_integral index_type>
+bool NPC_Racer::maze<index_type>::is_endpoint(const size_t index) const
+{
+    // the characters are kept in step with the positions, so mutations stay O(1) on mazes with many exits
+    char character = character_maze[index];
+    return (character == '@') or (character == 'X') or (character == 'x');
+}
+
+template <std::unsigned_integral index_type>
+void NPC_Racer::maze<index_type>::update_neighbour_paths(const size_t index, const bool connected)
+{
+    if (!graph_state.built) // built from the current bit_maze when it's first used instead
+        return;
+
+    // each neighbour stores this element in the opposite direction, e.g. the element above stores it as down
+    index_type path = connected ? (index_type)index : no_path;
+    size_t column = index % column_size;
+
+    if (index >= column_size) // has an up neighbour
+        connected_paths[index - column_size][1] = path;
+    if (index + column_size < connected_paths.size()) // has a down neighbour
+        connected_paths[index + column_size][0] = path;
+    if (column > 0) // has a left neighbour
+        connected_paths[index - 1][3] = path;
+    if (column < column_size - 1) // has a right neighbour
+        connected_paths[index + 1][2] = path;
+}
+
+template <std::unsigned_integral index_type>
+void NPC_Racer::maze<index_type>::bump_version(const size_t row, const bool graph_changed)
+{
+    maze_version++;
+    if (graph_changed)
+        maze_graph_version++;
+    row_versions[row] = maze_version;
+}
+
+template <std::unsigned_integral index_type>
+void NPC_Racer::maze<index_type>::build_connected_paths() const
+{
+    size_t flattened_maze_size = row_size * column_size;
+
+    const std::array<index_type, 4> empty_connected_paths = {no_path, no_path, no_path, no_path}; // default is all paths are not connected to anything.
+
+    connected_paths.resize(flattened_maze_size, empty_connected_paths); // an initialized graph filled with all empty path connections.
+
+    // hardware_concurrency can return 0 if it's unknown so always at least 1 thread
+    size_t number_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    if ((flattened_maze_size < parallel_construction_threshold) or (number_threads == 1) or (row_size < 2))
+    {
+        build_connected_path_rows(0, row_size);
+        return;
+    }
+
+    // splitting the rows into one contiguous block per thread, each thread only writes to its own rows
+    number_threads = std::min(number_threads, row_size);
+    size_t rows_per_thread = (row_size + number_threads - 1) / number_threads; // rounding up so all rows are covered
+    std::vector<std::thread> builders;
+    builders.reserve(number_threads);
+    for (size_t first_row = 0; first_row < row_size; first_row += rows_per_thread)
+        builders.emplace_back(&maze::build_connected_path_rows, this, first_row, std::min(first_row + rows_per_thread, row_size));
+
+    for (std::thread &builder : builders)
+        builder.join();
+}
+
+template <std::unsigned_integral index_type>
+void NPC_Racer::maze<index_type>::build_connected_path_rows(const size_t first_row, const size_t last_row) const
+{
+    // padded byte rows, one element of barrier on each side so left and right never go out of bounds
+    // the element at column j is stored at [j + 1]
+    std::vector<uint8_t> above_row(column_size + 2, 0);
+    std::vector<uint8_t> current_row(column_size + 2, 0);
+    std::vector<uint8_t> below_row(column_size + 2, 0);
+
+    // unpacking a row of the bit_maze into a padded byte row, rows outside the maze are all barriers
+    auto unpack_row = [this](std::vector<uint8_t> &byte_row, const size_t row)
+    {
+        if (row >= row_size)
+        {
+            std::fill(byte_row.begin(), byte_row.end(), 0);
+            return;
+        }
+        size_t row_start = row * column_size;
+        for (size_t j = 0; j < column_size; j++)
+            byte_row[j + 1] = bit_maze[row_start + j];
+    };
+
+    if (first_row > 0)
+        unpack_row(above_row, first_row - 1);
+    unpack_row(current_row, first_row);
+
+    for (size_t row = first_row; row < last_row; row++)
+    {
+        unpack_row(below_row, row + 1);
+
+        size_t row_start = row * column_size;
+        std::array<index_type, 4> *row_paths = connected_paths.data() + row_start;
+
+        // populating each direction with selects instead of branches
+        // the wrapped around values for the first row/column are never stored because the padding is a barrier
+        for (size_t j = 0; j < column_size; j++)
+        {
+            size_t index = row_start + j;
+            row_paths[j][0] = above_row[j + 1] ? (index_type)(index - column_size) : no_path; // up
+            row_paths[j][1] = below_row[j + 1] ? (index_type)(index + column_size) : no_path; // down
+            row_paths[j][2] = current_row[j] ? (index_type)(index - 1) : no_path;             // left
+            row_paths[j][3] = current_row[j + 2] ? (index_type)(index + 1) : no_path;         // right
+        }
+
+        // rolling the rows down one, swapping avoids copying
+        std::swap(above_row, current_row);
+        std::swap(current_row, below_row);
+    }
+}
+
+template <std::unsigned_integral index_type>
+void NPC_Racer::maze<index_type>::parse_maze_file(const std::string trimmed_filename, const bool comma_separated)
 {
     // Opening the ifstream, from: https://baraksh.com/CSE701/notes.php#io-streams-and-files
     std::ifstream input(trimmed_filename);
@@ -485,7 +1410,15 @@ void NPC_Racer::maze::parse_maze_file(const std::string trimmed_filename, const
     }
 
     file_name = trimmed_filename; // now that we know it's a valid file, setting the class data member file name
+    parse_maze_stream(input, comma_separated);
 
+    std::cout << "Maze `" << file_name << "` has been successfully read!\n";
+    input.close(); // Always have to close the file!
+}
+
+template <std::unsigned_integral index_type>
+void NPC_Racer::maze<index_type>::parse_maze_stream(std::istream &input, const bool comma_separated)
+{
     // Variables for actually parsing //
 
     uint64_t row = 0;                             // row position.
@@ -499,8 +1432,7 @@ void NPC_Racer::maze::parse_maze_file(const std::string trimmed_filename, const
     bool destination_position_read = false;       // flag for destination position counting.
 
     // Going through the header line //
-    input.get(input_character);     // get first character
-    while (input_character != '\n') // go until first line is done
+    while (input.get(input_character) and (input_character != '\n')) // go until first line is done, or the input ends
     {
         if ((!std::isdigit(input_character)) and (input_character != separator)) // guard for non-digit/separator character
         {
@@ -517,14 +1449,27 @@ void NPC_Racer::maze::parse_maze_file(const std::string trimmed_filename, const
         else if (input_character == separator)
             separated = true;
 
-        input.get(input_character); // get next character
-        column++;                   // increment column count
+        column++; // increment column count
+    }
+
+    if (row_size_accumulator.empty() or column_size_accumulator.empty()) // guard for a missing or cut off header
+    {
+        std::cout << "ERROR: Missing maze size in `" << file_name << "`\nThe first row must be the number of rows and columns.\n";
+        throw invalid_digit();
     }
 
     // converting and storing in data members
     row_size = std::stoull(row_size_accumulator);
     column_size = std::stoull(column_size_accumulator);
 
+    // checking all the elements can be indexed before allocating anything
+    if (((column_size != 0) and (row_size > std::numeric_limits<size_t>::max() / column_size)) or !index_fits<index_type>(row_size * column_size))
+    {
+        std::cout << "ERROR: Maze `" << file_name << "` of size " << row_size << " x " << column_size
+                  << " has too many elements for a " << (sizeof(index_type) * 8) << "-bit index.\n";
+        throw index_overflow();
+    }
+
     // resizing and initializing bit_maze and character_maze with amount they will need
     bit_maze.reserve(row_size * column_size);
     character_maze.reserve(row_size * column_size);
@@ -603,19 +1548,12 @@ void NPC_Racer::maze::parse_maze_file(const std::string trimmed_filename, const
         }
         else if (input_character == '@') // start position
         {
-            if (!start_position_read) // storing index if not one in maze already
+            if (!start_position_read) // the first is the start single-start agents use
             {
-                start_position = (row - 1) * column_size + (column / 2);
+                start_position = (index_type)((row - 1) * column_size + (column / 2));
                 start_position_read = true; // setting flag
             }
-            else // start position read so duplicate
-            {
-                std::cout << "ERROR: Duplicate character `" << input_character
-                          << "` in file `" << file_name
-                          << "` at \n\trow   : " << row << "\n\tcolumn: " << column
-                          << "\nThere can only be one start position `@` in a maze.\n";
-                throw double_character();
-            }
+            start_positions.push_back((index_type)((row - 1) * column_size + (column / 2)));
             // storing free space in bit and character map in right place
             // because we are error checking can use [] over .at() for speed
             bit_maze[(row - 1) * column_size + (column / 2)] = true; // start is a free space
@@ -623,19 +1561,12 @@ void NPC_Racer::maze::parse_maze_file(const std::string trimmed_filename, const
         }
         else if ((input_character == 'X') or (input_character == 'x')) // destination position
         {
-            if (!destination_position_read) // storing index if not one in maze already
+            if (!destination_position_read) // the first is the destination single-destination agents use
             {
-                destination_position = (row - 1) * column_size + (column / 2);
+                destination_position = (index_type)((row - 1) * column_size + (column / 2));
                 destination_position_read = true; // setting flag
             }
-            else // start position read so duplicate
-            {
-                std::cout << "ERROR: Duplicate character `" << input_character
-                          << "` in file `" << file_name
-                          << "` at \n\trow   : " << row << "\n\tcolumn: " << column
-                          << "\nThere can only be one destination position `X` in a maze.\n";
-                throw double_character();
-            }
+            destination_positions.push_back((index_type)((row - 1) * column_size + (column / 2)));
 
             // comments same as start position
             bit_maze[(row - 1) * column_size + (column / 2)] = true;
@@ -656,13 +1587,13 @@ void NPC_Racer::maze::parse_maze_file(const std::string trimmed_filename, const
     if (!start_position_read)
     {
         std::cout << "ERROR: Invalid maze file `" << file_name
-                  << "`\nThere must be one start position `@` in a maze.\n";
+                  << "`\nThere must be at least one start position `@` in a maze.\n";
         throw invalid_maze();
     }
     if (!destination_position_read)
     {
         std::cout << "ERROR: Invalid maze file `" << file_name
-                  << "`\nThere must be one destination position `X` in a maze.\n";
+                  << "`\nThere must be at least one destination position `X` in a maze.\n";
         throw invalid_maze();
     }
 
@@ -676,14 +1607,114 @@ void NPC_Racer::maze::parse_maze_file(const std::string trimmed_filename, const
                   << "\nMaze must be the rectangular size specified in the first row.\n";
         throw incorrect_maze_size();
     }
+}
 
-    std::cout << "Maze `" << file_name << "` has been successfully read!\n";
-    input.close(); // Always have to close the file!
+//// ----------------- ////
+//// Static Maze Class ////
+//// ----------------- ////
+
+//// Constructors ////
+
+template <size_t row_count, size_t column_count>
+template <size_t length>
+constexpr NPC_Racer::static_maze<row_count, column_count>::static_maze(const char (&layout)[length])
+{
+    // can't print errors in a constant expression so reusing the maze exceptions without the messages
+    using maze_exceptions = NPC_Racer::maze<index_type>;
+    static_assert(element_count > 0, "A static maze must have at least one element.");
+
+    size_t element = 0; // element being read
+    bool start_position_read = false;
+    bool destination_position_read = false;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        char input_character = layout[i];
+        // skipping separators and the null terminator of the literal
+        if ((input_character == ' ') or (input_character == ',') or (input_character == '\n') or (input_character == '\t') or (input_character == '\r') or (input_character == '\0'))
+            continue;
+
+        if (element >= element_count)
+            throw typename maze_exceptions::incorrect_maze_size();
+
+        if (input_character == '@')
+        {
+            if (start_position_read)
+                throw typename maze_exceptions::double_character();
+            start_position = (index_type)element;
+            start_position_read = true;
+        }
+        else if ((input_character == 'X') or (input_character == 'x'))
+        {
+            if (destination_position_read)
+                throw typename maze_exceptions::double_character();
+            destination_position = (index_type)element;
+            destination_position_read = true;
+        }
+
+        bit_maze[element] = (input_character == '.') or (input_character == '@') or (input_character == 'X') or (input_character == 'x');
+        character_maze[element] = input_character;
+        element++;
+    }
+
+    if (element != element_count)
+        throw typename maze_exceptions::incorrect_maze_size();
+    if (!start_position_read or !destination_position_read)
+        throw typename maze_exceptions::invalid_maze();
+
+    // creating the graph row by row, all of the sizes are template arguments so the index arithmetic is folded
+    for (size_t row = 0; row < row_count; row++)
+    {
+        for (size_t column = 0; column < column_count; column++)
+        {
+            size_t index = row * column_count + column;
+            connected_paths[index][0] = ((row > 0) and bit_maze[index - column_count]) ? (index_type)(index - column_count) : no_path;                 // up
+            connected_paths[index][1] = ((row + 1 < row_count) and bit_maze[index + column_count]) ? (index_type)(index + column_count) : no_path;     // down
+            connected_paths[index][2] = ((column > 0) and bit_maze[index - 1]) ? (index_type)(index - 1) : no_path;                                   // left
+            connected_paths[index][3] = ((column + 1 < column_count) and bit_maze[index + 1]) ? (index_type)(index + 1) : no_path;                     // right
+        }
+    }
+}
+
+//// Member Functions ////
+
+template <size_t row_count, size_t column_count>
+std::string NPC_Racer::static_maze<row_count, column_count>::stringify() const
+{
+    std::string print_accumulator;
+    print_accumulator.reserve(element_count * 2 + row_count);
+    // print maze as characters surrounded by spaces with newlines
+    for (size_t i = 0; i < row_count; i++)
+    {
+        for (size_t j = 0; j < column_count; j++)
+        {
+            print_accumulator += character_maze[i * column_count + j];
+            print_accumulator += " ";
+        }
+        print_accumulator += "\n";
+    }
+    return print_accumulator;
+}
+
+template <size_t row_count, size_t column_count>
+constexpr bool NPC_Racer::static_maze<row_count, column_count>::is_free(const int64_t row, const int64_t column) const
+{
+    if ((row < 0) or (row >= (int64_t)row_count) or (column < 0) or (column >= (int64_t)column_count))
+        return false;
+    return bit_maze[(size_t)row * column_count + (size_t)column];
 }
 
 //// External Overloaded Operators ////
 
-std::ostream &NPC_Racer::operator<<(std::ostream &out, const maze &print_maze)
+template <std::unsigned_integral index_type>
+std::ostream &NPC_Racer::operator<<(std::ostream &out, const maze<index_type> &print_maze)
+{
+    out << print_maze.stringify(); // put the string in the stream
+    return out;
+}
+
+template <size_t row_count, size_t column_count>
+std::ostream &NPC_Racer::operator<<(std::ostream &out, const static_maze<row_count, column_count> &print_maze)
 {
     out << print_maze.stringify(); // put the string in the stream
     return out;
@@ -0,0 +1,319 @@
+/**
+ * @file npc_racer.cpp
+ * @author Brendan Fallon (fallonbr@mcmaster.ca) (https://github.com/bren007pie)
+ * @brief The NPC Racer shared library, implements the C interface in npc_racer.h over the header-only mazes and agents.
+ * @version 1.0
+ * @date Sunday October 18, 2026
+ * @copyright Copyright (c) 2022 Brendan Fallon
+ */
+
+//// Preprocessor Directives ////
+#define NPC_RACER_BUILDING_LIBRARY
+#include "npc_racer.h"    // the C interface
+#include <string>         // std::string
+#include <vector>         // std::vector
+#include <fstream>        // std::ifstream
+#include <istream>        // std::istream
+#include <streambuf>      // std::streambuf
+#include <memory>         // std::unique_ptr, std::make_unique
+#include <variant>        // std::variant, std::visit
+#include <algorithm>      // std::copy
+#include <exception>      // std::exception
+#include <cstdint>        // uint16_t, uint32_t, uint64_t
+#include <concepts>       // std::unsigned_integral
+#include "mazes.hpp"      // NPC_Racer::maze, NPC_Racer::index_fits, NPC_Racer::read_maze_elements
+#include "agents.hpp"     // NPC_Racer::race_agents, NPC_Racer::for_each_agent
+
+/**
+ * @brief A loaded maze with the smallest index type that fits it, the opaque type behind npc_maze pointers.
+ */
+struct npc_maze
+{
+    std::variant<std::unique_ptr<NPC_Racer::maze<uint16_t>>, std::unique_ptr<NPC_Racer::maze<uint32_t>>,
+                 std::unique_ptr<NPC_Racer::maze<uint64_t>>>
+        race_maze;
+};
+
+namespace NPC_Racer
+{
+    //// Private Helper Functions ////
+    // only used by this library so kept out of the interface
+
+    /**
+     * @brief The message of the last error on each thread, given by npc_last_error.
+     */
+    thread_local std::string last_error;
+
+    /**
+     * @brief A read-only stream buffer over memory so a maze in memory is parsed without copying it.
+     */
+    class memory_buffer : public std::streambuf
+    {
+    public:
+        memory_buffer(const char *buffer, const size_t size)
+        {
+            char *start = const_cast<char *>(buffer); // only ever read, streambuf just has no const get area
+            setg(start, start, start + size);
+        }
+
+    protected:
+        pos_type seekpos(pos_type position, std::ios_base::openmode) override
+        {
+            if ((position < 0) or (position > egptr() - eback()))
+                return pos_type(off_type(-1));
+            setg(eback(), eback() + position, egptr());
+            return position;
+        }
+    };
+
+    /**
+     * @brief Reads a maze from a stream with the smallest index type that fits it.
+     */
+    int32_t load_maze(std::istream &input, const std::string &name, const bool comma_separated, npc_maze **loaded)
+    {
+        if (loaded == nullptr)
+        {
+            last_error = "npc_maze pointer to set is null";
+            return NPC_ERROR_INVALID_ARGUMENT;
+        }
+        *loaded = nullptr;
+
+        uint64_t elements = read_maze_elements(input);
+        if (elements == 0)
+        {
+            last_error = "could not read the maze size header of `" + name + "`";
+            return NPC_ERROR_LOAD_FAILED;
+        }
+        input.clear();
+        input.seekg(0); // the maze reads the header again
+
+        try
+        {
+            std::unique_ptr<npc_maze> result = std::make_unique<npc_maze>();
+            if (index_fits<uint16_t>(elements))
+                result->race_maze = std::make_unique<maze<uint16_t>>(input, name, comma_separated);
+            else if (index_fits<uint32_t>(elements))
+                result->race_maze = std::make_unique<maze<uint32_t>>(input, name, comma_separated);
+            else
+                result->race_maze = std::make_unique<maze<uint64_t>>(input, name, comma_separated);
+            *loaded = result.release();
+        }
+        catch (const std::exception &error)
+        {
+            last_error = error.what();
+            return NPC_ERROR_LOAD_FAILED;
+        }
+        return NPC_OK;
+    }
+
+    /**
+     * @brief Answers a batch of queries on a maze with one agent, writing the paths into the caller's buffer.
+     */
+    template <std::unsigned_integral index_type>
+    int32_t find_paths(const maze<index_type> &race_maze, const uint32_t agent, const npc_path_query *queries, const size_t query_count,
+                       npc_path_result *results, uint64_t *path_buffer, const size_t path_capacity, size_t &path_used)
+    {
+        // each thread keeps its own agents so concurrent queries never share scratch memory, and reuses them between calls
+        thread_local race_agents::agents<index_type> agents = []()
+        {
+            race_agents::agents<index_type> quiet_agents;
+            for_each_agent(quiet_agents, [](auto &quiet_agent, size_t)
+                           { quiet_agent.warnings = false; });
+            return quiet_agents;
+        }();
+
+        int32_t status = NPC_OK;
+        for_each_agent(agents, [&](auto &racer, const size_t i)
+                       {
+            if (i != agent)
+                return;
+            for (size_t q = 0; q < query_count; q++)
+            {
+                const npc_path_query &query = queries[q];
+                npc_path_result &result = results[q];
+                result = {};
+                result.path_offset = path_used;
+
+                if ((query.start_row >= race_maze.rows()) or (query.start_column >= race_maze.columns()) or
+                    (query.destination_row >= race_maze.rows()) or (query.destination_column >= race_maze.columns()) or
+                    !race_maze.is_free((int64_t)query.start_row, (int64_t)query.start_column, false) or
+                    !race_maze.is_free((int64_t)query.destination_row, (int64_t)query.destination_column, false))
+                {
+                    result.status = NPC_ERROR_INVALID_POSITION;
+                    continue;
+                }
+                index_type start_position = (index_type)(query.start_row * race_maze.columns() + query.start_column);
+                index_type destination_position = (index_type)(query.destination_row * race_maze.columns() + query.destination_column);
+
+                const std::vector<index_type> &path = racer.pathfind(race_maze, start_position, destination_position);
+                result.nodes_explored = racer.nodes_explored;
+
+                // a one position path is only a path when the start is the destination
+                if (!racer.pathfinding_completed or ((path.size() <= 1) and (start_position != destination_position)))
+                {
+                    result.status = NPC_NO_PATH;
+                    continue;
+                }
+
+                result.path_length = path.size();
+                if (path_buffer == nullptr) // only the lengths were asked for
+                    result.status = NPC_OK;
+                else if (path.size() > path_capacity - path_used)
+                {
+                    result.status = NPC_ERROR_PATH_BUFFER_TOO_SMALL;
+                    status = NPC_ERROR_PATH_BUFFER_TOO_SMALL;
+                }
+                else
+                {
+                    std::copy(path.begin(), path.end(), path_buffer + path_used);
+                    path_used += path.size();
+                    result.status = NPC_OK;
+                }
+            } });
+        return status;
+    }
+}
+
+//// Interface Functions ////
+
+uint32_t npc_abi_version(void)
+{
+    return NPC_RACER_ABI_VERSION;
+}
+
+const char *npc_status_string(int32_t status)
+{
+    switch (status)
+    {
+    case NPC_OK:
+        return "ok";
+    case NPC_NO_PATH:
+        return "no path";
+    case NPC_ERROR_INVALID_ARGUMENT:
+        return "invalid argument";
+    case NPC_ERROR_LOAD_FAILED:
+        return "maze load failed";
+    case NPC_ERROR_INVALID_POSITION:
+        return "position is out of bounds or a barrier";
+    case NPC_ERROR_PATH_BUFFER_TOO_SMALL:
+        return "path buffer too small";
+    case NPC_ERROR_INTERNAL:
+        return "internal error";
+    default:
+        return "unknown status";
+    }
+}
+
+const char *npc_last_error(void)
+{
+    return NPC_Racer::last_error.c_str();
+}
+
+int32_t npc_maze_load_file(const char *filename, npc_maze **maze)
+{
+    if (filename == nullptr)
+    {
+        NPC_Racer::last_error = "maze file name is null";
+        return NPC_ERROR_INVALID_ARGUMENT;
+    }
+
+    // opened here instead of by the maze constructor, which exits the program on a missing file
+    std::string name = filename;
+    std::string extension = name.substr(name.find_last_of('.') + 1);
+    std::ifstream input(name);
+    if (!input.is_open() or ((extension != "txt") and (extension != "csv")))
+    {
+        NPC_Racer::last_error = "could not open maze file `" + name + "`, it must exist and end in `.txt` or `.csv`";
+        if (maze != nullptr)
+            *maze = nullptr;
+        return NPC_ERROR_LOAD_FAILED;
+    }
+    return NPC_Racer::load_maze(input, name, extension == "csv", maze);
+}
+
+int32_t npc_maze_load_buffer(const char *buffer, size_t size, int comma_separated, npc_maze **maze)
+{
+    if (buffer == nullptr)
+    {
+        NPC_Racer::last_error = "maze buffer is null";
+        return NPC_ERROR_INVALID_ARGUMENT;
+    }
+    NPC_Racer::memory_buffer memory(buffer, size);
+    std::istream input(&memory);
+    return NPC_Racer::load_maze(input, "memory buffer", comma_separated != 0, maze);
+}
+
+void npc_maze_free(npc_maze *maze)
+{
+    delete maze;
+}
+
+uint64_t npc_maze_rows(const npc_maze *maze)
+{
+    return (maze == nullptr) ? 0 : std::visit([](const auto &race_maze) -> uint64_t
+                                              { return race_maze->rows(); },
+                                              maze->race_maze);
+}
+
+uint64_t npc_maze_columns(const npc_maze *maze)
+{
+    return (maze == nullptr) ? 0 : std::visit([](const auto &race_maze) -> uint64_t
+                                              { return race_maze->columns(); },
+                                              maze->race_maze);
+}
+
+uint64_t npc_maze_start(const npc_maze *maze)
+{
+    return (maze == nullptr) ? 0 : std::visit([](const auto &race_maze) -> uint64_t
+                                              { return race_maze->start_position; },
+                                              maze->race_maze);
+}
+
+uint64_t npc_maze_destination(const npc_maze *maze)
+{
+    return (maze == nullptr) ? 0 : std::visit([](const auto &race_maze) -> uint64_t
+                                              { return race_maze->destination_position; },
+                                              maze->race_maze);
+}
+
+uint32_t npc_agent_count(void)
+{
+    return (uint32_t)NPC_Racer::race_agents::size;
+}
+
+const char *npc_agent_name(uint32_t agent)
+{
+    // the names are string literals so they end in a null character
+    return (agent < NPC_Racer::race_agents::size) ? NPC_Racer::race_agents::names[agent].data() : nullptr;
+}
+
+int32_t npc_find_paths(const npc_maze *maze, uint32_t agent, const npc_path_query *queries, size_t query_count,
+                       npc_path_result *results, uint64_t *path_buffer, size_t path_capacity, size_t *path_used)
+{
+    size_t used = 0;
+    if (path_used != nullptr)
+        *path_used = 0;
+    if ((maze == nullptr) or (agent >= NPC_Racer::race_agents::size) or ((query_count > 0) and ((queries == nullptr) or (results == nullptr))))
+    {
+        NPC_Racer::last_error = "npc_find_paths needs a maze, a valid agent, and the queries and results";
+        return NPC_ERROR_INVALID_ARGUMENT;
+    }
+    if (path_buffer == nullptr)
+        path_capacity = 0;
+
+    // exceptions can't cross into C so any unexpected one becomes an error status
+    try
+    {
+        int32_t status = std::visit([&](const auto &race_maze)
+                                    { return NPC_Racer::find_paths(*race_maze, agent, queries, query_count, results, path_buffer, path_capacity, used); },
+                                    maze->race_maze);
+        if (path_used != nullptr)
+            *path_used = used;
+        return status;
+    }
+    catch (const std::exception &error)
+    {
+        NPC_Racer::last_error = error.what();
+        return NPC_ERROR_INTERNAL;
+    }
+}
@@ -0,0 +1,195 @@
+/**
+ * @file npc_racer.h
+ * @author Brendan Fallon (fallonbr@mcmaster.ca) (https://github.com/bren007pie)
+ * @brief The C interface of the NPC Racer shared library, for linking the mazes and agents from C, C#, or any other language with a C FFI.
+ * @version 1.0
+ * @date Sunday October 18, 2026
+ * @copyright Copyright (c) 2022 Brendan Fallon
+ *
+ * @note Build the library with: g++ npc_racer.cpp -std=c++20 -O2 -shared -fPIC -fvisibility=hidden -o libnpc_racer.so
+ *
+ * Thread safety: a loaded maze is never changed by queries, so any number of threads can call npc_find_paths on the same
+ * maze at once. Each thread searches with its own agents, which keep their scratch memory between calls so a thread
+ * only allocates on its first query or its first query on a bigger maze. A maze must not be freed while it's queried.
+ * Loading only parses the maze, its connected paths are built by the first query on it while any others wait.
+ */
+
+//// Preprocessor Directives ////
+#ifndef NPC_RACER_H
+#define NPC_RACER_H
+
+#include <stddef.h> /* size_t */
+#include <stdint.h> /* uint32_t, uint64_t, int32_t */
+
+#if defined(_WIN32)
+#if defined(NPC_RACER_BUILDING_LIBRARY)
+#define NPC_RACER_API __declspec(dllexport)
+#else
+#define NPC_RACER_API __declspec(dllimport)
+#endif
+#else
+#define NPC_RACER_API __attribute__((visibility("default")))
+#endif
+
+/**
+ * @brief The version of this interface, only increased when a change would break callers built against an older one.
+ */
+#define NPC_RACER_ABI_VERSION 1
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    //// ----- ////
+    //// Types ////
+    //// ----- ////
+    /**
+     * @brief A loaded maze. Only used through pointers given by the load functions.
+     */
+    typedef struct npc_maze npc_maze;
+
+    /**
+     * @brief The result of a call or of one query. Errors are negative.
+     */
+    typedef enum npc_status
+    {
+        NPC_OK = 0,                           /* success, or a path was found */
+        NPC_NO_PATH = 1,                      /* the query was valid but there is no path between its positions */
+        NPC_ERROR_INVALID_ARGUMENT = -1,      /* a null pointer where one is needed or an unknown agent */
+        NPC_ERROR_LOAD_FAILED = -2,           /* the maze couldn't be read or is invalid, see npc_last_error */
+        NPC_ERROR_INVALID_POSITION = -3,      /* a query position is out of bounds or a barrier */
+        NPC_ERROR_PATH_BUFFER_TOO_SMALL = -4, /* the path didn't fit in what was left of the path buffer */
+        NPC_ERROR_INTERNAL = -5               /* an unexpected error, see npc_last_error */
+    } npc_status;
+
+    /**
+     * @brief One path query, positions are rows and columns counted from 0 at the top left of the maze.
+     */
+    typedef struct npc_path_query
+    {
+        uint64_t start_row;
+        uint64_t start_column;
+        uint64_t destination_row;
+        uint64_t destination_column;
+    } npc_path_query;
+
+    /**
+     * @brief The answer to one path query.
+     *
+     * @note path_length is the number of positions including the start and destination, 0 if there is no path. When the
+     *      status is NPC_ERROR_PATH_BUFFER_TOO_SMALL it's the length that didn't fit.
+     */
+    typedef struct npc_path_result
+    {
+        int32_t status;          /* an npc_status */
+        uint32_t reserved;       /* always 0, keeps the layout the same on every platform */
+        uint64_t path_offset;    /* where the path starts in the path buffer */
+        uint64_t path_length;    /* positions written to the path buffer */
+        uint64_t nodes_explored; /* nodes the agent explored to answer */
+    } npc_path_result;
+
+    //// --------- ////
+    //// Functions ////
+    //// --------- ////
+    /**
+     * @brief Returns NPC_RACER_ABI_VERSION of the library, to check it matches the header at run time.
+     */
+    NPC_RACER_API uint32_t npc_abi_version(void);
+
+    /**
+     * @brief Returns a short description of a status.
+     */
+    NPC_RACER_API const char *npc_status_string(int32_t status);
+
+    /**
+     * @brief Returns the message of the last error on the calling thread, empty if there hasn't been one.
+     *
+     * @note The string stays valid until the next call on the same thread.
+     */
+    NPC_RACER_API const char *npc_last_error(void);
+
+    /**
+     * @brief Loads a maze from a `*.txt` or `*.csv` maze file.
+     *
+     * @param filename The maze file name.
+     * @param maze Set to the loaded maze on success, which must be freed with npc_maze_free.
+     *
+     * @return NPC_OK or NPC_ERROR_LOAD_FAILED.
+     * @note As in the rest of NPC Racer, what's wrong with an invalid maze is also printed to stdout.
+     */
+    NPC_RACER_API int32_t npc_maze_load_file(const char *filename, npc_maze **maze);
+
+    /**
+     * @brief Loads a maze from memory in the maze file format, e.g. from a game's packed assets.
+     *
+     * @param buffer The maze, starting at its size header. Not kept after the call.
+     * @param size The size of the buffer in bytes.
+     * @param comma_separated Non-zero if the maze is in the comma separated (CSV) format.
+     * @param maze Set to the loaded maze on success, which must be freed with npc_maze_free.
+     *
+     * @return NPC_OK or NPC_ERROR_LOAD_FAILED.
+     */
+    NPC_RACER_API int32_t npc_maze_load_buffer(const char *buffer, size_t size, int comma_separated, npc_maze **maze);
+
+    /**
+     * @brief Frees a maze. Null is ignored.
+     */
+    NPC_RACER_API void npc_maze_free(npc_maze *maze);
+
+    /**
+     * @brief Returns the number of rows of a maze.
+     */
+    NPC_RACER_API uint64_t npc_maze_rows(const npc_maze *maze);
+
+    /**
+     * @brief Returns the number of columns of a maze, path positions are row * columns + column.
+     */
+    NPC_RACER_API uint64_t npc_maze_columns(const npc_maze *maze);
+
+    /**
+     * @brief Returns the `@` start position of a maze as row * columns + column.
+     */
+    NPC_RACER_API uint64_t npc_maze_start(const npc_maze *maze);
+
+    /**
+     * @brief Returns the `X` destination position of a maze as row * columns + column.
+     */
+    NPC_RACER_API uint64_t npc_maze_destination(const npc_maze *maze);
+
+    /**
+     * @brief Returns the number of agents that can answer queries.
+     */
+    NPC_RACER_API uint32_t npc_agent_count(void);
+
+    /**
+     * @brief Returns the name of an agent, e.g. "dijkstra", or null if there is no agent with that number.
+     *
+     * @note Agent numbers never change between versions with the same NPC_RACER_ABI_VERSION, new agents are added after.
+     */
+    NPC_RACER_API const char *npc_agent_name(uint32_t agent);
+
+    /**
+     * @brief Finds paths for a batch of queries with one agent.
+     *
+     * @param maze The maze to find the paths on.
+     * @param agent The number of the agent to find the paths with, see npc_agent_name.
+     * @param queries The queries.
+     * @param query_count The number of queries.
+     * @param results Filled with one result per query, must hold query_count results.
+     * @param path_buffer Filled with the positions of each path one after another, may be null to only get the lengths.
+     * @param path_capacity The number of positions the path buffer holds.
+     * @param path_used Set to the number of positions written to the path buffer, may be null.
+     *
+     * @return NPC_OK if every path that was found fit in the path buffer, NPC_ERROR_PATH_BUFFER_TOO_SMALL if any didn't,
+     *      or NPC_ERROR_INVALID_ARGUMENT. Each result has its own status.
+     * @note Nothing is allocated per query, the paths are written straight into the caller's buffers.
+     */
+    NPC_RACER_API int32_t npc_find_paths(const npc_maze *maze, uint32_t agent, const npc_path_query *queries, size_t query_count,
+                                         npc_path_result *results, uint64_t *path_buffer, size_t path_capacity, size_t *path_used);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NPC_RACER_H */
@@ -0,0 +1,473 @@
+/**
+ * @file path_server.hpp
+ * @author Brendan Fallon (fallonbr@mcmaster.ca) (https://github.com/bren007pie)
+ * @brief This module contains the path server: a long-running process that keeps mazes loaded and answers path queries over a line protocol.
+ * @version 1.0
+ * @date Sunday October 18, 2026
+ * @copyright Copyright (c) 2022 Brendan Fallon
+ */
+
+//// Preprocessor Directives ////
+#pragma once
+#include <iostream>       // std::cout, std::istream, std::ostream
+#include <sstream>        // std::istringstream, std::ostringstream
+#include <string>         // std::string, std::getline
+#include <vector>         // std::vector
+#include <map>            // std::map
+#include <set>            // std::set
+#include <memory>         // std::unique_ptr, std::make_unique
+#include <variant>        // std::variant, std::visit
+#include <chrono>         // std::chrono::steady_clock
+#include <exception>      // std::exception
+#include <filesystem>     // std::filesystem::is_socket, std::filesystem::remove
+#include <cstdint>        // uint16_t, uint32_t, uint64_t
+#include <concepts>       // std::unsigned_integral
+#include "mazes.hpp"      // NPC_Racer::maze, NPC_Racer::index_fits, NPC_Racer::read_maze_elements
+#include "agents.hpp"     // NPC_Racer::race_agents, NPC_Racer::for_each_agent
+#include "timekeeper.hpp" // NPC_Racer::run_average, NPC_Racer::run_percentile
+
+// Unix domain sockets are only on POSIX platforms, other platforms can still serve over stdin
+#if defined(__unix__) || defined(__APPLE__)
+#define NPC_RACER_UNIX_SOCKETS
+#include <sys/socket.h> // socket, bind, listen, accept
+#include <sys/un.h>     // sockaddr_un
+#include <unistd.h>     // read, write, close
+#endif
+
+////// ========= //////
+////// Interface //////
+////// ========= //////
+
+namespace NPC_Racer
+{
+    //// ------- ////
+    //// Structs ////
+    //// ------- ////
+    /**
+     * @brief A maze kept loaded by the path server with its connected paths built and one of each race agent to query it with.
+     *
+     * @tparam index_type The unsigned integer type used for the maze and agent indices.
+     */
+    template <std::unsigned_integral index_type>
+    struct loaded_maze
+    {
+        /**
+         * @brief Reads the maze file and builds its connected paths once so queries only pay for the search.
+         *
+         * @param filename The maze file name of the `*.txt` or `*.csv` file.
+         */
+        explicit loaded_maze(const std::string &filename);
+
+        /**
+         * @param race_maze The loaded maze.
+         */
+        maze<index_type> race_maze;
+
+        /**
+         * @param agents One of each race agent, kept between queries so their scratch memory is reused.
+         */
+        race_agents::agents<index_type> agents;
+    };
+
+    //// ----------------- ////
+    //// Path Server Class ////
+    //// ----------------- ////
+    /**
+     * @brief Keeps mazes loaded between path queries and answers a line protocol over a stream or a Unix domain socket.
+     *
+     * @note Every request is one line and gets one response line starting with `ok` or `error`, except `batch` and `stats`
+     *      which send one line per entry before theirs. Responses come back in the order requests were sent, so clients
+     *      can pipeline requests without waiting. Requests:
+     *      - `load NAME FILE` loads a maze file under a name.
+     *      - `unload NAME` frees a loaded maze.
+     *      - `list` lists the loaded mazes.
+     *      - `path MAZE AGENT ROW COLUMN ROW COLUMN` finds a path between two positions and sends its `row,column` positions.
+     *      - `length MAZE AGENT ROW COLUMN ROW COLUMN` finds a path but only sends its length.
+     *      - `batch REQUEST; REQUEST; ...` answers several requests in one line.
+     *      - `stats` sends the count, error count, and latency percentiles of each request type, `reset-stats` clears them.
+     *      - `quit` ends the connection, `shutdown` stops the server.
+     */
+    class path_server
+    {
+    public:
+        //// Member Functions ////
+        /**
+         * @brief Answers one request line.
+         *
+         * @param request The request, without its line ending.
+         *
+         * @return The response lines, each ending in a line break.
+         * @note The time to answer is recorded under the request's command for `stats`, requests answered with an error
+         *      are only counted so they don't skew the latencies.
+         */
+        std::string handle_request(const std::string &request);
+
+        /**
+         * @brief Answers requests from a stream until it ends or a `quit` or `shutdown` request.
+         *
+         * @param input The stream to read requests from, e.g. std::cin.
+         * @param output The stream to write responses to, e.g. std::cout.
+         *
+         * @result Only flushes once there are no more requests waiting, so pipelined requests are answered together.
+         */
+        void serve_stream(std::istream &input, std::ostream &output);
+
+        /**
+         * @brief Answers requests from clients of a Unix domain socket until a `shutdown` request.
+         *
+         * @param socket_path The file path of the socket, an old socket at the same path is replaced.
+         *
+         * @return True if the server shut down normally, false if the socket couldn't be made or Unix sockets aren't supported.
+         * @note Clients are served one at a time, every chunk read from a client is answered with one write.
+         */
+        bool serve_socket(const std::string &socket_path);
+
+        /**
+         * @brief Returns if the server is still running, false after a `shutdown` request.
+         */
+        bool running() const;
+
+    private:
+        /**
+         * @param mazes The loaded mazes by name, each with the smallest index type that fits it.
+         */
+        std::map<std::string, std::variant<std::unique_ptr<loaded_maze<uint16_t>>, std::unique_ptr<loaded_maze<uint32_t>>,
+                                           std::unique_ptr<loaded_maze<uint64_t>>>>
+            mazes;
+
+        /**
+         * @param latencies The time in seconds each request took to answer by its command.
+         */
+        std::map<std::string, std::vector<double>> latencies;
+
+        /**
+         * @param errors The number of requests answered with an error by their command.
+         */
+        std::map<std::string, size_t> errors;
+
+        /**
+         * @param server_running False once a `shutdown` request is answered.
+         */
+        bool server_running = true;
+
+        /**
+         * @param connection_open False once a `quit` request is answered, reset for each connection.
+         */
+        bool connection_open = true;
+
+        /**
+         * @brief Answers one request without recording its latency.
+         */
+        std::string answer(const std::string &command, std::istringstream &arguments);
+
+        /**
+         * @brief Loads a maze file under a name, replacing any maze already with that name.
+         */
+        std::string load(const std::string &name, const std::string &filename);
+
+        /**
+         * @brief Finds a path between two positions on a loaded maze with the named agent.
+         */
+        template <std::unsigned_integral index_type>
+        std::string query_path(loaded_maze<index_type> &loaded, const std::string &agent_name, const uint64_t (&positions)[4], const bool send_positions);
+    };
+}
+
+////// ============== //////
+////// Implementation //////
+////// ============== //////
+
+template <std::unsigned_integral index_type>
+NPC_Racer::loaded_maze<index_type>::loaded_maze(const std::string &filename) : race_maze(filename)
+{
+    race_maze.adjacency(); // built while loading so the first query isn't slower than the rest
+
+    // agent warnings would land in the middle of the responses
+    for_each_agent(agents, [](auto &agent, size_t)
+                   { agent.warnings = false; });
+}
+
+std::string NPC_Racer::path_server::handle_request(const std::string &request)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::istringstream arguments(request);
+    std::string command;
+    arguments >> command;
+    if (command.empty()) // blank lines are skipped so clients can separate requests
+        return "";
+
+    std::string response = answer(command, arguments);
+    // batch and stats send lines before theirs, so only the last line answers this request
+    size_t last_line = (response.size() < 2) ? std::string::npos : response.rfind('\n', response.size() - 2);
+    if (response.compare((last_line == std::string::npos) ? 0 : last_line + 1, 5, "error") == 0)
+        errors[command]++;
+    else
+        latencies[command].push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    return response;
+}
+
+void NPC_Racer::path_server::serve_stream(std::istream &input, std::ostream &output)
+{
+    connection_open = true;
+    std::string request;
+    while (server_running and connection_open and std::getline(input, request))
+    {
+        output << handle_request(request);
+        if (input.rdbuf()->in_avail() <= 0) // nothing else waiting so the client is waiting on us
+            output.flush();
+    }
+    output.flush();
+}
+
+bool NPC_Racer::path_server::serve_socket([[maybe_unused]] const std::string &socket_path)
+{
+#if defined(NPC_RACER_UNIX_SOCKETS)
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (socket_path.empty() or (socket_path.size() >= sizeof(address.sun_path)))
+    {
+        std::cout << "ERROR: Socket path `" << socket_path << "` must be between 1 and " << sizeof(address.sun_path) - 1 << " characters.\n";
+        return false;
+    }
+    socket_path.copy(address.sun_path, socket_path.size());
+
+    std::error_code error; // only replacing an old socket, never a regular file
+    if (std::filesystem::is_socket(socket_path, error))
+        std::filesystem::remove(socket_path, error);
+
+    int server_socket = socket(AF_UNIX, SOCK_STREAM, 0);
+    if ((server_socket < 0) or (bind(server_socket, (const sockaddr *)&address, sizeof(address)) != 0) or (listen(server_socket, 16) != 0))
+    {
+        std::cout << "ERROR: Could not listen on socket `" << socket_path << "`!\n";
+        if (server_socket >= 0)
+            close(server_socket);
+        return false;
+    }
+    std::cout << "Serving path queries on `" << socket_path << "`.\n";
+
+    char buffer[1 << 16];
+    while (server_running)
+    {
+        int client = accept(server_socket, nullptr, nullptr);
+        if (client < 0)
+            continue;
+
+        connection_open = true;
+        std::string pending; // a request split between two reads waits here for the rest of its line
+        ssize_t bytes_read;
+        while (server_running and connection_open and ((bytes_read = read(client, buffer, sizeof(buffer))) > 0))
+        {
+            pending.append(buffer, (size_t)bytes_read);
+            std::string responses;
+            size_t line_start = 0;
+            for (size_t line_end = pending.find('\n'); line_end != std::string::npos; line_end = pending.find('\n', line_start))
+            {
+                responses += handle_request(pending.substr(line_start, line_end - line_start));
+                line_start = line_end + 1;
+                if (!server_running or !connection_open)
+                    break;
+            }
+            pending.erase(0, line_start);
+
+            // answering every complete request in the chunk with one write
+            for (size_t written = 0; written < responses.size();)
+            {
+                ssize_t bytes_written = write(client, responses.data() + written, responses.size() - written);
+                if (bytes_written <= 0)
+                {
+                    connection_open = false;
+                    break;
+                }
+                written += (size_t)bytes_written;
+            }
+        }
+        close(client);
+    }
+
+    close(server_socket);
+    std::filesystem::remove(socket_path, error);
+    return true;
+#else
+    std::cout << "ERROR: Unix domain sockets aren't supported on this platform, serve over stdin instead.\n";
+    return false;
+#endif
+}
+
+bool NPC_Racer::path_server::running() const
+{
+    return server_running;
+}
+
+std::string NPC_Racer::path_server::answer(const std::string &command, std::istringstream &arguments)
+{
+    if (command == "load")
+    {
+        std::string name, filename;
+        arguments >> name;
+        std::getline(arguments >> std::ws, filename); // the rest of the line so file names can have spaces
+        if (name.empty() or filename.empty())
+            return "error load needs a name and a maze file\n";
+        return load(name, filename);
+    }
+    else if (command == "unload")
+    {
+        std::string name;
+        arguments >> name;
+        if (mazes.erase(name) == 0)
+            return "error no maze named `" + name + "` is loaded\n";
+        return "ok unload " + name + "\n";
+    }
+    else if (command == "list")
+    {
+        std::string response = "ok list " + std::to_string(mazes.size());
+        for (const auto &[name, loaded] : mazes)
+            response += " " + name;
+        return response + "\n";
+    }
+    else if ((command == "path") or (command == "length"))
+    {
+        std::string name, agent_name;
+        uint64_t positions[4] = {}; // start row, start column, destination row, destination column
+        arguments >> name >> agent_name >> positions[0] >> positions[1] >> positions[2] >> positions[3];
+        if (arguments.fail())
+            return "error " + command + " needs a maze, an agent, and the start and destination rows and columns\n";
+        auto found = mazes.find(name);
+        if (found == mazes.end())
+            return "error no maze named `" + name + "` is loaded\n";
+        return std::visit([&](auto &loaded)
+                          { return query_path(*loaded, agent_name, positions, command == "path"); },
+                          found->second);
+    }
+    else if (command == "batch")
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        std::string responses, request;
+        size_t count = 0;
+        while (std::getline(arguments, request, ';'))
+        {
+            if (request.find_first_not_of(" \t\r") == std::string::npos)
+                continue;
+            std::string batched_command;
+            std::istringstream(request) >> batched_command;
+            if (batched_command == "batch") // nested batches would be recorded twice
+                responses += "error batches cannot be nested\n";
+            else
+                responses += handle_request(request);
+            count++;
+        }
+        return responses + "ok batch " + std::to_string(count) + " " +
+               std::to_string(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count()) + "\n";
+    }
+    else if (command == "stats")
+    {
+        std::set<std::string> names;
+        for (const auto &[name, times] : latencies)
+            names.insert(name);
+        for (const auto &[name, count] : errors)
+            names.insert(name);
+
+        std::ostringstream response;
+        const std::vector<double> no_times;
+        for (const std::string &name : names)
+        {
+            const std::vector<double> &times = latencies.contains(name) ? latencies.at(name) : no_times;
+            // microseconds since requests are far shorter than a second
+            response << "stat " << name << " count " << times.size() << " errors " << (errors.contains(name) ? errors.at(name) : 0)
+                     << " mean_us " << (times.empty() ? 0.0 : run_average(times) * 1e6)
+                     << " p50_us " << run_percentile(times, 50) * 1e6 << " p90_us " << run_percentile(times, 90) * 1e6
+                     << " p99_us " << run_percentile(times, 99) * 1e6 << " max_us " << run_percentile(times, 100) * 1e6 << "\n";
+        }
+        response << "ok stats " << names.size() << "\n";
+        return response.str();
+    }
+    else if (command == "reset-stats")
+    {
+        latencies.clear();
+        errors.clear();
+        return "ok reset-stats\n";
+    }
+    else if (command == "quit")
+    {
+        connection_open = false;
+        return "ok quit\n";
+    }
+    else if (command == "shutdown")
+    {
+        server_running = false;
+        return "ok shutdown\n";
+    }
+    return "error unknown request `" + command + "`\n";
+}
+
+std::string NPC_Racer::path_server::load(const std::string &name, const std::string &filename)
+{
+    uint64_t elements = read_maze_elements(filename); // 0 if it can't be read, checked first since the maze exits on a missing file
+    if (elements == 0)
+        return "error could not read maze file `" + filename + "`\n";
+
+    // the maze prints when it's read, which would land in the middle of the responses
+    std::ostringstream maze_messages;
+    std::streambuf *cout_buffer = std::cout.rdbuf(maze_messages.rdbuf());
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    size_t rows = 0, columns = 0, index_bits = 0;
+    try
+    {
+        auto load_maze = [&]<std::unsigned_integral index_type>()
+        {
+            std::unique_ptr<loaded_maze<index_type>> loaded = std::make_unique<loaded_maze<index_type>>(filename);
+            rows = loaded->race_maze.rows();
+            columns = loaded->race_maze.columns();
+            index_bits = sizeof(index_type) * 8;
+            mazes[name] = std::move(loaded);
+        };
+        if (index_fits<uint16_t>(elements))
+            load_maze.template operator()<uint16_t>();
+        else if (index_fits<uint32_t>(elements))
+            load_maze.template operator()<uint32_t>();
+        else
+            load_maze.template operator()<uint64_t>();
+    }
+    catch (const std::exception &error)
+    {
+        std::cout.rdbuf(cout_buffer);
+        return "error could not load maze file `" + filename + "`: " + error.what() + "\n";
+    }
+    std::cout.rdbuf(cout_buffer);
+
+    double load_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return "ok load " + name + " " + std::to_string(rows) + " " + std::to_string(columns) + " " + std::to_string(index_bits) + " " + std::to_string(load_time) + "\n";
+}
+
+template <std::unsigned_integral index_type>
+std::string NPC_Racer::path_server::query_path(loaded_maze<index_type> &loaded, const std::string &agent_name, const uint64_t (&positions)[4], const bool send_positions)
+{
+    const maze<index_type> &race_maze = loaded.race_maze;
+    for (size_t i = 0; i < 4; i += 2)
+        if ((positions[i] >= race_maze.rows()) or (positions[i + 1] >= race_maze.columns()) or !race_maze.is_free((int64_t)positions[i], (int64_t)positions[i + 1], false))
+            return "error position " + std::to_string(positions[i]) + "," + std::to_string(positions[i + 1]) + " is not a free space on the maze\n";
+    index_type start_position = (index_type)(positions[0] * race_maze.columns() + positions[1]);
+    index_type destination_position = (index_type)(positions[2] * race_maze.columns() + positions[3]);
+
+    std::ostringstream response;
+    bool agent_found = false;
+    for_each_agent(loaded.agents, [&](auto &agent, size_t)
+                   {
+        if (agent.name != agent_name)
+            return;
+        agent_found = true;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        const std::vector<index_type> &path = agent.pathfind(race_maze, start_position, destination_position);
+        double search_time = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+        // a one position path is only a path when the start is the destination
+        bool path_found = agent.pathfinding_completed and ((path.size() > 1) or (start_position == destination_position));
+        response << "ok " << (send_positions ? "path " : "length ") << (path_found ? path.size() : 0) << " " << agent.nodes_explored << " " << search_time;
+        if (send_positions and path_found)
+            for (const index_type position : path)
+                response << " " << position / race_maze.columns() << "," << position % race_maze.columns();
+        response << "\n"; });
+
+    if (!agent_found)
+        return "error no agent named `" + agent_name + "`\n";
+    return response.str();
+}
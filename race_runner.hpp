@@ -0,0 +1,245 @@
+/**
+ * @file race_runner.hpp
+ * @author Brendan Fallon (fallonbr@mcmaster.ca) (https://github.com/bren007pie)
+ * @brief This module contains the worker pool and maze file collection used to run many NPC races at once, and the head-to-head race of agents on one maze.
+ * @version 1.0
+ * @date Sunday October 18, 2026
+ * @copyright Copyright (c) 2022 Brendan Fallon
+ */
+
+//// Preprocessor Directives ////
+#pragma once
+#include <iostream>   // std::cout
+#include <string>     // std::string
+#include <vector>     // std::vector
+#include <algorithm>  // std::sort, std::min, std::max
+#include <filesystem> // std::filesystem::path, std::filesystem::directory_iterator
+#include <thread>     // std::thread
+#include <atomic>     // std::atomic
+#include <exception>  // std::exception
+#include <barrier>    // std::barrier
+#include "agents.hpp" // NPC_Racer::pathfinding_agent
+#include <chrono>     // std::chrono::steady_clock
+
+// Core pinning is only supported on Linux, other platforms leave scheduling to the OS
+#if defined(__linux__)
+#include <pthread.h> // pthread_setaffinity_np
+#include <sched.h>   // cpu_set_t, CPU_ZERO, CPU_SET
+#endif
+
+////// ========= //////
+////// Interface //////
+////// ========= //////
+
+namespace NPC_Racer
+{
+    //// ------- ////
+    //// Structs ////
+    //// ------- ////
+    /**
+     * @brief The results of one agent in a head-to-head race.
+     */
+    struct head_to_head_result
+    {
+        /**
+         * @param finish_times The time in seconds from the start of each round until the agent found its path.
+         */
+        std::vector<double> finish_times;
+
+        /**
+         * @param places The place the agent finished in each round, 1 for first.
+         */
+        std::vector<size_t> places;
+
+        /**
+         * @param wins The number of rounds the agent finished first.
+         */
+        size_t wins = 0;
+    };
+
+    //// --------- ////
+    //// Functions ////
+    //// --------- ////
+    /**
+     * @brief Expands maze file and directory arguments into a list of maze files.
+     *
+     * @param paths The maze files and directories given as arguments.
+     *
+     * @return The maze files in the order given, with each directory replaced by its `.txt` and `.csv` files sorted by name.
+     * @warning Prints an error and skips any path that doesn't exist.
+     */
+    std::vector<std::string> collect_maze_files(const std::vector<std::string> &paths);
+
+    /**
+     * @brief Pins the calling thread to one CPU core so its timings aren't disturbed by being moved between cores.
+     *
+     * @param core The core to pin to, wrapped around the number of hardware threads.
+     *
+     * @return True if the thread was pinned, false if pinning isn't supported or failed.
+     */
+    bool pin_current_thread(const size_t core);
+
+    /**
+     * @brief Runs a number of independent tasks across a pool of worker threads.
+     *
+     * @tparam task_type A callable taking the task index as a size_t.
+     * @param task_count The number of tasks, each task is given its index from 0 to (task_count - 1).
+     * @param worker_count The number of worker threads, 0 for one per hardware thread. Never more than the number of tasks.
+     * @param pin_cores If true worker i is pinned to core i.
+     * @param task The task to run.
+     *
+     * @result Runs every task once. Workers take the next task as soon as they finish one so long races don't hold up short ones.
+     * @note An exception thrown by a task is printed and the other tasks keep running.
+     */
+    template <typename task_type>
+    void run_worker_pool(const size_t task_count, const size_t worker_count, const bool pin_cores, task_type task);
+
+    /**
+     * @brief Races agents against each other at the same time on the same maze, each on its own thread.
+     *
+     * @tparam maze_type The maze class the agents pathfind on.
+     * @tparam agent_types Any agent classes that can race on the maze.
+     * @param race_maze The maze to race on, only read so it's shared by every agent.
+     * @param rounds The number of rounds to race.
+     * @param pin_cores If true agent i's thread is pinned to core i.
+     * @param agents The agents to race.
+     *
+     * @return The results of each agent in the order given.
+     * @note Every round starts when all the agents are waiting at a barrier, so they contend for the caches and memory
+     *      bandwidth like agents running at once on a server. Times are from the barrier releasing to each agent's path.
+     */
+    template <typename maze_type, pathfinding_agent<maze_type>... agent_types>
+    std::vector<head_to_head_result> run_head_to_head(const maze_type &race_maze, const size_t rounds, const bool pin_cores, agent_types &...agents);
+}
+
+////// ============== //////
+////// Implementation //////
+////// ============== //////
+
+std::vector<std::string> NPC_Racer::collect_maze_files(const std::vector<std::string> &paths)
+{
+    std::vector<std::string> maze_files;
+    for (const std::string &path : paths)
+    {
+        std::error_code error; // error codes instead of exceptions so one bad path doesn't stop the rest
+        if (std::filesystem::is_directory(path, error))
+        {
+            std::vector<std::string> directory_files;
+            for (const std::filesystem::directory_entry &entry : std::filesystem::directory_iterator(path, error))
+            {
+                std::string extension = entry.path().extension().string();
+                if (entry.is_regular_file() and ((extension == ".txt") or (extension == ".csv")))
+                    directory_files.push_back(entry.path().string());
+            }
+            std::sort(directory_files.begin(), directory_files.end()); // directory order isn't defined so sorting for repeatable runs
+            maze_files.insert(maze_files.end(), directory_files.begin(), directory_files.end());
+        }
+        else if (std::filesystem::exists(path, error))
+            maze_files.push_back(path);
+        else
+            std::cout << "ERROR: Maze file or directory `" << path << "` does not exist, skipping it.\n";
+    }
+    return maze_files;
+}
+
+bool NPC_Racer::pin_current_thread([[maybe_unused]] const size_t core)
+{
+#if defined(__linux__)
+    size_t core_count = std::max<size_t>(1, std::thread::hardware_concurrency());
+    cpu_set_t core_set;
+    CPU_ZERO(&core_set);
+    CPU_SET(core % core_count, &core_set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(core_set), &core_set) == 0;
+#else
+    return false;
+#endif
+}
+
+template <typename task_type>
+void NPC_Racer::run_worker_pool(const size_t task_count, const size_t worker_count, const bool pin_cores, task_type task)
+{
+    if (task_count == 0)
+        return;
+
+    size_t workers = (worker_count == 0) ? std::max<size_t>(1, std::thread::hardware_concurrency()) : worker_count;
+    workers = std::min(workers, task_count);
+
+    std::atomic<size_t> next_task = 0; // shared counter of the next task to take
+    auto worker_loop = [&](const size_t worker)
+    {
+        if (pin_cores and !pin_current_thread(worker))
+            std::cout << "WARNING: Could not pin worker " << worker << " to a core.\n";
+
+        for (size_t i = next_task++; i < task_count; i = next_task++)
+        {
+            try
+            {
+                task(i);
+            }
+            catch (const std::exception &error)
+            {
+                std::cout << "ERROR: Task " << i << " failed: " << error.what() << "\n";
+            }
+        }
+    };
+
+    if (workers == 1) // no need for another thread, keeps single races on the main thread
+    {
+        worker_loop(0);
+        return;
+    }
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers);
+    for (size_t worker = 0; worker < workers; worker++)
+        pool.emplace_back(worker_loop, worker);
+    for (std::thread &thread : pool)
+        thread.join();
+}
+
+template <typename maze_type, NPC_Racer::pathfinding_agent<maze_type>... agent_types>
+std::vector<NPC_Racer::head_to_head_result> NPC_Racer::run_head_to_head(const maze_type &race_maze, const size_t rounds, const bool pin_cores, agent_types &...agents)
+{
+    constexpr size_t agent_count = sizeof...(agent_types);
+    std::vector<head_to_head_result> results(agent_count);
+    std::chrono::steady_clock::time_point round_start;
+    std::atomic<size_t> finished = 0; // agents finished this round, gives each its place
+
+    // the completion step runs once all the agents have arrived and before any are released
+    auto start_round = [&]() noexcept
+    {
+        finished = 0;
+        round_start = std::chrono::steady_clock::now();
+    };
+    std::barrier start_line((std::ptrdiff_t)agent_count, start_round);
+
+    auto race = [&](auto &agent, const size_t racer)
+    {
+        if (pin_cores and !pin_current_thread(racer))
+            std::cout << "WARNING: Could not pin agent " << racer << " to a core.\n";
+        head_to_head_result &result = results[racer]; // each thread only writes its own result
+        result.finish_times.reserve(rounds);
+        result.places.reserve(rounds);
+
+        for (size_t round = 0; round < rounds; round++)
+        {
+            start_line.arrive_and_wait();
+            agent.pathfind(race_maze);
+            std::chrono::steady_clock::time_point finish = std::chrono::steady_clock::now();
+            size_t place = ++finished;
+            result.finish_times.push_back(std::chrono::duration<double>(finish - round_start).count());
+            result.places.push_back(place);
+            result.wins += (place == 1);
+        }
+    };
+
+    std::vector<std::thread> racers;
+    racers.reserve(agent_count);
+    size_t racer = 0;
+    (racers.emplace_back([&race, &agents, index = racer++]()
+                         { race(agents, index); }),
+     ...); // one thread per agent, in order
+    for (std::thread &thread : racers)
+        thread.join();
+    return results;
+}
@@ -0,0 +1,319 @@
+/**
+ * @file regression.hpp
+ * @author Brendan Fallon (fallonbr@mcmaster.ca) (https://github.com/bren007pie)
+ * @brief This module contains the performance regression suite: saving a baseline of results and comparing later runs against it.
+ * @version 1.0
+ * @date Sunday October 18, 2026
+ * @copyright Copyright (c) 2022 Brendan Fallon
+ */
+
+//// Preprocessor Directives ////
+#pragma once
+#include <iostream>       // std::cout, std::ostream
+#include <fstream>        // std::ofstream, std::ifstream
+#include <sstream>        // std::istringstream
+#include <string>         // std::string, std::getline
+#include <vector>         // std::vector
+#include <array>          // std::array
+#include <algorithm>      // std::sort
+#include <utility>        // std::pair
+#include <stdexcept>      // std::invalid_argument
+#include <filesystem>     // std::filesystem::create_directories, std::filesystem::exists
+#include <cmath>          // std::sqrt, std::abs, std::erfc
+#include <cstdint>        // uint64_t
+#include "mazes.hpp"      // NPC_Racer::make_generated_maze_file
+#include "timekeeper.hpp" // NPC_Racer::run_median
+#include "benchmark.hpp"  // NPC_Racer::benchmark_result, NPC_Racer::benchmark_timestamp
+
+////// ========= //////
+////// Interface //////
+////// ========= //////
+
+namespace NPC_Racer
+{
+    //// --------- ////
+    //// Constants ////
+    //// --------- ////
+    /**
+     * @brief The p-value below which a difference between the baseline and current trial times is significant.
+     */
+    constexpr double regression_significance = 0.01;
+
+    /**
+     * @brief The directory the suite's generated mazes are written to.
+     */
+    const std::string suite_maze_directory = "generated_mazes";
+
+    //// ------- ////
+    //// Structs ////
+    //// ------- ////
+    /**
+     * @brief The result of a Mann-Whitney U test between two sets of trial times.
+     */
+    struct rank_test_result
+    {
+        /**
+         * @param u_statistic The U statistic of the first set of times.
+         */
+        double u_statistic = 0;
+
+        /**
+         * @param z_score The normal approximation of U, positive when the first set is mostly slower.
+         */
+        double z_score = 0;
+
+        /**
+         * @param p_value The two-sided p-value of the times coming from the same distribution.
+         */
+        double p_value = 1;
+    };
+
+    //// --------- ////
+    //// Functions ////
+    //// --------- ////
+    /**
+     * @brief Writes the mazes the regression suite races on besides the sample mazes.
+     *
+     * @param directory The directory to write the mazes to, created if it doesn't exist.
+     *
+     * @result Writes mazes large enough that the agents' scaling shows, with fixed seeds so every run races the same mazes.
+     *      Mazes that already exist aren't written again.
+     */
+    void make_suite_mazes(const std::string &directory = suite_maze_directory);
+
+    /**
+     * @brief Tests whether two sets of trial times come from the same distribution with the Mann-Whitney U test.
+     *
+     * @param first_times The first set of times, e.g. the current run.
+     * @param second_times The second set of times, e.g. the baseline.
+     *
+     * @return The U statistic, z-score, and two-sided p-value using the normal approximation with tie correction.
+     * @note Doesn't assume the times are normally distributed, which trial times rarely are.
+     */
+    rank_test_result mann_whitney_u_test(const std::vector<double> &first_times, const std::vector<double> &second_times);
+
+    /**
+     * @brief Writes benchmark results as a baseline to compare later runs against.
+     *
+     * @param results The results to write.
+     * @param filename The baseline file name.
+     *
+     * @result Writes one tab separated line per agent per maze with every trial time.
+     * @warning Overwrites any previous file with the same name.
+     */
+    void write_baseline(const std::vector<benchmark_result> &results, const std::string &filename);
+
+    /**
+     * @brief Reads a baseline written by write_baseline.
+     *
+     * @param filename The baseline file name.
+     *
+     * @return The baseline results with the maze, agent, index bits, path size, nodes explored, and trial times.
+     * @warning Prints an error and exits if the file can't be opened or a line is malformed.
+     */
+    std::vector<benchmark_result> read_baseline(const std::string &filename);
+
+    /**
+     * @brief Compares benchmark results against a baseline and prints a table of the differences.
+     *
+     * @param results The current results.
+     * @param baseline The baseline results.
+     * @param threshold_percent The smallest slowdown of the median time in percent counted as a regression.
+     * @param output The stream to print to.
+     *
+     * @return The number of regressions. A result regresses if it is significantly slower than its baseline by the
+     *      Mann-Whitney U test and its median is at least threshold_percent slower, or if it finds a different size path.
+     */
+    size_t compare_to_baseline(const std::vector<benchmark_result> &results, const std::vector<benchmark_result> &baseline,
+                               const size_t threshold_percent, std::ostream &output);
+}
+
+////// ============== //////
+////// Implementation //////
+////// ============== //////
+
+void NPC_Racer::make_suite_mazes(const std::string &directory /* suite_maze_directory */)
+{
+    // sizes kept so the whole suite runs in a few minutes with the default trials
+    const std::array<std::array<uint64_t, 3>, 3> suite_mazes = {{{127, 127, 1}, {201, 301, 2}, {255, 255, 3}}}; // rows, columns, seed
+
+    std::filesystem::create_directories(directory);
+    for (const std::array<uint64_t, 3> &suite_maze : suite_mazes)
+    {
+        std::string file_name = directory + "/" + std::to_string(suite_maze[0]) + "_" + std::to_string(suite_maze[1]) + "_generated_maze_" + std::to_string(suite_maze[2]) + ".txt";
+        if (!std::filesystem::exists(file_name))
+            make_generated_maze_file(suite_maze[0], suite_maze[1], suite_maze[2], directory);
+    }
+}
+
+NPC_Racer::rank_test_result NPC_Racer::mann_whitney_u_test(const std::vector<double> &first_times, const std::vector<double> &second_times)
+{
+    rank_test_result result;
+    double first_size = (double)first_times.size();
+    double second_size = (double)second_times.size();
+    if ((first_times.size() == 0) or (second_times.size() == 0))
+        return result;
+
+    // ranking both sets together, true marks the first set
+    std::vector<std::pair<double, bool>> times;
+    times.reserve(first_times.size() + second_times.size());
+    for (const double time : first_times)
+        times.push_back({time, true});
+    for (const double time : second_times)
+        times.push_back({time, false});
+    std::sort(times.begin(), times.end());
+
+    // tied times all get the average of their ranks
+    double first_rank_sum = 0;
+    double tie_correction = 0; // sum of (t^3 - t) over each group of t ties
+    for (size_t i = 0; i < times.size();)
+    {
+        size_t j = i;
+        while ((j < times.size()) and (times[j].first == times[i].first))
+            j++;
+        double average_rank = (double)(i + j + 1) / 2; // ranks start at 1
+        double ties = (double)(j - i);
+        tie_correction += ties * ties * ties - ties;
+        for (size_t k = i; k < j; k++)
+            if (times[k].second)
+                first_rank_sum += average_rank;
+        i = j;
+    }
+
+    double total_size = first_size + second_size;
+    result.u_statistic = first_rank_sum - first_size * (first_size + 1) / 2;
+    double mean = first_size * second_size / 2;
+    double variance = first_size * second_size / 12 * ((total_size + 1) - tie_correction / (total_size * (total_size - 1)));
+    if (variance <= 0) // every time was the same
+        return result;
+
+    // continuity correction moves U half a step towards the mean
+    double difference = result.u_statistic - mean;
+    double corrected = (std::abs(difference) > 0.5) ? (std::abs(difference) - 0.5) : 0;
+    result.z_score = ((difference < 0) ? -corrected : corrected) / std::sqrt(variance);
+    result.p_value = std::erfc(std::abs(result.z_score) / std::sqrt(2.0)); // two-sided normal tail
+    return result;
+}
+
+void NPC_Racer::write_baseline(const std::vector<benchmark_result> &results, const std::string &filename)
+{
+    std::ofstream output(filename);
+    if (!output.is_open())
+    {
+        std::cout << "ERROR: Error opening baseline output file `" << filename << "`!\n";
+        return;
+    }
+
+    output.precision(9);
+    output << "# NPC Racer baseline " << benchmark_timestamp() << "\n";
+    output << "# maze\tagent\tindex_bits\tpath_size\tnodes_explored\ttrial_times...\n";
+    for (const benchmark_result &result : results)
+    {
+        output << result.maze_name << "\t" << result.agent_name << "\t" << result.index_bits << "\t"
+               << result.path_size << "\t" << result.nodes_explored;
+        for (const double time : result.trial_times)
+            output << "\t" << time;
+        output << "\n";
+    }
+    output.close();
+    std::cout << "Baseline written to `" << filename << "`.\n";
+}
+
+std::vector<NPC_Racer::benchmark_result> NPC_Racer::read_baseline(const std::string &filename)
+{
+    std::ifstream input(filename);
+    if (!input.is_open())
+    {
+        std::cout << "ERROR: Error opening baseline file `" << filename << "`!\n\tRun with `--save-baseline " << filename << "` first.\n";
+        exit(EXIT_FAILURE);
+    }
+
+    std::vector<benchmark_result> baseline;
+    std::string line;
+    size_t line_number = 0;
+    while (std::getline(input, line))
+    {
+        line_number++;
+        if (line.empty() or (line[0] == '#')) // comments
+            continue;
+
+        // tab separated so maze file names can have spaces
+        std::vector<std::string> fields;
+        std::istringstream line_stream(line);
+        std::string field;
+        while (std::getline(line_stream, field, '\t'))
+            fields.push_back(field);
+
+        benchmark_result result;
+        try
+        {
+            if (fields.size() < 6) // at least one trial time
+                throw std::invalid_argument("too few fields");
+            result.maze_name = fields[0];
+            result.agent_name = fields[1];
+            result.index_bits = std::stoull(fields[2]);
+            result.path_size = std::stoull(fields[3]);
+            result.nodes_explored = std::stoull(fields[4]);
+            for (size_t i = 5; i < fields.size(); i++)
+                result.trial_times.push_back(std::stod(fields[i]));
+        }
+        catch (const std::exception &)
+        {
+            std::cout << "ERROR: Malformed line " << line_number << " in baseline file `" << filename << "`.\n";
+            exit(EXIT_FAILURE);
+        }
+        baseline.push_back(result);
+    }
+    input.close();
+    return baseline;
+}
+
+size_t NPC_Racer::compare_to_baseline(const std::vector<benchmark_result> &results, const std::vector<benchmark_result> &baseline,
+                                      const size_t threshold_percent, std::ostream &output)
+{
+    size_t regressions = 0;
+    output << "\n# Baseline Comparison #\n";
+    output << "Agent\t\t| Baseline\t| Current\t| Change\t| p-value\t| Verdict\t| Maze\n";
+    output << "----------------|---------------|---------------|---------------|---------------|---------------|------\n";
+    for (const benchmark_result &result : results)
+    {
+        output << result.agent_name << (result.agent_name.size() < 8 ? "\t\t| " : "\t| ");
+
+        const benchmark_result *baseline_result = nullptr;
+        for (const benchmark_result &candidate : baseline)
+            if ((candidate.maze_name == result.maze_name) and (candidate.agent_name == result.agent_name))
+                baseline_result = &candidate;
+
+        if (baseline_result == nullptr)
+        {
+            output << "\t\t| " << run_median(result.trial_times) << "\t| \t\t| \t\t| NEW\t\t| " << result.maze_name << "\n";
+            continue;
+        }
+
+        double baseline_median = run_median(baseline_result->trial_times);
+        double current_median = run_median(result.trial_times);
+        double change_percent = (baseline_median > 0) ? (current_median - baseline_median) / baseline_median * 100 : 0;
+        rank_test_result test = mann_whitney_u_test(result.trial_times, baseline_result->trial_times);
+
+        std::string verdict = "same\t";
+        if (result.path_size != baseline_result->path_size) // a different path is a correctness change, not noise
+        {
+            verdict = "PATH CHANGED";
+            regressions++;
+        }
+        else if ((test.p_value < regression_significance) and (change_percent >= (double)threshold_percent))
+        {
+            verdict = "REGRESSION";
+            regressions++;
+        }
+        else if ((test.p_value < regression_significance) and (change_percent <= -(double)threshold_percent))
+            verdict = "faster\t";
+
+        output << baseline_median << "\t| " << current_median << "\t| " << change_percent << " %\t| "
+               << test.p_value << "\t| " << verdict << "\t| " << result.maze_name << "\n";
+    }
+    output << "----------------|---------------|---------------|---------------|---------------|---------------|------\n";
+    output << "^median times in seconds, significant at p < " << regression_significance << " with at least " << threshold_percent << " % change\n";
+    output << regressions << " regression" << (regressions == 1 ? "" : "s") << " found.\n";
+    return regressions;
+}
@@ -11,9 +11,29 @@
 #pragma once
 #include <chrono>  // std::chrono::steady_clock, std::chrono::time_point, std::chrono::duration
 #include <vector>  // std::vector
-#include <numeric> // std::accumulate
-#include <cmath>
+#include <numeric>   // std::accumulate
+#include <cmath>     // std::pow, std::sqrt, std::abs, std::ceil
+#include <algorithm> // std::sort, std::min_element
+#include <array>     // std::array
+#include <memory>    // std::unique_ptr, std::make_unique
+#include <cstdint>   // uint64_t
+#include <string>    // std::string
+#include <utility>   // std::pair
 
+// Hardware performance counters are only read on Linux through perf_event_open, other platforms fall back to wall time only
+#if defined(__linux__)
+#include <linux/perf_event.h> // perf_event_attr, PERF_* constants
+#include <sys/ioctl.h>        // ioctl
+#include <sys/syscall.h>      // SYS_perf_event_open
+#include <unistd.h>           // syscall, read, close
+#include <cstring>            // std::memset
+#endif
+
+// The cycle counter timer reads the x86 time stamp counter directly, other architectures fall back to std::chrono::steady_clock
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h> // __rdtsc, __rdtscp, _mm_lfence
+#include <cpuid.h>     // __get_cpuid
+#endif
 namespace NPC_Racer
 {
     //// --------- ////
@@ -53,6 +73,157 @@ namespace NPC_Racer
         return std::sqrt(standard_deviation / (double)trial_times.size());
     }
 
+    /**
+     * @brief Takes the fastest of a series of pathfinding trial times.
+     *
+     * @param trial_times A collection of all the run times from each trial.
+     *
+     * @return Returns the minimum trial time, 0 if there are no trials.
+     */
+    double run_minimum(const std::vector<double> &trial_times)
+    {
+        if (trial_times.empty())
+            return 0.0;
+        return *std::min_element(trial_times.begin(), trial_times.end());
+    }
+
+    /**
+     * @brief Takes a percentile of a series of pathfinding trial times.
+     *
+     * @param trial_times A collection of all the run times from each trial.
+     * @param percentile The percentile to take from 0 to 100, e.g. 50 is the median.
+     *
+     * @return Returns the trial time at that percentile using the nearest-rank method, 0 if there are no trials.
+     * @note Nearest-rank always returns one of the measured times: https://en.wikipedia.org/wiki/Percentile#The_nearest-rank_method
+     */
+    double run_percentile(std::vector<double> trial_times, const double percentile)
+    {
+        if (trial_times.empty())
+            return 0.0;
+        std::sort(trial_times.begin(), trial_times.end()); // copied so the caller's trial order is kept
+        size_t rank = (size_t)std::ceil(percentile / 100.0 * (double)trial_times.size());
+        rank = std::min(std::max<size_t>(rank, 1), trial_times.size()); // clamping 0th and 100th percentile
+        return trial_times[rank - 1];
+    }
+
+    /**
+     * @brief Takes the median of a series of pathfinding trial times.
+     *
+     * @param trial_times A collection of all the run times from each trial.
+     *
+     * @return Returns the middle trial time, the mean of the two middle times for an even number of trials.
+     */
+    double run_median(std::vector<double> trial_times)
+    {
+        if (trial_times.empty())
+            return 0.0;
+        std::sort(trial_times.begin(), trial_times.end());
+        size_t middle = trial_times.size() / 2;
+        if (trial_times.size() % 2 == 0)
+            return (trial_times[middle - 1] + trial_times[middle]) / 2;
+        return trial_times[middle];
+    }
+
+    /**
+     * @brief Removes outlier trials using Tukey's fences, anything more than 1.5 interquartile ranges outside the quartiles.
+     *
+     * @param trial_times A collection of all the run times from each trial.
+     *
+     * @return Returns the trial times that are not outliers, in their original order.
+     * @note Timing outliers are almost always slow ones from the OS interrupting the trial. Fewer than 4 trials are returned as is.
+     * @cite https://en.wikipedia.org/wiki/Outlier#Tukey's_fences
+     */
+    std::vector<double> run_reject_outliers(const std::vector<double> &trial_times)
+    {
+        if (trial_times.size() < 4)
+            return trial_times;
+
+        double first_quartile = run_percentile(trial_times, 25);
+        double third_quartile = run_percentile(trial_times, 75);
+        double fence = 1.5 * (third_quartile - first_quartile);
+
+        std::vector<double> kept_times;
+        kept_times.reserve(trial_times.size());
+        for (const double time : trial_times)
+        {
+            if ((time >= first_quartile - fence) and (time <= third_quartile + fence))
+                kept_times.push_back(time);
+        }
+        return kept_times;
+    }
+
+    /**
+     * @brief Summary statistics of a run of trials.
+     */
+    struct run_statistics
+    {
+        /**
+         * @param average The population mean of the trial times in seconds.
+         */
+        double average = 0.0;
+
+        /**
+         * @param standard_deviation The population standard deviation of the trial times in seconds.
+         */
+        double standard_deviation = 0.0;
+
+        /**
+         * @param minimum The fastest trial time in seconds.
+         */
+        double minimum = 0.0;
+
+        /**
+         * @param median The median trial time in seconds.
+         */
+        double median = 0.0;
+
+        /**
+         * @param percentile_90 The 90th percentile trial time in seconds.
+         */
+        double percentile_90 = 0.0;
+
+        /**
+         * @param percentile_99 The 99th percentile trial time in seconds.
+         */
+        double percentile_99 = 0.0;
+
+        /**
+         * @param trials The number of trials the statistics were taken from.
+         */
+        size_t trials = 0;
+
+        /**
+         * @param rejected_trials The number of outlier trials removed before taking the statistics.
+         */
+        size_t rejected_trials = 0;
+    };
+
+    /**
+     * @brief Takes all the summary statistics of a series of pathfinding trial times.
+     *
+     * @param trial_times A collection of all the run times from each trial.
+     * @param reject_outliers If true outliers are removed with NPC_Racer::run_reject_outliers first.
+     *
+     * @return Returns the statistics of the run.
+     */
+    run_statistics summarize_run(const std::vector<double> &trial_times, const bool reject_outliers = false)
+    {
+        std::vector<double> kept_times = reject_outliers ? run_reject_outliers(trial_times) : trial_times;
+        run_statistics statistics;
+        statistics.trials = kept_times.size();
+        statistics.rejected_trials = trial_times.size() - kept_times.size();
+        if (kept_times.empty())
+            return statistics;
+
+        statistics.average = run_average(kept_times);
+        statistics.standard_deviation = run_standard_deviation(kept_times);
+        statistics.minimum = run_minimum(kept_times);
+        statistics.median = run_median(kept_times);
+        statistics.percentile_90 = run_percentile(kept_times, 90);
+        statistics.percentile_99 = run_percentile(kept_times, 99);
+        return statistics;
+    }
+
     /**
      * @brief Takes the percentage difference between run averages.
      *
@@ -69,6 +240,231 @@ namespace NPC_Racer
         return (percentage_difference * 100);
     }
 
+    //// ------------------------------- ////
+    //// Hardware Counter Values Struct ////
+    //// ------------------------------- ////
+    /**
+     * @brief Hardware performance counter values measured over a timed window.
+     * @note A value of -1 means that counter is unavailable on this machine.
+     */
+    struct hardware_counter_values
+    {
+        /**
+         * @param cycles CPU cycles spent in user space.
+         */
+        double cycles = -1;
+
+        /**
+         * @param instructions Instructions retired in user space.
+         */
+        double instructions = -1;
+
+        /**
+         * @param l1_data_misses Level 1 data cache read misses.
+         */
+        double l1_data_misses = -1;
+
+        /**
+         * @param last_level_cache_misses Last level cache misses, i.e. requests that went to memory.
+         */
+        double last_level_cache_misses = -1;
+
+        /**
+         * @param branch_misses Mispredicted branches.
+         */
+        double branch_misses = -1;
+
+        /**
+         * @param available True if at least one counter could be opened.
+         */
+        bool available = false;
+
+        /**
+         * @param multiplexed True if the group only ran for part of the trial and the counts were scaled up to the whole of it.
+         */
+        bool multiplexed = false;
+    };
+
+    /**
+     * @brief Averages the counter values of a series of trials.
+     *
+     * @param trial_counters The counter values of each trial.
+     * @param iterations_per_trial The number of pathfinding iterations batched in each trial.
+     *
+     * @return The mean of each counter per iteration over the trials it was counted in, -1 if none.
+     *      Multiplexed if any trial was.
+     */
+    hardware_counter_values counter_average(const std::vector<hardware_counter_values> &trial_counters, const uint64_t iterations_per_trial = 1)
+    {
+        hardware_counter_values average;
+        if (trial_counters.empty() or !trial_counters[0].available)
+            return average;
+
+        average.available = true;
+        // a trial the PMU never scheduled the group in has no counts, so it's left out rather than averaged in as zero
+        auto mean_of = [&trial_counters, iterations_per_trial](double hardware_counter_values::*counter) -> double
+        {
+            double sum = 0.0;
+            size_t counted = 0;
+            for (const hardware_counter_values &values : trial_counters)
+                if (values.*counter >= 0)
+                {
+                    sum += values.*counter;
+                    counted++;
+                }
+            return (counted == 0) ? -1 : sum / (double)counted / (double)iterations_per_trial;
+        };
+        for (const hardware_counter_values &values : trial_counters)
+            average.multiplexed = average.multiplexed or values.multiplexed;
+        average.cycles = mean_of(&hardware_counter_values::cycles);
+        average.instructions = mean_of(&hardware_counter_values::instructions);
+        average.l1_data_misses = mean_of(&hardware_counter_values::l1_data_misses);
+        average.last_level_cache_misses = mean_of(&hardware_counter_values::last_level_cache_misses);
+        average.branch_misses = mean_of(&hardware_counter_values::branch_misses);
+        return average;
+    }
+
+    //// ----------------------- ////
+    //// Hardware Counters Class ////
+    //// ----------------------- ////
+    /**
+     * @brief Opens a group of hardware performance counters for this thread that can be started and stopped around a trial.
+     * @note Uses Linux perf_event_open, on other platforms or if the kernel doesn't allow it available() is false and nothing is counted.
+     * @cite https://man7.org/linux/man-pages/man2/perf_event_open.2.html
+     */
+    class hardware_counters
+    {
+    public:
+        /**
+         * @brief Opens all of the counters that the machine supports.
+         */
+        hardware_counters();
+
+        /**
+         * @brief Closes the counters.
+         */
+        ~hardware_counters();
+
+        // counters own file descriptors so can't be copied
+        hardware_counters(const hardware_counters &) = delete;
+        hardware_counters &operator=(const hardware_counters &) = delete;
+
+        /**
+         * @brief Resets and starts all the counters together.
+         */
+        void start();
+
+        /**
+         * @brief Stops all the counters together and reads their values.
+         * @result Counts are -1 if the group never ran, e.g. when the PMU couldn't schedule it, and scaled up if it only ran part of the time.
+         */
+        void stop();
+
+        /**
+         * @brief Gives if any counters could be opened.
+         * @return True if at least one counter is counting.
+         */
+        bool available() const;
+
+        /**
+         * @brief Gives the counter values of the last start() to stop() window.
+         * @return The counter values, -1 for counters that are unavailable.
+         */
+        hardware_counter_values values() const;
+
+    private:
+        /**
+         * @param event_count The number of different events counted.
+         */
+        static constexpr size_t event_count = 5;
+
+        /**
+         * @param file_descriptors The perf file descriptor of each event in the order of hardware_counter_values, -1 if it couldn't be opened.
+         */
+        std::array<int, event_count> file_descriptors = {-1, -1, -1, -1, -1};
+
+        /**
+         * @param group_leader The file descriptor that starts, stops, and reads the whole group, -1 if none could be opened.
+         */
+        int group_leader = -1;
+
+        /**
+         * @param group_order The event of each value read from the group, in the order they were added.
+         */
+        std::array<size_t, event_count> group_order = {};
+
+        /**
+         * @param group_size The number of events in the group.
+         */
+        size_t group_size = 0;
+
+        /**
+         * @param last_values The values of the last window.
+         */
+        hardware_counter_values last_values;
+    };
+
+    //// ------------------- ////
+    //// Cycle Counter Class ////
+    //// ------------------- ////
+    /**
+     * @brief Reads the x86 time stamp counter (TSC) for timing trials too short for std::chrono::steady_clock.
+     * @note The TSC ticks at a constant rate on CPUs with an invariant TSC, which is checked by available().
+     *      Reads are fenced so the timed instructions can't be reordered outside of them.
+     * @cite https://www.intel.com/content/dam/www/public/us/en/documents/white-papers/ia-32-ia-64-benchmark-code-execution-paper.pdf
+     */
+    class cycle_counter
+    {
+    public:
+        /**
+         * @brief Gives if the cycle counter can be used for timing.
+         * @return True on x86 CPUs with an invariant TSC, false on other architectures.
+         */
+        static bool available();
+
+        /**
+         * @brief Reads the counter at the start of a timed window, after every earlier instruction has finished.
+         */
+        static uint64_t start_ticks()
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            _mm_lfence(); // earlier instructions finish first
+            uint64_t ticks = __rdtsc();
+            _mm_lfence(); // timed instructions don't start before the read
+            return ticks;
+#else
+            return 0;
+#endif
+        }
+
+        /**
+         * @brief Reads the counter at the end of a timed window, after every timed instruction has finished.
+         */
+        static uint64_t end_ticks()
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            unsigned int processor; // rdtscp also gives the core, unused
+            uint64_t ticks = __rdtscp(&processor); // waits for the timed instructions to finish
+            _mm_lfence();                          // later instructions don't start before the read
+            return ticks;
+#else
+            return 0;
+#endif
+        }
+
+        /**
+         * @brief Gives the rate the counter ticks at, calibrated against std::chrono::steady_clock the first time it's called.
+         * @return The ticks per second.
+         */
+        static double ticks_per_second();
+
+        /**
+         * @brief Gives the ticks an empty start_ticks() to end_ticks() window takes, measured the first time it's called.
+         * @return The minimum of many empty windows, subtracted from every measurement.
+         */
+        static uint64_t overhead_ticks();
+    };
+
     //// ----------------------- ////
     //// Timekeeper Class ////
     //// ----------------------- ////
@@ -79,12 +475,61 @@ namespace NPC_Racer
     class timekeeper
     {
     public:
+        /**
+         * @brief Constructs a timekeeper that measures wall time.
+         */
+        timekeeper() = default;
+
+        /**
+         * @brief Constructs a timekeeper that can also count hardware events.
+         *
+         * @param count_hardware_events If true hardware performance counters are started and stopped with the timer.
+         * @note Counters are only opened when asked for because each one is a system resource.
+         */
+        explicit timekeeper(const bool count_hardware_events)
+        {
+            if (count_hardware_events)
+                counters = std::make_unique<hardware_counters>();
+        }
+
+        /**
+         * @brief Constructs a timekeeper that can count hardware events and time with the cycle counter.
+         *
+         * @param count_hardware_events If true hardware performance counters are started and stopped with the timer.
+         * @param use_cycle_counter If true times with the cycle counter minus its overhead, falls back to
+         *      std::chrono::steady_clock if the cycle counter isn't available.
+         * @note The cycle counter is calibrated here so the first timed trial doesn't pay for it.
+         */
+        timekeeper(const bool count_hardware_events, const bool use_cycle_counter) : timekeeper(count_hardware_events)
+        {
+            cycle_counter_timing = use_cycle_counter and cycle_counter::available();
+            if (cycle_counter_timing)
+            {
+                ticks_per_second = cycle_counter::ticks_per_second();
+                overhead_ticks = cycle_counter::overhead_ticks();
+            }
+        }
+
+        /**
+         * @brief Gives if the timekeeper times with the cycle counter.
+         * @return True if the cycle counter was asked for and is available.
+         */
+        bool uses_cycle_counter() const
+        {
+            return cycle_counter_timing;
+        }
+
         /**
          * @brief Records the start time of the race when called.
          */
         void start()
         {
-            start_time = std::chrono::steady_clock::now();
+            if (counters) // counters started first and stopped last so they cover the whole timed window
+                counters->start();
+            if (cycle_counter_timing)
+                start_tick = cycle_counter::start_ticks();
+            else
+                start_time = std::chrono::steady_clock::now();
         }
 
         /**
@@ -92,7 +537,27 @@ namespace NPC_Racer
          */
         void end()
         {
-            elapsed_time = std::chrono::steady_clock::now() - start_time;
+            if (cycle_counter_timing)
+            {
+                uint64_t ticks = cycle_counter::end_ticks() - start_tick;
+                ticks = (ticks > overhead_ticks) ? (ticks - overhead_ticks) : 0;
+                elapsed_time = std::chrono::duration<double>((double)ticks / ticks_per_second);
+            }
+            else
+                elapsed_time = std::chrono::steady_clock::now() - start_time;
+            if (counters)
+                counters->stop();
+        }
+
+        /**
+         * @brief Gives the hardware counter values of the race.
+         * @return The counter values of the last start() to end() window, unavailable if counting wasn't enabled or isn't supported.
+         */
+        hardware_counter_values counter_values() const
+        {
+            if (!counters)
+                return hardware_counter_values();
+            return counters->values();
         }
 
         /**
@@ -115,5 +580,191 @@ namespace NPC_Racer
          * @param elapsed_time The elapsed time duration as a double in seconds.
          */
         std::chrono::duration<double> elapsed_time = std::chrono::duration<double>::zero();
+
+        /**
+         * @param counters The hardware counters started and stopped with the timer, empty if not counting.
+         */
+        std::unique_ptr<hardware_counters> counters;
+
+        /**
+         * @param cycle_counter_timing If true the race is timed with the cycle counter instead of std::chrono::steady_clock.
+         */
+        bool cycle_counter_timing = false;
+
+        /**
+         * @param start_tick The cycle counter at the start of the race.
+         */
+        uint64_t start_tick = 0;
+
+        /**
+         * @param ticks_per_second The calibrated rate of the cycle counter.
+         */
+        double ticks_per_second = 1.0;
+
+        /**
+         * @param overhead_ticks The ticks of reading the cycle counter, subtracted from each race.
+         */
+        uint64_t overhead_ticks = 0;
     };
 }
+
+////// ============== //////
+////// Implementation //////
+////// ============== //////
+
+//// ------------------- ////
+//// Cycle Counter Class ////
+//// ------------------- ////
+
+bool NPC_Racer::cycle_counter::available()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    // invariant TSC is bit 8 of EDX of the advanced power management leaf
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx))
+        return false;
+    return (edx & (1u << 8)) != 0;
+#else
+    return false;
+#endif
+}
+
+double NPC_Racer::cycle_counter::ticks_per_second()
+{
+    // static so the calibration only runs once per program
+    static const double calibrated_rate = []()
+    {
+        // the median of a few short busy waits against the steady clock, a context switch in one can't skew it
+        std::array<double, 5> rates;
+        for (double &rate : rates)
+        {
+            std::chrono::steady_clock::time_point clock_start = std::chrono::steady_clock::now();
+            uint64_t tick_start = start_ticks();
+            std::chrono::steady_clock::time_point clock_end = clock_start;
+            while (clock_end - clock_start < std::chrono::milliseconds(5))
+                clock_end = std::chrono::steady_clock::now();
+            uint64_t tick_end = end_ticks();
+            rate = (double)(tick_end - tick_start) / std::chrono::duration<double>(clock_end - clock_start).count();
+        }
+        std::sort(rates.begin(), rates.end());
+        return rates[rates.size() / 2];
+    }();
+    return calibrated_rate;
+}
+
+uint64_t NPC_Racer::cycle_counter::overhead_ticks()
+{
+    static const uint64_t measured_overhead = []()
+    {
+        uint64_t minimum = UINT64_MAX;
+        for (size_t i = 0; i < 1000; i++)
+        {
+            uint64_t tick_start = start_ticks();
+            uint64_t tick_end = end_ticks();
+            minimum = std::min(minimum, tick_end - tick_start);
+        }
+        return minimum;
+    }();
+    return measured_overhead;
+}
+
+//// ----------------------- ////
+//// Hardware Counters Class ////
+//// ----------------------- ////
+
+NPC_Racer::hardware_counters::hardware_counters()
+{
+#if defined(__linux__)
+    // the events in the order of hardware_counter_values
+    const std::array<std::pair<uint32_t, uint64_t>, event_count> events = {{
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    }};
+
+    for (size_t i = 0; i < event_count; i++)
+    {
+        perf_event_attr attributes;
+        std::memset(&attributes, 0, sizeof(attributes));
+        attributes.size = sizeof(attributes);
+        attributes.type = events[i].first;
+        attributes.config = events[i].second;
+        attributes.disabled = (group_leader == -1) ? 1 : 0; // only the leader starts disabled, the group follows it
+        attributes.exclude_kernel = 1;                       // user space only so it works with perf_event_paranoid 2
+        attributes.exclude_hv = 1;
+        attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        // this thread on any CPU, joining the group if there is a leader
+        int file_descriptor = (int)syscall(SYS_perf_event_open, &attributes, 0, -1, group_leader, 0);
+        if (file_descriptor == -1) // unsupported event, skipped and reported as -1
+            continue;
+
+        file_descriptors[i] = file_descriptor;
+        if (group_leader == -1)
+            group_leader = file_descriptor;
+        group_order[group_size++] = i;
+    }
+    last_values.available = (group_leader != -1);
+#endif
+}
+
+NPC_Racer::hardware_counters::~hardware_counters()
+{
+#if defined(__linux__)
+    for (const int file_descriptor : file_descriptors)
+        if (file_descriptor != -1)
+            close(file_descriptor);
+#endif
+}
+
+void NPC_Racer::hardware_counters::start()
+{
+#if defined(__linux__)
+    if (group_leader == -1)
+        return;
+    ioctl(group_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(group_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+void NPC_Racer::hardware_counters::stop()
+{
+#if defined(__linux__)
+    if (group_leader == -1)
+        return;
+    ioctl(group_leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    // group read format is the number of events, the time enabled, the time running, then each value in the order they were added
+    std::array<uint64_t, event_count + 3> group_values = {};
+    bool counted = (read(group_leader, group_values.data(), sizeof(group_values)) > 0) and (group_values[2] > 0); // never running means the PMU couldn't schedule the group
+    uint64_t time_enabled = group_values[1], time_running = group_values[2];
+
+    std::array<double, event_count> event_values = {-1, -1, -1, -1, -1};
+    if (counted)
+    {
+        // the group only ran for part of the trial when it was multiplexed with other events, so the counts are scaled up to all of it
+        double scale = (time_running < time_enabled) ? (double)time_enabled / (double)time_running : 1.0;
+        for (size_t i = 0; (i < group_size) and (i < group_values[0]); i++)
+            event_values[group_order[i]] = (double)group_values[i + 3] * scale;
+    }
+    last_values.multiplexed = counted and (time_running < time_enabled);
+
+    last_values.cycles = event_values[0];
+    last_values.instructions = event_values[1];
+    last_values.l1_data_misses = event_values[2];
+    last_values.last_level_cache_misses = event_values[3];
+    last_values.branch_misses = event_values[4];
+#endif
+}
+
+bool NPC_Racer::hardware_counters::available() const
+{
+    return last_values.available;
+}
+
+NPC_Racer::hardware_counter_values NPC_Racer::hardware_counters::values() const
+{
+    return last_values;
+}
@@ -0,0 +1,355 @@
+/**
+ * @file trace.hpp
+ * @author Brendan Fallon (fallonbr@mcmaster.ca) (https://github.com/bren007pie)
+ * @brief This module contains the exploration trace agents record their expansion order into, and its binary, timeline, and image exports.
+ * @version 1.0
+ * @date Sunday October 18, 2026
+ * @copyright Copyright (c) 2022 Brendan Fallon
+ */
+
+//// Preprocessor Directives ////
+#pragma once
+#include <iostream>   // std::cout
+#include <fstream>    // std::ofstream
+#include <string>     // std::string, std::to_string
+#include <vector>     // std::vector
+#include <array>      // std::array
+#include <chrono>     // std::chrono::steady_clock
+#include <algorithm>  // std::min, std::max
+#include <filesystem> // std::filesystem::create_directories
+#include <cstdint>    // uint8_t, uint32_t, uint64_t
+
+// Exploration traces are off by default so they cost nothing in races, compile with -DNPC_RACER_EXPLORATION_TRACE to turn them on
+
+////// ========= //////
+////// Interface //////
+////// ========= //////
+
+namespace NPC_Racer
+{
+    //// ------- ////
+    //// Structs ////
+    //// ------- ////
+    /**
+     * @brief One node expansion recorded in an exploration trace.
+     */
+    struct trace_event
+    {
+        /**
+         * @param position The index of the node expanded.
+         */
+        uint64_t position = 0;
+
+        /**
+         * @param frontier_size The size of the frontier (stack or queue) after the node was taken off it.
+         */
+        uint64_t frontier_size = 0;
+
+        /**
+         * @param time_nanoseconds The time since the start of the search in nanoseconds.
+         */
+        uint64_t time_nanoseconds = 0;
+    };
+
+    //// ----------------------- ////
+    //// Exploration Trace Class ////
+    //// ----------------------- ////
+#if defined(NPC_RACER_EXPLORATION_TRACE)
+    /**
+     * @brief Ring buffer of the node expansions of an agent's last search, allocated once so recording never allocates.
+     * @note Only records when compiled with NPC_RACER_EXPLORATION_TRACE, otherwise every member function is an empty inline function.
+     *      When a search expands more nodes than the capacity the oldest expansions are overwritten.
+     */
+    class exploration_trace
+    {
+    public:
+        /**
+         * @param enabled True when traces are compiled in, use with `if constexpr` to skip exporting them.
+         */
+        static constexpr bool enabled = true;
+
+        /**
+         * @param default_capacity The number of events held by default, enough for every expansion of the sample mazes.
+         */
+        static constexpr size_t default_capacity = 1 << 18;
+
+        /**
+         * @brief Constructs a trace and allocates its ring buffer.
+         *
+         * @param capacity The number of events held before the oldest are overwritten.
+         */
+        explicit exploration_trace(const size_t capacity = default_capacity) : events(std::max<size_t>(capacity, 1)) {}
+
+        /**
+         * @brief Reallocates the ring buffer, call before a search and not during one.
+         *
+         * @param capacity The number of events held before the oldest are overwritten.
+         */
+        void set_capacity(const size_t capacity)
+        {
+            events.assign(std::max<size_t>(capacity, 1), trace_event());
+            recorded = 0;
+        }
+
+        /**
+         * @brief Clears the trace and starts the clock for a new search.
+         */
+        void start()
+        {
+            recorded = 0;
+            search_start = std::chrono::steady_clock::now();
+        }
+
+        /**
+         * @brief Records the expansion of a node.
+         *
+         * @param position The index of the node expanded.
+         * @param frontier_size The size of the frontier after the node was taken off it.
+         */
+        void record(const uint64_t position, const uint64_t frontier_size)
+        {
+            uint64_t time = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - search_start).count();
+            events[recorded % events.size()] = {position, frontier_size, time};
+            recorded++;
+        }
+
+        /**
+         * @brief The number of events held, at most the capacity.
+         */
+        size_t size() const { return (size_t)std::min<uint64_t>(recorded, events.size()); }
+
+        /**
+         * @brief The number of expansions overwritten because the search was longer than the capacity.
+         */
+        uint64_t dropped() const { return recorded - size(); }
+
+        /**
+         * @brief The events held, oldest first.
+         *
+         * @param i The position from the oldest event held.
+         */
+        const trace_event &operator[](const size_t i) const { return events[(dropped() + i) % events.size()]; }
+
+    private:
+        std::vector<trace_event> events;                        // the ring buffer
+        uint64_t recorded = 0;                                  // every expansion recorded since start, including overwritten ones
+        std::chrono::steady_clock::time_point search_start = {}; // the start of the search the events are timed from
+    };
+#else
+    /**
+     * @brief Empty stand-in for the exploration trace when NPC_RACER_EXPLORATION_TRACE isn't defined, every call compiles away.
+     */
+    class exploration_trace
+    {
+    public:
+        static constexpr bool enabled = false;
+        static constexpr size_t default_capacity = 0;
+        constexpr void set_capacity(const size_t) {}
+        constexpr void start() {}
+        constexpr void record(const uint64_t, const uint64_t) {}
+        constexpr size_t size() const { return 0; }
+        constexpr uint64_t dropped() const { return 0; }
+        const trace_event &operator[](const size_t) const
+        {
+            static const trace_event empty_event;
+            return empty_event;
+        }
+    };
+#endif
+
+    //// --------- ////
+    //// Functions ////
+    //// --------- ////
+    /**
+     * @brief Writes an exploration trace to a compact binary log.
+     *
+     * @tparam maze_type The maze class the trace was recorded on.
+     * @param trace The trace to write.
+     * @param race_maze The maze the trace was recorded on.
+     * @param filename The binary log file name.
+     *
+     * @result Writes the 8 byte magic `NPCTRACE`, a uint32 version, the uint64 rows, columns, start, destination, event count,
+     *      and dropped count, then each event as 3 uint64 values (position, frontier size, nanoseconds), in the machine's byte order.
+     * @warning Overwrites any previous file with the same name.
+     */
+    template <typename maze_type>
+    void write_trace_binary(const exploration_trace &trace, const maze_type &race_maze, const std::string &filename);
+
+    /**
+     * @brief Writes an exploration trace as a Chrome trace-event JSON timeline, viewable in `chrome://tracing` or Perfetto.
+     *
+     * @tparam maze_type The maze class the trace was recorded on.
+     * @param trace The trace to write.
+     * @param race_maze The maze the trace was recorded on.
+     * @param agent_name The name of the agent, used as the thread name of the timeline.
+     * @param filename The JSON file name.
+     *
+     * @result Writes an instant event with the row and column of each expansion and a counter of the frontier size.
+     * @warning Overwrites any previous file with the same name.
+     */
+    template <typename maze_type>
+    void write_trace_timeline(const exploration_trace &trace, const maze_type &race_maze, const std::string &agent_name, const std::string &filename);
+
+    /**
+     * @brief Writes an exploration trace as a sequence of PPM images of the maze being explored.
+     *
+     * @tparam maze_type The maze class the trace was recorded on.
+     * @param trace The trace to write.
+     * @param race_maze The maze the trace was recorded on.
+     * @param directory The directory to write `frame_0000.ppm`, `frame_0001.ppm`, ... to, created if it doesn't exist.
+     * @param frame_count The number of frames, each showing an equal share more of the expansions.
+     *
+     * @result Walls are dark, free space is white, explored nodes are blue with the latest frame's expansions in orange,
+     *      the start is green and the destination is red. Small mazes are scaled up so each node is several pixels wide.
+     * @note Convert to a GIF with e.g. `ffmpeg -i frame_%04d.ppm progress.gif`.
+     */
+    template <typename maze_type>
+    void write_trace_frames(const exploration_trace &trace, const maze_type &race_maze, const std::string &directory, const size_t frame_count = 100);
+
+    /**
+     * @brief Writes the binary log, timeline, and frames of an exploration trace.
+     *
+     * @tparam maze_type The maze class the trace was recorded on.
+     * @param trace The trace to write.
+     * @param race_maze The maze the trace was recorded on.
+     * @param agent_name The name of the agent.
+     * @param prefix The file name prefix, writes `prefix.bin`, `prefix.json`, and the frames to `prefix_frames/`.
+     */
+    template <typename maze_type>
+    void write_trace_files(const exploration_trace &trace, const maze_type &race_maze, const std::string &agent_name, const std::string &prefix);
+}
+
+////// ============== //////
+////// Implementation //////
+////// ============== //////
+
+template <typename maze_type>
+void NPC_Racer::write_trace_binary(const exploration_trace &trace, const maze_type &race_maze, const std::string &filename)
+{
+    std::ofstream output(filename, std::ios::binary);
+    if (!output.is_open())
+    {
+        std::cout << "ERROR: Error opening trace output file `" << filename << "`!\n";
+        return;
+    }
+
+    // fixed-width header so the log can be read without this code
+    const uint32_t version = 1;
+    const std::array<uint64_t, 6> header = {race_maze.rows(), race_maze.columns(), race_maze.start_position, race_maze.destination_position,
+                                            trace.size(), trace.dropped()};
+    output.write("NPCTRACE", 8);
+    output.write(reinterpret_cast<const char *>(&version), sizeof(version));
+    output.write(reinterpret_cast<const char *>(header.data()), sizeof(header));
+    for (size_t i = 0; i < trace.size(); i++)
+    {
+        const std::array<uint64_t, 3> event = {trace[i].position, trace[i].frontier_size, trace[i].time_nanoseconds};
+        output.write(reinterpret_cast<const char *>(event.data()), sizeof(event));
+    }
+    output.close();
+}
+
+template <typename maze_type>
+void NPC_Racer::write_trace_timeline(const exploration_trace &trace, const maze_type &race_maze, const std::string &agent_name, const std::string &filename)
+{
+    std::ofstream output(filename);
+    if (!output.is_open())
+    {
+        std::cout << "ERROR: Error opening trace output file `" << filename << "`!\n";
+        return;
+    }
+
+    // timestamps in the trace-event format are in microseconds
+    uint64_t columns = race_maze.columns();
+    output.precision(12);
+    output << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n";
+    output << "  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 1, \"args\": {\"name\": \"" << agent_name << "\"}}";
+    for (size_t i = 0; i < trace.size(); i++)
+    {
+        const trace_event &event = trace[i];
+        double time = (double)event.time_nanoseconds / 1000;
+        output << ",\n  {\"name\": \"expand\", \"ph\": \"i\", \"s\": \"t\", \"pid\": 1, \"tid\": 1, \"ts\": " << time
+               << ", \"args\": {\"row\": " << (event.position / columns) << ", \"column\": " << (event.position % columns) << "}}"
+               << ",\n  {\"name\": \"frontier\", \"ph\": \"C\", \"pid\": 1, \"tid\": 1, \"ts\": " << time
+               << ", \"args\": {\"size\": " << event.frontier_size << "}}";
+    }
+    output << "\n]}\n";
+    output.close();
+}
+
+template <typename maze_type>
+void NPC_Racer::write_trace_frames(const exploration_trace &trace, const maze_type &race_maze, const std::string &directory, const size_t frame_count /* 100 */)
+{
+    using colour = std::array<uint8_t, 3>;
+    const colour wall_colour = {40, 40, 40};
+    const colour free_colour = {255, 255, 255};
+    const colour explored_colour = {110, 160, 255};
+    const colour latest_colour = {255, 170, 0};
+    const colour start_colour = {0, 190, 0};
+    const colour destination_colour = {220, 0, 0};
+
+    uint64_t rows = race_maze.rows();
+    uint64_t columns = race_maze.columns();
+    uint64_t scale = std::max<uint64_t>(1, 512 / std::max(rows, columns)); // pixels per node so small mazes are visible
+    size_t frames = std::max<size_t>(1, std::min<size_t>(frame_count, trace.size()));
+
+    std::filesystem::create_directories(directory);
+
+    // node colours, updated a frame's worth of expansions at a time
+    std::vector<colour> nodes(rows * columns);
+    for (uint64_t i = 0; i < nodes.size(); i++)
+        nodes[i] = race_maze.bit_maze[i] ? free_colour : wall_colour;
+
+    size_t next_event = 0;
+    std::string pixels(rows * scale * columns * scale * 3, '\0');
+    for (size_t frame = 0; frame < frames; frame++)
+    {
+        size_t frame_end = trace.size() * (frame + 1) / frames;
+        for (size_t i = next_event; i < frame_end; i++)
+            nodes[trace[i].position] = latest_colour;
+
+        // drawing each node as a scale x scale block
+        for (uint64_t row = 0; row < rows * scale; row++)
+            for (uint64_t column = 0; column < columns * scale; column++)
+            {
+                uint64_t node = (row / scale) * columns + (column / scale);
+                const colour &node_colour = (node == race_maze.start_position) ? start_colour : (node == race_maze.destination_position) ? destination_colour
+                                                                                                                                         : nodes[node];
+                std::copy(node_colour.begin(), node_colour.end(), pixels.begin() + (std::ptrdiff_t)((row * columns * scale + column) * 3));
+            }
+
+        std::string frame_number = std::to_string(frame);
+        std::string file_name = directory + "/frame_" + std::string(4 - std::min<size_t>(4, frame_number.size()), '0') + frame_number + ".ppm";
+        std::ofstream output(file_name, std::ios::binary);
+        if (!output.is_open())
+        {
+            std::cout << "ERROR: Error opening trace frame file `" << file_name << "`!\n";
+            return;
+        }
+        output << "P6\n" << (columns * scale) << " " << (rows * scale) << "\n255\n";
+        output.write(pixels.data(), (std::streamsize)pixels.size());
+        output.close();
+
+        for (size_t i = next_event; i < frame_end; i++) // this frame's latest expansions are just explored in the next
+            nodes[trace[i].position] = explored_colour;
+        next_event = frame_end;
+    }
+}
+
+template <typename maze_type>
+void NPC_Racer::write_trace_files(const exploration_trace &trace, const maze_type &race_maze, const std::string &agent_name, const std::string &prefix)
+{
+    if constexpr (!exploration_trace::enabled)
+    {
+        std::cout << "WARNING: Exploration traces aren't compiled in, compile with -DNPC_RACER_EXPLORATION_TRACE to record them.\n";
+    }
+    else
+    {
+        write_trace_binary(trace, race_maze, prefix + ".bin");
+        write_trace_timeline(trace, race_maze, agent_name, prefix + ".json");
+        write_trace_frames(trace, race_maze, prefix + "_frames");
+        std::cout << "Exploration trace of " << trace.size() << " expansions written to `" << prefix << ".bin`, `" << prefix << ".json`, and `" << prefix << "_frames/`";
+        if (trace.dropped() > 0)
+            std::cout << ", the first " << trace.dropped() << " expansions were overwritten";
+        std::cout << ".\n";
+    }
+}